@@ -127,10 +127,150 @@ void env_stack_trace(void)
 }
 
 /* CRC */
+#if defined(__x86_64__)
+#include <immintrin.h>
+
+/* Smallest buffer worth setting up carry-less multiplication folding */
+#define ENV_CRC32_FOLD_MIN_LEN 64
+
+/*
+ * CRC32 (the same polynomial as zlib crc32()) computed by folding 512 bits
+ * at a time with carry-less multiplication and reducing with Barrett
+ * reduction, as described in Intel's "Fast CRC Computation for Generic
+ * Polynomials Using PCLMULQDQ Instruction". Constants are for bit-reflected
+ * polynomial 0x104C11DB7. Takes and returns non-inverted CRC, consumes
+ * multiple of 16 bytes, at least ENV_CRC32_FOLD_MIN_LEN.
+ */
+__attribute__((target("pclmul,sse4.1")))
+static uint32_t env_crc32_fold(uint32_t crc, uint8_t const *data, size_t len)
+{
+	static const uint64_t k1k2[2] __attribute__((aligned(16))) =
+			{ 0x0154442bd4, 0x01c6e41596 };
+	static const uint64_t k3k4[2] __attribute__((aligned(16))) =
+			{ 0x01751997d0, 0x00ccaa009e };
+	static const uint64_t k5k0[2] __attribute__((aligned(16))) =
+			{ 0x0163cd6124, 0x0000000000 };
+	static const uint64_t poly[2] __attribute__((aligned(16))) =
+			{ 0x01db710641, 0x01f7011641 };
+	__m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, y5, y6, y7, y8;
+
+	x1 = _mm_loadu_si128((__m128i *)(data + 0x00));
+	x2 = _mm_loadu_si128((__m128i *)(data + 0x10));
+	x3 = _mm_loadu_si128((__m128i *)(data + 0x20));
+	x4 = _mm_loadu_si128((__m128i *)(data + 0x30));
+
+	x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(crc));
+	x0 = _mm_load_si128((__m128i *)k1k2);
+
+	data += 64;
+	len -= 64;
+
+	/* Fold 4 x 128 bits in parallel */
+	while (len >= 64) {
+		x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+		x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+		x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+
+		x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+		x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+		x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+		x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+
+		y5 = _mm_loadu_si128((__m128i *)(data + 0x00));
+		y6 = _mm_loadu_si128((__m128i *)(data + 0x10));
+		y7 = _mm_loadu_si128((__m128i *)(data + 0x20));
+		y8 = _mm_loadu_si128((__m128i *)(data + 0x30));
+
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+		x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+		x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+		x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+
+		data += 64;
+		len -= 64;
+	}
+
+	/* Fold into 128 bits */
+	x0 = _mm_load_si128((__m128i *)k3k4);
+
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+	/* Fold remaining 128 bit blocks */
+	while (len >= 16) {
+		x2 = _mm_loadu_si128((__m128i *)data);
+
+		x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+		data += 16;
+		len -= 16;
+	}
+
+	/* Fold 128 bits to 64 bits */
+	x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+	x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+	x1 = _mm_srli_si128(x1, 8);
+	x1 = _mm_xor_si128(x1, x2);
+
+	x0 = _mm_loadl_epi64((__m128i *)k5k0);
+
+	x2 = _mm_srli_si128(x1, 4);
+	x1 = _mm_and_si128(x1, x3);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	/* Barrett reduction to 32 bits */
+	x0 = _mm_load_si128((__m128i *)poly);
+
+	x2 = _mm_and_si128(x1, x3);
+	x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+	x2 = _mm_and_si128(x2, x3);
+	x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	return _mm_extract_epi32(x1, 1);
+}
+
+static bool env_crc32_fold_supported;
+
+static void __attribute__((constructor)) init_crc32(void)
+{
+	__builtin_cpu_init();
+	env_crc32_fold_supported = __builtin_cpu_supports("pclmul") &&
+			__builtin_cpu_supports("sse4.1");
+}
+
+uint32_t env_crc32(uint32_t crc, uint8_t const *data, size_t len)
+{
+	size_t fold_len;
+
+	if (env_crc32_fold_supported && len >= ENV_CRC32_FOLD_MIN_LEN) {
+		fold_len = len & ~(size_t)15;
+		crc = ~env_crc32_fold(~crc, data, fold_len);
+		data += fold_len;
+		len -= fold_len;
+	}
+
+	return len ? crc32(crc, data, len) : crc;
+}
+#else
 uint32_t env_crc32(uint32_t crc, uint8_t const *data, size_t len)
 {
 	return crc32(crc, data, len);
 }
+#endif
 
 /* EXECUTION CONTEXTS */
 pthread_mutex_t *exec_context_mutex;
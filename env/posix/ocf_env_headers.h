@@ -16,7 +16,7 @@
 #define OCF_PREFIX_LONG "Open CAS Framework"
 
 #define OCF_VERSION_MAIN 20
-#define OCF_VERSION_MAJOR 3
+#define OCF_VERSION_MAJOR 4
 #define OCF_VERSION_MINOR 0
 
 #endif /* __OCF_ENV_HEADERS_H__ */
@@ -13,6 +13,7 @@
 enum ocf_cleaning_acp_parameters {
 	ocf_acp_wake_up_time,
 	ocf_acp_flush_max_buffers,
+	ocf_acp_chunk_size,
 };
 
 /**
@@ -42,6 +43,17 @@ enum ocf_cleaning_acp_parameters {
 /** Dirty cache lines to be flushed in one cycle default value */
 #define OCF_ACP_DEFAULT_FLUSH_MAX_BUFFERS	128
 
+/**
+ * ACP cleaning policy size of core region tracked as single chunk (in MiB)
+ */
+
+/** Chunk size minimum value */
+#define OCF_ACP_MIN_CHUNK_SIZE			1
+/** Chunk size maximum value */
+#define OCF_ACP_MAX_CHUNK_SIZE			10240
+/** Chunk size default value */
+#define OCF_ACP_DEFAULT_CHUNK_SIZE		100
+
 /**
  * @}
  */
@@ -17,6 +17,8 @@ enum ocf_cleaning_alru_parameters {
 	ocf_alru_flush_max_buffers,
 	ocf_alru_activity_threshold,
 	ocf_alru_max_dirty_ratio,
+	ocf_alru_adaptive,
+	ocf_alru_elevator,
 };
 
 /**
@@ -78,6 +80,32 @@ enum ocf_cleaning_alru_parameters {
 #define OCF_ALRU_MAX_MAX_DIRTY_RATIO		100
 /** Default dirty ratio value */
 #define OCF_ALRU_DEFAULT_MAX_DIRTY_RATIO	OCF_ALRU_MAX_MAX_DIRTY_RATIO
+
+/**
+ * ALRU adaptive mode. When enabled, size of each cleaning round and interval
+ * between rounds are derived from dirty ratio, foreground I/O rate and core
+ * write latency instead of flush_max_buffers and activity_threshold alone.
+ */
+
+/** Adaptive mode disabled */
+#define OCF_ALRU_MIN_ADAPTIVE			0
+/** Adaptive mode enabled */
+#define OCF_ALRU_MAX_ADAPTIVE			1
+/** Adaptive mode default value */
+#define OCF_ALRU_DEFAULT_ADAPTIVE		OCF_ALRU_MIN_ADAPTIVE
+
+/**
+ * ALRU elevator mode. When enabled, stale lines selected for cleaning are
+ * written to each core in ascending LBA order, continuing from the position
+ * reached in previous round and wrapping around at the end of core.
+ */
+
+/** Elevator mode disabled */
+#define OCF_ALRU_MIN_ELEVATOR			0
+/** Elevator mode enabled */
+#define OCF_ALRU_MAX_ELEVATOR			1
+/** Elevator mode default value */
+#define OCF_ALRU_DEFAULT_ELEVATOR		OCF_ALRU_MIN_ELEVATOR
 /**
  * @}
  */
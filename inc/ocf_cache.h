@@ -79,6 +79,12 @@ struct ocf_cache_info {
 	ocf_promotion_t promotion_policy;
 		/*!< Promotion policy selected */
 
+	ocf_replacement_t replacement_policy;
+		/*!< Replacement policy selected */
+
+	uint32_t lru_lists;
+		/*!< Number of LRU lists per partition */
+
 	ocf_cache_line_size_t cache_line_size;
 		/*!< Cache line size in KiB */
 
@@ -96,6 +102,10 @@ struct ocf_cache_info {
 
 	bool standby_detached;
 		/*!< true if cache volume detached in standby mode */
+
+	bool lazy_load_pending;
+		/*!< true if volatile metadata indexes are still populated
+		 * in background after lazy load */
 };
 
 /**
@@ -28,6 +28,13 @@
 #error "Limit of maximum number of IO classes exceeded"
 #endif
 
+/**
+ * Maximum number of dirty cache lines gathered at once by cache or core flush
+ */
+#ifndef OCF_CONFIG_FLUSH_WINDOW
+#define OCF_CONFIG_FLUSH_WINDOW (1 << 20)
+#endif
+
 /** Enabling debug statistics */
 #ifndef OCF_CONFIG_DEBUG_STATS
 #define OCF_CONFIG_DEBUG_STATS 0
@@ -38,6 +38,18 @@ void ocf_cleaner_set_cmpl(ocf_cleaner_t cleaner, ocf_cleaner_end_t fn);
  */
 void ocf_cleaner_run(ocf_cleaner_t c, ocf_queue_t queue);
 
+/**
+ * @brief Report that there is no foreground I/O to the cache
+ *
+ * Adapter may call this when it observes idleness on its own, e.g. no
+ * requests pending in its queues. Cache is then treated as idle until next
+ * foreground request arrives, without waiting for idle time to elapse.
+ * Report is ignored if cleaning while cache is idle is turned off.
+ *
+ * @param[in] c Cleaner handle
+ */
+void ocf_cleaner_report_idle(ocf_cleaner_t c);
+
 /**
  * @brief Set cleaner private data
  *
@@ -49,6 +49,70 @@
  * Maximum value of io error threshold
  */
 #define OCF_CACHE_FALLBACK_PT_MAX_ERROR_THRESHOLD	1000000
+/**
+ * Minimum number of LRU lists per partition
+ */
+#define OCF_LRU_LISTS_MIN 1
+/**
+ * Maximum number of LRU lists per partition
+ */
+#define OCF_LRU_LISTS_MAX 64
+/**
+ * Default number of LRU lists per partition
+ */
+#define OCF_LRU_LISTS_DEFAULT 32
+/**
+ * Minimum number of global metadata lock shards
+ */
+#define OCF_METADATA_GLOBAL_LOCKS_MIN 1
+/**
+ * Maximum number of global metadata lock shards
+ */
+#define OCF_METADATA_GLOBAL_LOCKS_MAX 64
+/**
+ * Default number of global metadata lock shards
+ */
+#define OCF_METADATA_GLOBAL_LOCKS_DEFAULT 4
+/**
+ * Maximum number of hash buckets protected by single hash bucket lock
+ */
+#define OCF_HASH_BUCKETS_PER_LOCK_MAX 1024
+/**
+ * Default number of hash buckets protected by single hash bucket lock
+ */
+#define OCF_HASH_BUCKETS_PER_LOCK_DEFAULT 1
+/**
+ * Minimum number of metadata I/O requests in flight per metadata segment
+ */
+#define OCF_METADATA_IO_DEPTH_MIN 1
+/**
+ * Maximum number of metadata I/O requests in flight per metadata segment
+ */
+#define OCF_METADATA_IO_DEPTH_MAX 256
+/**
+ * Default number of metadata I/O requests in flight per metadata segment
+ */
+#define OCF_METADATA_IO_DEPTH_DEFAULT 128
+/**
+ * Minimum memory budget of cleaning requests in flight (in MiB)
+ */
+#define OCF_CLEANER_MEMORY_BUDGET_MIN 1
+/**
+ * Maximum memory budget of cleaning requests in flight (in MiB)
+ */
+#define OCF_CLEANER_MEMORY_BUDGET_MAX 4096
+/**
+ * Default memory budget of cleaning requests in flight (in MiB)
+ */
+#define OCF_CLEANER_MEMORY_BUDGET_DEFAULT 64
+/**
+ * Value to turn off cleaning while cache is idle
+ */
+#define OCF_CLEANER_IDLE_TIME_DISABLED 0
+/**
+ * Maximum time without foreground I/O, after which cache is idle (in ms)
+ */
+#define OCF_CLEANER_IDLE_TIME_MAX 3600000
 /**
  * @}
  */
@@ -185,6 +249,10 @@ typedef enum {
 #define OCF_SEQ_CUTOFF_MIN_PROMOTION_COUNT 1
 #define OCF_SEQ_CUTOFF_MAX_PROMOTION_COUNT 65535
 
+#define OCF_FLUSH_QUEUE_DEPTH_MIN 1
+#define OCF_FLUSH_QUEUE_DEPTH_MAX 64
+#define OCF_FLUSH_QUEUE_DEPTH_DEFAULT 4
+
 typedef enum {
 	ocf_seq_cutoff_policy_always = 0,
 		/*!< Sequential cutoff always on */
@@ -219,6 +287,29 @@ typedef enum {
 		/*!< Default promotion policy */
 } ocf_promotion_t;
 
+/**
+ * OCF supported cache line replacement policy types
+ */
+typedef enum {
+	ocf_replacement_lru = 0,
+		/*!< Move cache line to the head of LRU list on every hit */
+
+	ocf_replacement_clock,
+		/*!< Only mark cache line as referenced on hit, referenced
+		 * cache lines get second chance on eviction (CLOCK) */
+
+	ocf_replacement_2q,
+		/*!< Insert cache line into probationary segment and promote
+		 * it to protected one on hit, remember core lines evicted from
+		 * probation and insert them directly as protected (2Q) */
+
+	ocf_replacement_max,
+		/*!< Stopper of enumerator */
+
+	ocf_replacement_default = ocf_replacement_lru,
+		/*!< Default replacement policy */
+} ocf_replacement_t;
+
 /**
  * OCF supported Write-Back cleaning policies type
  */
@@ -315,6 +406,17 @@ typedef enum {
 
 /** Default IO class priority */
 #define OCF_IO_CLASS_PRIO_DEFAULT OCF_IO_CLASS_PRIO_LOWEST
+
+/**
+ * Value of IO class high dirty watermark which disables watermark cleaning
+ */
+#define OCF_IO_CLASS_DIRTY_WATERMARK_DISABLED 100
+
+/** Default IO class high dirty watermark */
+#define OCF_IO_CLASS_DIRTY_HIGH_DEFAULT OCF_IO_CLASS_DIRTY_WATERMARK_DISABLED
+
+/** Default IO class low dirty watermark */
+#define OCF_IO_CLASS_DIRTY_LOW_DEFAULT 80
 /**
  * @}
  */
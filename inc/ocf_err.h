@@ -158,7 +158,10 @@ typedef enum {
 	/** Operation not allowed when cleaner is disabled **/
 	OCF_ERR_CLEANER_DISABLED,
 
-	OCF_ERR_MAX = OCF_ERR_CLEANER_DISABLED,
+	/** Core is too big to be mapped with cache metadata layout **/
+	OCF_ERR_CORE_TOO_BIG,
+
+	OCF_ERR_MAX = OCF_ERR_CORE_TOO_BIG,
 
 } ocf_error_t;
 
@@ -46,6 +46,23 @@ struct ocf_io_class_info {
 
 	ocf_cleaning_t cleaning_policy_type;
 		/*!< The type of cleaning policy for given IO class */
+
+	uint32_t dirty;
+		/*!< Number of dirty cache lines in the IO class */
+
+	uint8_t dirty_high;
+		/*!< High dirty watermark - percentage of IO class maximum size
+		 * which, when filled with dirty data, triggers urgent cleaning
+		 * of the IO class
+		 */
+
+	uint8_t dirty_low;
+		/*!< Low dirty watermark - percentage of IO class maximum size
+		 * at which urgent cleaning of the IO class stops
+		 */
+
+	bool dirty_urgent;
+		/*!< Urgent cleaning of the IO class is in progress */
 };
 
 /**
@@ -255,6 +255,28 @@ struct ocf_mngt_cache_config {
 	 */
 	ocf_promotion_t promotion_policy;
 
+	/**
+	 * @brief Cache line replacement policy type
+	 */
+	ocf_replacement_t replacement_policy;
+
+	/**
+	 * @brief Number of LRU lists per partition, each protected by
+	 *		separate lock (OCF_LRU_LISTS_MIN - OCF_LRU_LISTS_MAX)
+	 */
+	uint32_t lru_lists;
+
+	/**
+	 * @brief Allocate free cache lines for I/O queue from its home
+	 *		LRU list while there are any, so that queues insert
+	 *		cache lines to different lists
+	 *
+	 * @note Home list of a queue is selected in order of queue
+	 *		creation. Adapter creating queue per CPU in order of
+	 *		NUMA nodes gets lists assigned per node.
+	 */
+	bool lru_queue_affinity;
+
 	/**
 	 * @brief Cache line size
 	 */
@@ -280,6 +302,54 @@ struct ocf_mngt_cache_config {
 	 */
 	bool use_submit_io_fast;
 
+	/**
+	 * @brief Maintain lookup index with cache line sized buckets
+	 *		in addition to collision table
+	 *
+	 * @note Speeds up lookup of core lines on large caches at cost
+	 *		of about 11 bytes of RAM per cache line
+	 */
+	bool use_lookup_index;
+
+	/**
+	 * @brief Number of global metadata lock shards
+	 *		(OCF_METADATA_GLOBAL_LOCKS_MIN - OCF_METADATA_GLOBAL_LOCKS_MAX)
+	 *
+	 * @note Each I/O queue takes shared access to one of the shards,
+	 *		management operations take all of them exclusively.
+	 *		More shards reduce cache line bouncing between CPUs
+	 *		at cost of slower exclusive access.
+	 */
+	uint32_t metadata_global_locks;
+
+	/**
+	 * @brief Number of consecutive hash buckets protected by single
+	 *		hash bucket lock (power of two, up to
+	 *		OCF_HASH_BUCKETS_PER_LOCK_MAX)
+	 *
+	 * @note Value of 1 means lock per hash bucket. Higher values reduce
+	 *		memory footprint of locks on large caches.
+	 */
+	uint32_t hash_buckets_per_lock;
+
+	/**
+	 * @brief Count acquisitions, contention and wait time of metadata
+	 *		locks (see ocf_stats_collect_metadata_locks())
+	 */
+	bool metadata_lock_stats;
+
+	/**
+	 * @brief Number of metadata I/O requests kept in flight per metadata
+	 *		segment (OCF_METADATA_IO_DEPTH_MIN -
+	 *		OCF_METADATA_IO_DEPTH_MAX)
+	 *
+	 * @note Metadata reads on cache load are spread over all I/O queues
+	 *		of the cache, so with enough queues and depth loading
+	 *		is bound by cache device bandwidth. Each request in
+	 *		flight holds up to 256 KiB buffer.
+	 */
+	uint32_t metadata_io_depth;
+
 	/**
 	 * @brief Backfill configuration
 	 */
@@ -302,6 +372,9 @@ static inline void ocf_mngt_cache_config_set_default(
 {
 	cfg->cache_mode = ocf_cache_mode_default;
 	cfg->promotion_policy = ocf_promotion_default;
+	cfg->replacement_policy = ocf_replacement_default;
+	cfg->lru_lists = OCF_LRU_LISTS_DEFAULT;
+	cfg->lru_queue_affinity = false;
 	cfg->cache_line_size = ocf_cache_line_size_4;
 	cfg->metadata_volatile = false;
 	cfg->backfill.max_queue_size = 65536;
@@ -309,6 +382,11 @@ static inline void ocf_mngt_cache_config_set_default(
 	cfg->locked = false;
 	cfg->pt_unaligned_io = false;
 	cfg->use_submit_io_fast = false;
+	cfg->use_lookup_index = false;
+	cfg->metadata_global_locks = OCF_METADATA_GLOBAL_LOCKS_DEFAULT;
+	cfg->hash_buckets_per_lock = OCF_HASH_BUCKETS_PER_LOCK_DEFAULT;
+	cfg->metadata_lock_stats = false;
+	cfg->metadata_io_depth = OCF_METADATA_IO_DEPTH_DEFAULT;
 }
 
 /**
@@ -442,6 +520,36 @@ struct ocf_mngt_cache_attach_config {
 	 *       When used with ocf_mngt_cache_load() it's ignored.
 	 */
 	bool disable_cleaner;
+
+	/**
+	 * @brief If set, loaded cache starts serving I/O before its volatile
+	 *		indexes are populated
+	 *
+	 * Lookup index and dirty index are then populated in background.
+	 * Until it is finished, lookup walks collision lists and flush of
+	 * single core scans regions of cache not populated yet (see
+	 * ocf_cache_info::lazy_load_pending).
+	 *
+	 * @note This option is meaningful only with ocf_mngt_cache_load()
+	 *       after clean shutdown. Recovery after dirty shutdown always
+	 *       rebuilds all metadata before cache starts serving I/O.
+	 */
+	bool lazy_load;
+
+	/**
+	 * @brief If set, per cache line metadata uses compact layout
+	 *
+	 * Core id and core line of each cache line are packed into 48 bits,
+	 * which shrinks collision metadata section. Core line is then limited
+	 * to 2^35-1 cache lines (128 TiB of core with 4 KiB cache line).
+	 * Adding bigger core, or attaching cache device to cache with such
+	 * core, fails with OCF_ERR_CORE_TOO_BIG.
+	 *
+	 * @note With ocf_mngt_cache_load() it's ignored, as layout is read
+	 *       from cache device. With ocf_mngt_cache_standby_load() it has
+	 *       to match layout of metadata on cache device.
+	 */
+	bool compact_metadata;
 };
 
 /**
@@ -460,6 +568,8 @@ static inline void ocf_mngt_cache_attach_config_set_default(
 	cfg->force = false;
 	cfg->discard_on_start = true;
 	cfg->disable_cleaner = false;
+	cfg->lazy_load = false;
+	cfg->compact_metadata = false;
 	cfg->device.perform_test = true;
 	cfg->device.volume_params = NULL;
 }
@@ -813,6 +923,90 @@ void ocf_mngt_core_purge(ocf_core_t core,
  */
 void ocf_mngt_cache_flush_interrupt(ocf_cache_t cache);
 
+/**
+ * @brief Progress of ongoing or last completed flush of core
+ */
+struct ocf_mngt_core_flush_progress {
+	bool active;
+		/*!< Flush of core is in progress */
+
+	uint32_t total;
+		/*!< Number of cache lines to be flushed */
+
+	uint32_t flushed;
+		/*!< Number of cache lines already flushed */
+
+	uint32_t in_flight;
+		/*!< Number of flush portions currently in flight */
+
+	uint32_t portion;
+		/*!< Current flush portion size in cache lines */
+
+	uint64_t elapsed_ms;
+		/*!< Duration of flush in milliseconds */
+
+	uint64_t throughput;
+		/*!< Average flush throughput in bytes per second */
+};
+
+/**
+ * @brief Get progress of ongoing or last completed flush of core
+ *
+ * @note If core has never been flushed, all fields are set to zero.
+ *
+ * @param[in] core Core handle
+ * @param[out] progress Flush progress
+ *
+ * @retval 0 Flush progress has been read successfully
+ * @retval Non-zero Error occured
+ */
+int ocf_mngt_core_get_flush_progress(ocf_core_t core,
+		struct ocf_mngt_core_flush_progress *progress);
+
+/**
+ * @brief Set maximum number of flush portions kept in flight to core
+ *
+ * @attention This changes only runtime state, which is not persisted
+ *            in cache metadata.
+ *
+ * @param[in] core Core handle
+ * @param[in] queue_depth Number of portions, between
+ *            OCF_FLUSH_QUEUE_DEPTH_MIN and OCF_FLUSH_QUEUE_DEPTH_MAX
+ *
+ * @retval 0 Flush queue depth has been set successfully
+ * @retval Non-zero Error occured and queue depth hasn't been updated
+ */
+int ocf_mngt_core_set_flush_queue_depth(ocf_core_t core,
+		uint32_t queue_depth);
+
+/**
+ * @brief Set maximum number of flush portions in flight for all cores
+ *
+ * @attention This changes only runtime state, which is not persisted
+ *            in cache metadata.
+ *
+ * @param[in] cache Cache handle
+ * @param[in] queue_depth Number of portions, between
+ *            OCF_FLUSH_QUEUE_DEPTH_MIN and OCF_FLUSH_QUEUE_DEPTH_MAX
+ *
+ * @retval 0 Flush queue depth has been set successfully
+ * @retval Non-zero Error occured and queue depth hasn't been updated
+ */
+int ocf_mngt_core_set_flush_queue_depth_all(ocf_cache_t cache,
+		uint32_t queue_depth);
+
+/**
+ * @brief Get maximum number of flush portions kept in flight to core
+ *
+ * @param[in] core Core handle
+ * @param[out] queue_depth Number of portions
+ *
+ * @retval 0 Flush queue depth has been read successfully
+ * @retval Non-zero Error occured
+ */
+int ocf_mngt_core_get_flush_queue_depth(ocf_core_t core,
+		uint32_t *queue_depth);
+
 /**
  * @brief Completion callback of save operation
  *
@@ -928,6 +1122,65 @@ int ocf_mngt_cache_cleaning_set_param(ocf_cache_t cache, ocf_cleaning_t type,
 int ocf_mngt_cache_cleaning_get_param(ocf_cache_t cache,ocf_cleaning_t type,
 		uint32_t param_id, uint32_t *param_value);
 
+/**
+ * @brief Set memory budget of cleaning requests in flight
+ *
+ * Cleaner keeps reading data of subsequent cleaning requests from cache
+ * while data of previous ones is being written to cores, as long as total
+ * size of data buffers in flight does not exceed the budget.
+ *
+ * @attention This changes only runtime state
+ *
+ * @param[in] cache Cache handle
+ * @param[in] budget Memory budget in MiB
+ *
+ * @retval 0 Memory budget has been set successfully
+ * @retval Non-zero Error occurred and memory budget has not been set
+ */
+int ocf_mngt_cache_set_cleaner_memory_budget(ocf_cache_t cache,
+		uint32_t budget);
+
+/**
+ * @brief Get memory budget of cleaning requests in flight
+ *
+ * @param[in] cache Cache handle
+ * @param[out] budget Memory budget in MiB
+ *
+ * @retval 0 Memory budget has been retrieved successfully
+ * @retval Non-zero Error occurred and memory budget could not be retrieved
+ */
+int ocf_mngt_cache_get_cleaner_memory_budget(ocf_cache_t cache,
+		uint32_t *budget);
+
+/**
+ * @brief Set time without foreground I/O, after which cache is idle
+ *
+ * While cache is idle, cleaner drains dirty data of all IO classes in LRU
+ * order, regardless of cleaning policy, and asks to be rescheduled without
+ * delay until foreground I/O arrives or there is no more dirty data.
+ *
+ * @attention This changes only runtime state
+ *
+ * @param[in] cache Cache handle
+ * @param[in] time Idle time in ms, OCF_CLEANER_IDLE_TIME_DISABLED turns off
+ *		cleaning while cache is idle
+ *
+ * @retval 0 Idle time has been set successfully
+ * @retval Non-zero Error occurred and idle time has not been set
+ */
+int ocf_mngt_cache_set_cleaner_idle_time(ocf_cache_t cache, uint32_t time);
+
+/**
+ * @brief Get time without foreground I/O, after which cache is idle
+ *
+ * @param[in] cache Cache handle
+ * @param[out] time Idle time in ms
+ *
+ * @retval 0 Idle time has been retrieved successfully
+ * @retval Non-zero Error occurred and idle time could not be retrieved
+ */
+int ocf_mngt_cache_get_cleaner_idle_time(ocf_cache_t cache, uint32_t *time);
+
 /**
  * @brief Set promotion policy in given cache
  *
@@ -1030,6 +1283,29 @@ struct ocf_mngt_io_classes_config {
 int ocf_mngt_cache_io_classes_configure(ocf_cache_t cache,
 		const struct ocf_mngt_io_classes_config *cfg);
 
+/**
+ * @brief Set dirty watermarks of IO class
+ *
+ * When dirty data of IO class reaches high watermark, cleaner stops running
+ * cleaning policy and cleans dirty cache lines of this IO class in LRU order
+ * until amount of its dirty data drops to low watermark. Both watermarks
+ * are percentages of IO class maximum size. High watermark equal to
+ * OCF_IO_CLASS_DIRTY_WATERMARK_DISABLED disables watermark cleaning.
+ *
+ * @attention This changes only runtime state. To make changes persistent
+ *            use function ocf_mngt_cache_save().
+ *
+ * @param[in] cache Cache handle
+ * @param[in] class_id IO class ID
+ * @param[in] high High dirty watermark
+ * @param[in] low Low dirty watermark, lower than high watermark
+ *
+ * @retval 0 Watermarks have been set successfully
+ * @retval Non-zero Error occurred and watermarks have not been set
+ */
+int ocf_mngt_cache_io_class_set_dirty_watermarks(ocf_cache_t cache,
+		uint32_t class_id, uint8_t high, uint8_t low);
+
 /**
  * @brief Asociate new UUID value with given core
  *
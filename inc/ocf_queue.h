@@ -59,6 +59,24 @@ struct ocf_queue_ops {
 int ocf_queue_create(ocf_cache_t cache, ocf_queue_t *queue,
 		const struct ocf_queue_ops *ops);
 
+/**
+ * @brief Allocate IO queue with lock-free request list and add it to list
+ *	in cache
+ *
+ * Requests are added to such queue without taking any lock, which avoids
+ * contention when many contexts submit and complete requests on the same
+ * queue. Requests pushed to the front of the queue are kept on separate
+ * high priority list, which is always processed first.
+ *
+ * @param[in] cache Handle to cache instance
+ * @param[out] queue Handle to created queue
+ * @param[in] ops Queue operations
+ *
+ * @return Zero on success, otherwise error code
+ */
+int ocf_queue_create_lockless(ocf_cache_t cache, ocf_queue_t *queue,
+		const struct ocf_queue_ops *ops);
+
 /**
  * @brief Increase reference counter in queue
  *
@@ -84,6 +102,20 @@ void ocf_queue_put(ocf_queue_t queue);
  */
 void ocf_queue_run_single(ocf_queue_t q);
 
+/**
+ * @brief Process batch of requests from queue
+ *
+ * Up to @max requests are detached from queue under single lock
+ * acquisition and then processed in FIFO order. Requests added to
+ * the queue in the meantime are left for the next run.
+ *
+ * @param[in] q Queue to run
+ * @param[in] max Maximum number of requests to process
+ *
+ * @retval Number of processed requests
+ */
+uint32_t ocf_queue_run_batch(ocf_queue_t q, uint32_t max);
+
 /**
  * @brief Run queue processing
  *
@@ -117,6 +149,32 @@ void *ocf_queue_get_priv(ocf_queue_t q);
  */
 uint32_t ocf_queue_pending_io(ocf_queue_t q);
 
+/**
+ * @brief I/O queue request cache statistics
+ */
+struct ocf_queue_req_cache_stats {
+	uint64_t alloc_hits;
+		/*!< Requests allocated from queue's cache of free requests */
+
+	uint64_t alloc_misses;
+		/*!< Requests allocated from shared request allocator */
+
+	uint64_t free_hits;
+		/*!< Requests returned to queue's cache of free requests */
+
+	uint64_t free_misses;
+		/*!< Requests returned to shared request allocator */
+};
+
+/**
+ * @brief Get statistics of requests allocation in I/O queue
+ *
+ * @param[in] q I/O queue
+ * @param[out] stats Request cache statistics
+ */
+void ocf_queue_get_req_cache_stats(ocf_queue_t q,
+		struct ocf_queue_req_cache_stats *stats);
+
 /**
  * @brief Get cache instance to which I/O queue belongs
  *
@@ -218,6 +218,218 @@ int ocf_stats_collect_part_cache(ocf_cache_t cache, ocf_part_id_t part_id,
 		struct ocf_stats_usage *usage, struct ocf_stats_requests *req,
 		struct ocf_stats_blocks *blocks);
 
+/**
+ * @brief Replacement policy statistics of IO class
+ *
+ * @note Collected only with ocf_replacement_2q policy
+ */
+struct ocf_stats_replacement {
+	uint64_t insertions;
+		/*!< Cache lines mapped to IO class on miss */
+
+	uint64_t ghost_hits;
+		/*!< Insertions of core lines found in ghost list, which were
+		 * inserted as protected */
+
+	uint64_t ghost_insertions;
+		/*!< Cache lines evicted from probation of IO class and
+		 * remembered in ghost list */
+
+	uint64_t promotions;
+		/*!< Cache lines promoted from probation to protected on hit */
+};
+
+/**
+ * @param Collect replacement policy statistics for given ioclass
+ *
+ * @param cache Cache instance for which statistics will be collected
+ * @param part_id Ioclass id for which statistics will be collected
+ * @param stats Replacement policy statistics
+ *
+ * @retval 0 Success
+ * @retval Non-zero Error
+ */
+int ocf_stats_collect_part_replacement(ocf_cache_t cache,
+		ocf_part_id_t part_id, struct ocf_stats_replacement *stats);
+
+/**
+ * @brief Contention statistics of metadata lock
+ */
+struct ocf_stats_lock {
+	uint64_t acquisitions;
+		/*!< Number of lock acquisitions */
+
+	uint64_t contended;
+		/*!< Number of acquisitions, which found lock held in
+		 * conflicting mode */
+
+	uint64_t wait_ns;
+		/*!< Total time spent waiting for contended lock */
+};
+
+/**
+ * @brief Metadata lock debug statistics
+ */
+struct ocf_stats_metadata_locks {
+	uint32_t global_locks;
+		/*!< Number of global metadata lock shards */
+
+	uint32_t hash_locks;
+		/*!< Number of hash bucket locks */
+
+	uint32_t hash_buckets_per_lock;
+		/*!< Number of hash buckets protected by single lock */
+
+	struct ocf_stats_lock global[OCF_METADATA_GLOBAL_LOCKS_MAX];
+		/*!< Statistics of each global metadata lock shard */
+
+	struct ocf_stats_lock hash[OCF_METADATA_GLOBAL_LOCKS_MAX];
+		/*!< Statistics of hash bucket locks, aggregated by lock
+		 * index modulo global_locks */
+
+	uint64_t optimistic_reads;
+		/*!< Lookups of read hits validated without taking hash
+		 * bucket locks */
+
+	uint64_t optimistic_retries;
+		/*!< Optimistic lookups which found hash buckets modified and
+		 * fell back to locked lookup */
+};
+
+/**
+ * @param Collect metadata lock contention statistics
+ *
+ * @note Statistics are available only if cache was started with
+ *	metadata_lock_stats enabled
+ *
+ * @param cache Cache instance for which statistics will be collected
+ * @param stats Metadata lock statistics
+ *
+ * @retval 0 Success
+ * @retval Non-zero Error
+ */
+int ocf_stats_collect_metadata_locks(ocf_cache_t cache,
+		struct ocf_stats_metadata_locks *stats);
+
+/**
+ * @brief Cleaner statistics
+ *
+ * @note Cleaner merges dirty ranges adjacent on core into single write,
+ *	so average core write size is core_write_bytes / core_writes
+ * @note Time of each cleaning phase is summed over all cleaning requests,
+ *	which are processed concurrently, so it may exceed wall clock time
+ */
+struct ocf_stats_cleaner {
+	uint64_t requests;
+		/*!< Cleaning requests which wrote data to core */
+
+	uint64_t core_writes;
+		/*!< Write I/Os submitted to core */
+
+	uint64_t core_write_bytes;
+		/*!< Bytes written to core */
+
+	uint64_t watermark_triggers;
+		/*!< IO classes reaching high dirty watermark */
+
+	uint64_t watermark_lines;
+		/*!< Cache lines submitted for cleaning by watermark cleaning */
+
+	uint64_t pipeline_waits;
+		/*!< Cleaning requests delayed until memory budget was
+		 * available */
+
+	uint64_t pipeline_wait_ns;
+		/*!< Time spent waiting for memory budget */
+
+	uint64_t cache_read_ns;
+		/*!< Time spent reading data from cache */
+
+	uint64_t core_write_ns;
+		/*!< Time spent writing data to cores */
+
+	uint64_t core_flush_ns;
+		/*!< Time spent flushing cores */
+
+	uint64_t metadata_ns;
+		/*!< Time spent updating and flushing metadata */
+
+	uint64_t cache_flush_ns;
+		/*!< Time spent flushing cache */
+
+	uint64_t idle_runs;
+		/*!< Cleaner runs, which cleaned data because cache was idle */
+
+	uint64_t idle_lines;
+		/*!< Cache lines submitted for cleaning while cache was idle */
+};
+
+/**
+ * @param Collect cleaner statistics
+ *
+ * @param cache Cache instance for which statistics will be collected
+ * @param stats Cleaner statistics
+ *
+ * @retval 0 Success
+ * @retval Non-zero Error
+ */
+int ocf_stats_collect_cleaner(ocf_cache_t cache,
+		struct ocf_stats_cleaner *stats);
+
+/**
+ * @brief ALRU cleaning policy controller statistics
+ */
+struct ocf_stats_cleaning_alru {
+	bool adaptive;
+		/*!< Adaptive mode enabled */
+
+	uint32_t batch;
+		/*!< Cache lines to be cleaned in next round */
+
+	uint32_t interval_ms;
+		/*!< Interval between rounds, which cleaned data */
+
+	uint32_t aggressiveness;
+		/*!< Cleaning aggressiveness in permille, 1000 when cache is
+		 * idle or dirty ratio limit is reached */
+
+	uint32_t dirty_ratio;
+		/*!< Dirty ratio of cache in permille */
+
+	uint32_t io_rate;
+		/*!< Foreground requests per second */
+
+	uint32_t latency_us;
+		/*!< Average core write time of cleaned cache line */
+
+	uint32_t latency_base_us;
+		/*!< Baseline of core write time of cleaned cache line */
+
+	uint64_t rounds;
+		/*!< Cleaning rounds, which cleaned data */
+
+	uint64_t idle_rounds;
+		/*!< Cleaning rounds performed when cache was idle */
+
+	uint64_t backoffs;
+		/*!< Rounds with batch reduced due to core write latency */
+
+	uint64_t lines;
+		/*!< Cache lines submitted for cleaning */
+};
+
+/**
+ * @param Collect ALRU cleaning policy statistics
+ *
+ * @param cache Cache instance for which statistics will be collected
+ * @param stats ALRU cleaning policy statistics
+ *
+ * @retval 0 Success
+ * @retval Non-zero Error, e.g. cache uses other cleaning policy
+ */
+int ocf_stats_collect_cleaning_alru(ocf_cache_t cache,
+		struct ocf_stats_cleaning_alru *stats);
+
 /**
  * @brief Initialize or reset core statistics
  *
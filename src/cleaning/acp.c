@@ -51,8 +51,6 @@
 #define ACP_DEBUG_CHECK(acp)
 #endif
 
-#define ACP_CHUNK_SIZE (100 * MiB)
-
 /* minimal time to chunk cleaning after error */
 #define ACP_CHUNK_CLEANING_BACKOFF_TIME 5
 
@@ -61,6 +59,9 @@
 
 #define ACP_MAX_BUCKETS 11
 
+/* number of lists of chunks waiting for bucket update */
+#define ACP_UPDATE_SHARDS 32
+
 /* Upper thresholds for buckets in percent dirty pages. First bucket should have
  * threshold=0 - it isn't cleaned and we don't want dirty chunks staying dirty
  * forever. Last bucket also should stay at 100 for obvious reasons */
@@ -92,21 +93,37 @@ struct acp_state {
 
 struct acp_chunk_info {
 	struct list_head list;
+	/* entry on list of chunks waiting for bucket update */
+	struct list_head update_list;
 	uint64_t chunk_id;
 	uint64_t next_cleaning_timestamp;
+	env_atomic num_dirty;
+	/* set when chunk is on update list */
+	env_atomic update_pending;
 	ocf_core_id_t core_id;
-	uint16_t num_dirty;
 	uint8_t bucket_id;
 };
 
 struct acp_bucket {
 	struct list_head chunk_list;
-	uint16_t threshold; /* threshold in clines */
+	uint32_t threshold; /* threshold in clines */
 };
 
+/* Chunks, which dirty counters changed since their bucket was updated */
+struct acp_update_shard {
+	env_spinlock lock;
+	struct list_head chunk_list;
+} __attribute__((aligned(64)));
+
 struct acp_context {
 	env_rwsem chunks_lock;
 
+	/* chunk size in bytes and in cache lines */
+	uint64_t chunk_size;
+	uint64_t lines_per_chunk;
+
+	struct acp_update_shard update[ACP_UPDATE_SHARDS];
+
 	/* number of chunks per core */
 	uint64_t num_chunks[OCF_CORE_MAX];
 
@@ -180,7 +197,7 @@ static struct acp_chunk_info *_acp_get_chunk(struct ocf_cache *cache,
 			_acp_core_line_info(cache, cache_line);
 	uint64_t chunk_id;
 
-	chunk_id = core_line.core_line * ocf_line_size(cache) / ACP_CHUNK_SIZE;
+	chunk_id = core_line.core_line / acp->lines_per_chunk;
 
 	return &acp->chunk_info[core_line.core_id][chunk_id];
 }
@@ -226,10 +243,13 @@ void cleaning_policy_acp_init_cache_block(struct ocf_cache *cache,
 void cleaning_policy_acp_deinitialize(struct ocf_cache *cache)
 {
 	struct acp_context *acp;
+	int i;
 
 	_acp_remove_cores(cache);
 
 	acp = cache->cleaner.cleaning_policy_context;
+	for (i = 0; i < ACP_UPDATE_SHARDS; i++)
+		env_spinlock_destroy(&acp->update[i].lock);
 	env_rwsem_destroy(&acp->chunks_lock);
 
 	env_vfree(cache->cleaner.cleaning_policy_context);
@@ -244,24 +264,19 @@ void cleaning_policy_acp_setup(struct ocf_cache *cache)
 
 	config->thread_wakeup_time = OCF_ACP_DEFAULT_WAKE_UP;
 	config->flush_max_buffers = OCF_ACP_DEFAULT_FLUSH_MAX_BUFFERS;
+	config->chunk_size = OCF_ACP_DEFAULT_CHUNK_SIZE;
 }
 
 int cleaning_policy_acp_initialize(ocf_cache_t cache, int kick_cleaner)
 {
+	struct acp_cleaning_policy_config *config;
 	struct acp_context *acp;
 	int err, i;
 
-	/* bug if max chunk number would overflow dirty_no array type */
-#if defined (BUILD_BUG_ON)
-	BUILD_BUG_ON(ACP_CHUNK_SIZE / ocf_cache_line_size_min >=
-			1U << (sizeof(acp->chunk_info[0][0].num_dirty) * 8));
-#else
-	ENV_BUG_ON(ACP_CHUNK_SIZE / ocf_cache_line_size_min >=
-			1U << (sizeof(acp->chunk_info[0][0].num_dirty) * 8));
-#endif
-
 	ENV_BUG_ON(cache->cleaner.cleaning_policy_context);
 
+	config = (void *)&cache->conf_meta->cleaning[ocf_cleaning_acp].data;
+
 	acp = env_vzalloc(sizeof(*acp));
 	if (!acp) {
 		ocf_cache_log(cache, log_err, "acp context allocation error\n");
@@ -274,14 +289,29 @@ int cleaning_policy_acp_initialize(ocf_cache_t cache, int kick_cleaner)
 		return err;
 	}
 
+	for (i = 0; i < ACP_UPDATE_SHARDS; i++) {
+		env_spinlock_init(&acp->update[i].lock);
+		INIT_LIST_HEAD(&acp->update[i].chunk_list);
+	}
+
 	cache->cleaner.cleaning_policy_context = acp;
 	acp->cache = cache;
 
+	/* Config may come from metadata of cache, which didn't set chunk size */
+	if (config->chunk_size < OCF_ACP_MIN_CHUNK_SIZE ||
+			config->chunk_size > OCF_ACP_MAX_CHUNK_SIZE) {
+		ocf_cache_log(cache, log_warn, "Invalid ACP chunk size %u MiB, "
+				"using default\n", config->chunk_size);
+		config->chunk_size = OCF_ACP_DEFAULT_CHUNK_SIZE;
+	}
+
+	acp->chunk_size = (uint64_t)config->chunk_size * MiB;
+	acp->lines_per_chunk = acp->chunk_size / ocf_line_size(cache);
+
 	for (i = 0; i < ACP_MAX_BUCKETS; i++) {
 		INIT_LIST_HEAD(&acp->bucket_info[i].chunk_list);
 		acp->bucket_info[i].threshold =
-			((ACP_CHUNK_SIZE/ocf_line_size(cache)) *
-			 ACP_BUCKET_DEFAULTS[i]) / 100;
+			(acp->lines_per_chunk * ACP_BUCKET_DEFAULTS[i]) / 100;
 	}
 
 	if (cache->conf_meta->core_count > 0) {
@@ -304,7 +334,7 @@ struct ocf_acp_populate_context {
 	ocf_cache_t cache;
 
 	struct {
-		uint16_t *chunk[OCF_CORE_MAX];
+		uint32_t *chunk[OCF_CORE_MAX];
 		struct {
 			struct list_head chunk_list;
 		} bucket[ACP_MAX_BUCKETS];
@@ -354,6 +384,85 @@ static int ocf_acp_populate_handle(ocf_parallelize_t parallelize,
 	return 0;
 }
 
+/* Find the lowest bucket, which threshold is not exceeded by dirty lines of
+ * chunk. Only clean chunks are placed in bucket 0. */
+static uint8_t _acp_get_bucket_id(struct acp_context *acp, uint32_t num_dirty)
+{
+	uint8_t bucket_id;
+
+	for (bucket_id = 0; bucket_id < ACP_MAX_BUCKETS - 1; bucket_id++) {
+		if (num_dirty <= acp->bucket_info[bucket_id].threshold)
+			break;
+	}
+
+	return bucket_id;
+}
+
+/* Queue chunk for bucket update, unless it is already queued. Buckets are
+ * updated by cleaner, so that dirty/clean transitions don't contend on
+ * chunks_lock. */
+static void _acp_defer_bucket_update(struct acp_context *acp,
+		struct acp_chunk_info *chunk)
+{
+	struct acp_update_shard *shard;
+
+	if (env_atomic_read(&chunk->update_pending))
+		return;
+
+	if (env_atomic_cmpxchg(&chunk->update_pending, 0, 1))
+		return;
+
+	shard = &acp->update[(chunk->core_id + chunk->chunk_id) %
+			ACP_UPDATE_SHARDS];
+
+	env_spinlock_lock(&shard->lock);
+	list_add_tail(&chunk->update_list, &shard->chunk_list);
+	env_spinlock_unlock(&shard->lock);
+}
+
+/* Move chunks queued for update to buckets matching their dirty counters */
+static void _acp_update_buckets(struct acp_context *acp)
+{
+	struct acp_update_shard *shard;
+	struct acp_chunk_info *chunk;
+	struct acp_bucket *bucket;
+	uint8_t bucket_id;
+	int i;
+
+	ACP_LOCK_CHUNKS_WR();
+
+	for (i = 0; i < ACP_UPDATE_SHARDS; i++) {
+		shard = &acp->update[i];
+
+		env_spinlock_lock(&shard->lock);
+		while (!list_empty(&shard->chunk_list)) {
+			chunk = list_first_entry(&shard->chunk_list,
+					struct acp_chunk_info, update_list);
+			list_del(&chunk->update_list);
+
+			/* clear flag before reading counter, so that any
+			 * later change queues chunk again */
+			env_atomic_set(&chunk->update_pending, 0);
+
+			bucket_id = _acp_get_bucket_id(acp,
+					env_atomic_read(&chunk->num_dirty));
+			if (bucket_id == chunk->bucket_id)
+				continue;
+
+			bucket = &acp->bucket_info[bucket_id];
+			if (bucket_id > chunk->bucket_id)
+				list_move_tail(&chunk->list, &bucket->chunk_list);
+			else
+				list_move(&chunk->list, &bucket->chunk_list);
+
+			chunk->bucket_id = bucket_id;
+		}
+		env_spinlock_unlock(&shard->lock);
+	}
+
+	ACP_UNLOCK_CHUNKS_WR();
+}
+
 static void ocf_acp_populate_chunk(struct ocf_acp_populate_context *context,
 		struct acp_chunk_info *chunk)
 {
@@ -361,22 +470,16 @@ static void ocf_acp_populate_chunk(struct ocf_acp_populate_context *context,
 	struct acp_context *acp = _acp_get_ctx_from_cache(cache);
 	struct acp_bucket *bucket;
 	unsigned shard_id;
-	uint8_t bucket_id;
+	uint32_t num_dirty = 0;
 
-	chunk->num_dirty = 0;
 	for (shard_id = 0; shard_id < OCF_ACP_POPULATE_SHARDS_CNT; shard_id++) {
-		chunk->num_dirty += context->shard[shard_id]
+		num_dirty += context->shard[shard_id]
 				.chunk[chunk->core_id][chunk->chunk_id];
 	}
+	env_atomic_set(&chunk->num_dirty, num_dirty);
 
-	for (bucket_id = 1; bucket_id < ACP_MAX_BUCKETS; bucket_id++) {
-		bucket = &acp->bucket_info[bucket_id];
-		if (chunk->num_dirty < bucket->threshold)
-			break;
-	}
-
-	bucket = &acp->bucket_info[--bucket_id];
-	chunk->bucket_id = bucket_id;
+	chunk->bucket_id = _acp_get_bucket_id(acp, num_dirty);
+	bucket = &acp->bucket_info[chunk->bucket_id];
 
 	list_move_tail(&chunk->list, &bucket->chunk_list);
 }
@@ -396,7 +499,7 @@ static void ocf_acp_populate_finish(ocf_parallelize_t parallelize,
 
 	for_each_core(cache, core, core_id) {
 		core_size = core->conf_meta->length;
-		num_chunks = OCF_DIV_ROUND_UP(core_size, ACP_CHUNK_SIZE);
+		num_chunks = OCF_DIV_ROUND_UP(core_size, acp->chunk_size);
 
 		for (chunk_id = 0; chunk_id < num_chunks; chunk_id++) {
 			ocf_acp_populate_chunk(context,
@@ -426,11 +529,12 @@ void cleaning_policy_acp_populate(ocf_cache_t cache,
 	ocf_parallelize_t parallelize;
 	ocf_core_id_t core_id;
 	ocf_core_t core;
+	struct acp_context *acp = _acp_get_ctx_from_cache(cache);
 	unsigned shards_cnt = OCF_ACP_POPULATE_SHARDS_CNT;
 	unsigned shard_id;
 	uint64_t core_size;
 	uint64_t num_chunks;
-	uint16_t *chunks;
+	uint32_t *chunks;
 	int result;
 
 	result = ocf_parallelize_create(&parallelize, cache,
@@ -448,7 +552,7 @@ void cleaning_policy_acp_populate(ocf_cache_t cache,
 
 	for_each_core(cache, core, core_id) {
 		core_size = core->conf_meta->length;
-		num_chunks = OCF_DIV_ROUND_UP(core_size, ACP_CHUNK_SIZE);
+		num_chunks = OCF_DIV_ROUND_UP(core_size, acp->chunk_size);
 
 		chunks = env_vzalloc(sizeof(*chunks) * num_chunks * shards_cnt);
 		if (!chunks) {
@@ -505,6 +609,21 @@ int cleaning_policy_acp_set_cleaning_param(ocf_cache_t cache,
 			"buffers flushed per iteration: %d\n",
 			config->flush_max_buffers);
 		break;
+	case ocf_acp_chunk_size:
+		OCF_CLEANING_CHECK_PARAM(cache, param_value,
+				OCF_ACP_MIN_CHUNK_SIZE,
+				OCF_ACP_MAX_CHUNK_SIZE,
+				"chunk_size");
+		if (cache->cleaner.policy == ocf_cleaning_acp &&
+				param_value != config->chunk_size) {
+			ocf_cache_log(cache, log_err, "Cannot change chunk size "
+					"while ACP cleaning policy is in use\n");
+			return -OCF_ERR_INVAL;
+		}
+		config->chunk_size = param_value;
+		ocf_cache_log(cache, log_info, "Write-back flush thread "
+			"chunk size: %d MiB\n", config->chunk_size);
+		break;
 	default:
 		return -OCF_ERR_INVAL;
 	}
@@ -526,6 +645,9 @@ int cleaning_policy_acp_get_cleaning_param(ocf_cache_t cache,
 	case ocf_acp_wake_up_time:
 		*param_value = config->thread_wakeup_time;
 		break;
+	case ocf_acp_chunk_size:
+		*param_value = config->chunk_size;
+		break;
 	default:
 		return -OCF_ERR_INVAL;
 	}
@@ -566,6 +688,7 @@ static void _acp_handle_flush_error(struct ocf_cache *cache,
 		struct acp_context *acp)
 {
 	struct acp_flush_context *flush = &acp->flush;
+	unsigned long long chunk_size = acp->chunk_size;
 
 	flush->chunk->next_cleaning_timestamp = env_get_tick_count() +
 			env_secs_to_ticks(ACP_CHUNK_CLEANING_BACKOFF_TIME);
@@ -575,9 +698,9 @@ static void _acp_handle_flush_error(struct ocf_cache *cache,
 				log_err, "Cleaning error (%d) in range"
 				" <%llu; %llu) backing off for %u seconds\n",
 				flush->error,
-				flush->chunk->chunk_id * ACP_CHUNK_SIZE,
-				(flush->chunk->chunk_id * ACP_CHUNK_SIZE) +
-						ACP_CHUNK_SIZE,
+				flush->chunk->chunk_id * chunk_size,
+				(flush->chunk->chunk_id * chunk_size) +
+						chunk_size,
 				ACP_CHUNK_CLEANING_BACKOFF_TIME);
 	}
 }
@@ -667,7 +790,7 @@ static bool _acp_prepare_flush_data(struct acp_context *acp,
 	ocf_cache_t cache = acp->cache;
 	struct acp_state *state = &acp->state;
 	struct acp_chunk_info *chunk = state->chunk;
-	size_t lines_per_chunk = ACP_CHUNK_SIZE / ocf_line_size(cache);
+	size_t lines_per_chunk = acp->lines_per_chunk;
 	uint64_t first_core_line = chunk->chunk_id * lines_per_chunk;
 
 	OCF_DEBUG_PARAM(cache, "lines per chunk %llu chunk %llu "
@@ -712,6 +835,8 @@ void cleaning_policy_acp_perform_cleaning(ocf_cache_t cache,
 
 	acp->cmpl = cmpl;
 
+	_acp_update_buckets(acp);
+
 	if (!state->in_progress) {
 		/* get next chunk to clean */
 		state->chunk = _acp_get_cleaning_candidate(cache);
@@ -737,31 +862,6 @@ void cleaning_policy_acp_perform_cleaning(ocf_cache_t cache,
 		_acp_flush_end(acp, 0);
 }
 
-static void _acp_update_bucket(struct acp_context *acp,
-		struct acp_chunk_info *chunk)
-{
-	struct acp_bucket *bucket = &acp->bucket_info[chunk->bucket_id];
-
-	if (chunk->num_dirty > bucket->threshold) {
-		ENV_BUG_ON(chunk->bucket_id == ACP_MAX_BUCKETS - 1);
-
-		chunk->bucket_id++;
-		/* buckets are stored in array, move up one bucket.
-		 * No overflow here. ENV_BUG_ON made sure of no incrementation on
-		 * last bucket */
-		bucket++;
-
-		list_move_tail(&chunk->list, &bucket->chunk_list);
-	} else if (chunk->bucket_id &&
-			chunk->num_dirty <= (bucket - 1)->threshold) {
-		chunk->bucket_id--;
-		/* move down one bucket, we made sure we won't underflow */
-		bucket--;
-
-		list_move(&chunk->list, &bucket->chunk_list);
-	}
-}
-
 void cleaning_policy_acp_set_hot_cache_line(struct ocf_cache *cache,
 		uint32_t cache_line)
 {
@@ -769,19 +869,16 @@ void cleaning_policy_acp_set_hot_cache_line(struct ocf_cache *cache,
 	struct acp_cleaning_policy_meta *acp_meta;
 	struct acp_chunk_info *chunk;
 
-	ACP_LOCK_CHUNKS_WR();
-
 	acp_meta = _acp_meta_get(cache, cache_line);
-	chunk = _acp_get_chunk(cache, cache_line);
+	if (acp_meta->dirty)
+		return;
 
-	if (!acp_meta->dirty) {
-		acp_meta->dirty = 1;
-		chunk->num_dirty++;
-	}
+	acp_meta->dirty = 1;
 
-	_acp_update_bucket(acp, chunk);
+	chunk = _acp_get_chunk(cache, cache_line);
+	env_atomic_inc(&chunk->num_dirty);
 
-	ACP_UNLOCK_CHUNKS_WR();
+	_acp_defer_bucket_update(acp, chunk);
 }
 
 void cleaning_policy_acp_purge_block(struct ocf_cache *cache,
@@ -791,19 +888,16 @@ void cleaning_policy_acp_purge_block(struct ocf_cache *cache,
 	struct acp_cleaning_policy_meta *acp_meta;
 	struct acp_chunk_info *chunk;
 
-	ACP_LOCK_CHUNKS_WR();
-
 	acp_meta = _acp_meta_get(cache, cache_line);
-	chunk = _acp_get_chunk(cache, cache_line);
+	if (!acp_meta->dirty)
+		return;
 
-	if (acp_meta->dirty) {
-		acp_meta->dirty = 0;
-		chunk->num_dirty--;
-	}
+	acp_meta->dirty = 0;
 
-	_acp_update_bucket(acp, chunk);
+	chunk = _acp_get_chunk(cache, cache_line);
+	env_atomic_dec(&chunk->num_dirty);
 
-	ACP_UNLOCK_CHUNKS_WR();
+	_acp_defer_bucket_update(acp, chunk);
 }
 
 int cleaning_policy_acp_purge_range(struct ocf_cache *cache,
@@ -823,6 +917,9 @@ void cleaning_policy_acp_remove_core(ocf_cache_t cache,
 	ENV_BUG_ON(acp->chunks_total < acp->num_chunks[core_id]);
 	ENV_BUG_ON(!acp->chunk_info[core_id]);
 
+	/* take chunks of removed core off update lists */
+	_acp_update_buckets(acp);
+
 	if (acp->state.in_progress && acp->state.chunk->core_id == core_id) {
 		acp->state.in_progress = false;
 		acp->state.iter = 0;
@@ -848,8 +945,8 @@ int cleaning_policy_acp_add_core(ocf_cache_t cache,
 {
 	ocf_core_t core = ocf_cache_get_core(cache, core_id);
 	uint64_t core_size = core->conf_meta->length;
-	uint64_t num_chunks = OCF_DIV_ROUND_UP(core_size, ACP_CHUNK_SIZE);
 	struct acp_context *acp = _acp_get_ctx_from_cache(cache);
+	uint64_t num_chunks = OCF_DIV_ROUND_UP(core_size, acp->chunk_size);
 	int i;
 
 	OCF_DEBUG_PARAM(cache, "%s core_id %llu num_chunks %llu\n",
@@ -46,11 +46,50 @@
 #define OCF_DEBUG_PARAM(cache, format, ...)
 #endif
 
+/* Maximum number of cache lines cleaned in one round in adaptive mode */
+#define OCF_ALRU_ADAPTIVE_MAX_BATCH OCF_ALRU_MAX_FLUSH_MAX_BUFFERS
+
+/* Maximum interval between rounds in adaptive mode */
+#define OCF_ALRU_ADAPTIVE_MAX_INTERVAL_MS 1000
+
+/* Foreground request rate, at which cleaning is backed off by half */
+#define OCF_ALRU_ADAPTIVE_IO_RATE_REF 1000
+
+/* Core write latency over baseline ratio, above which batch is reduced */
+#define OCF_ALRU_ADAPTIVE_LATENCY_FACTOR 2
+
+/* Number of candidates, relative to round size, considered in elevator mode */
+#define OCF_ALRU_ELEVATOR_WINDOW 4
+
+struct alru_adaptive_state {
+	uint64_t last_ticks;
+	uint64_t last_io_count;
+	uint64_t round_start;
+	uint32_t batch;
+	uint32_t interval_ms;
+	uint32_t aggressiveness;
+	uint32_t dirty_ratio;
+	uint32_t io_rate;
+	uint32_t latency_us;
+	uint32_t latency_base_us;
+	uint64_t rounds;
+	uint64_t idle_rounds;
+	uint64_t backoffs;
+	uint64_t lines;
+};
+
+struct alru_elevator_state {
+	/* Next core line to be cleaned on each core */
+	uint64_t position[OCF_CORE_MAX];
+};
+
 struct alru_flush_ctx {
 	struct ocf_cleaner_attribs attribs;
 	bool flush_perfomed;
 	bool dirty_ratio_exceeded;
+	bool idle;
 	uint32_t clines_no;
+	uint32_t clines_flushed;
 	ocf_cache_t cache;
 	ocf_cleaner_end_t cmpl;
 	struct flush_data *flush_data;
@@ -59,6 +98,8 @@ struct alru_flush_ctx {
 
 struct alru_context {
 	struct alru_flush_ctx flush_ctx;
+	struct alru_adaptive_state adaptive;
+	struct alru_elevator_state elevator;
 	env_spinlock list_lock[OCF_USER_IO_CLASS_MAX];
 };
 
@@ -363,6 +404,42 @@ void cleaning_policy_alru_setup(struct ocf_cache *cache)
 	config->flush_max_buffers = OCF_ALRU_DEFAULT_FLUSH_MAX_BUFFERS;
 	config->activity_threshold = OCF_ALRU_DEFAULT_ACTIVITY_THRESHOLD;
 	config->max_dirty_ratio = OCF_ALRU_DEFAULT_MAX_DIRTY_RATIO;
+	config->adaptive = OCF_ALRU_DEFAULT_ADAPTIVE;
+	config->elevator = OCF_ALRU_DEFAULT_ELEVATOR;
+}
+
+static uint64_t alru_adaptive_io_count(ocf_cache_t cache)
+{
+	struct ocf_counters_part *part;
+	uint64_t count = 0;
+	ocf_core_t core;
+	ocf_core_id_t core_id;
+	ocf_part_id_t part_id;
+
+	for_each_core(cache, core, core_id) {
+		if (!core->counters)
+			continue;
+
+		for (part_id = 0; part_id < OCF_USER_IO_CLASS_MAX; part_id++) {
+			part = &core->counters->part_counters[part_id];
+			count += env_atomic64_read(&part->read_reqs.total);
+			count += env_atomic64_read(&part->write_reqs.total);
+		}
+	}
+
+	return count;
+}
+
+static uint32_t alru_adaptive_dirty_ratio(ocf_cache_t cache)
+{
+	uint64_t dirty = 0;
+	ocf_core_t core;
+	ocf_core_id_t core_id;
+
+	for_each_core(cache, core, core_id)
+		dirty += env_atomic_read(&core->runtime_meta->dirty_clines);
+
+	return dirty * 1000 / cache->device->collision_table_entries;
 }
 
 int cleaning_policy_alru_initialize(ocf_cache_t cache, int kick_cleaner)
@@ -392,6 +469,9 @@ int cleaning_policy_alru_initialize(ocf_cache_t cache, int kick_cleaner)
 
 	cache->device->runtime_meta->cleaning_thread_access = 0;
 
+	ctx->adaptive.last_ticks = env_get_tick_count();
+	ctx->adaptive.last_io_count = alru_adaptive_io_count(cache);
+
 	cache->cleaner.cleaning_policy_context = ctx;
 
 	if (kick_cleaner)
@@ -639,6 +719,27 @@ int cleaning_policy_alru_set_cleaning_param(ocf_cache_t cache,
 				"max dirty ratio: %d\n",
 				config->max_dirty_ratio);
 		break;
+	case ocf_alru_adaptive:
+		OCF_CLEANING_CHECK_PARAM(cache, param_value,
+				OCF_ALRU_MIN_ADAPTIVE,
+				OCF_ALRU_MAX_ADAPTIVE,
+				"adaptive");
+		config->adaptive = param_value;
+		ocf_cache_log(cache, log_info, "Write-back flush thread "
+				"adaptive mode: %s\n",
+				config->adaptive ? "enabled" : "disabled");
+		ocf_kick_cleaner(cache);
+		break;
+	case ocf_alru_elevator:
+		OCF_CLEANING_CHECK_PARAM(cache, param_value,
+				OCF_ALRU_MIN_ELEVATOR,
+				OCF_ALRU_MAX_ELEVATOR,
+				"elevator");
+		config->elevator = param_value;
+		ocf_cache_log(cache, log_info, "Write-back flush thread "
+				"elevator mode: %s\n",
+				config->elevator ? "enabled" : "disabled");
+		break;
 	default:
 		return -OCF_ERR_INVAL;
 	}
@@ -669,6 +770,12 @@ int cleaning_policy_alru_get_cleaning_param(ocf_cache_t cache,
 	case ocf_alru_max_dirty_ratio:
 		*param_value = config->max_dirty_ratio;
 		break;
+	case ocf_alru_adaptive:
+		*param_value = config->adaptive;
+		break;
+	case ocf_alru_elevator:
+		*param_value = config->elevator;
+		break;
 	default:
 		return -OCF_ERR_INVAL;
 	}
@@ -729,6 +836,136 @@ static bool check_for_dirty_ratio(ocf_cache_t cache,
 	return info.dirty * 100 / info.size >= config->max_dirty_ratio;
 }
 
+/*
+ * Compute size of next cleaning round. Aggressiveness drops from maximum
+ * when cache is idle towards configured flush_max_buffers as foreground
+ * request rate grows, unless dirty ratio approaches max_dirty_ratio. Batch
+ * is further reduced when core write latency rises above its baseline and
+ * follows computed target smoothly to avoid oscillations.
+ */
+static uint32_t alru_adaptive_update(struct alru_context *ctx,
+		struct alru_cleaning_policy_config *config)
+{
+	struct alru_adaptive_state *state = &ctx->adaptive;
+	struct alru_flush_ctx *fctx = &ctx->flush_ctx;
+	ocf_cache_t cache = fctx->cache;
+	uint64_t now = env_get_tick_count();
+	uint64_t io_count = alru_adaptive_io_count(cache);
+	uint64_t elapsed_ms, target;
+	uint32_t load, pressure, limit;
+
+	elapsed_ms = env_ticks_to_msecs(now - state->last_ticks);
+	if (elapsed_ms) {
+		state->io_rate = OCF_MIN((io_count - state->last_io_count) *
+				1000 / elapsed_ms, (uint64_t)UINT32_MAX);
+		state->last_ticks = now;
+		state->last_io_count = io_count;
+	}
+
+	state->dirty_ratio = alru_adaptive_dirty_ratio(cache);
+
+	/* Foreground load in permille, half at reference request rate */
+	load = fctx->idle ? 0 : (uint64_t)state->io_rate * 1000 /
+			(state->io_rate + OCF_ALRU_ADAPTIVE_IO_RATE_REF);
+
+	/* Dirty pressure in permille of max dirty ratio */
+	limit = OCF_MAX(config->max_dirty_ratio, 1) * 10;
+	pressure = OCF_MIN(state->dirty_ratio * 1000 / limit, 1000);
+	if (fctx->dirty_ratio_exceeded)
+		pressure = 1000;
+
+	state->aggressiveness = 1000 - load * (1000 - pressure) / 1000;
+
+	target = config->flush_max_buffers + (uint64_t)(OCF_ALRU_ADAPTIVE_MAX_BATCH -
+			OCF_MIN(config->flush_max_buffers,
+			OCF_ALRU_ADAPTIVE_MAX_BATCH)) *
+			state->aggressiveness / 1000;
+
+	if (state->latency_base_us && state->latency_us >
+			state->latency_base_us *
+			OCF_ALRU_ADAPTIVE_LATENCY_FACTOR) {
+		target = target * state->latency_base_us *
+				OCF_ALRU_ADAPTIVE_LATENCY_FACTOR /
+				state->latency_us;
+		state->backoffs++;
+	}
+
+	target = OCF_MAX(target, OCF_ALRU_MIN_FLUSH_MAX_BUFFERS);
+
+	if (state->batch)
+		state->batch = (3ULL * state->batch + target) / 4;
+	else
+		state->batch = target;
+
+	state->batch = OCF_MAX(state->batch, OCF_ALRU_MIN_FLUSH_MAX_BUFFERS);
+
+	state->interval_ms = (1000 - state->aggressiveness) *
+			OCF_ALRU_ADAPTIVE_MAX_INTERVAL_MS / 1000;
+
+	return state->batch;
+}
+
+static void alru_adaptive_round_end(struct alru_context *ctx)
+{
+	struct alru_adaptive_state *state = &ctx->adaptive;
+	struct alru_flush_ctx *fctx = &ctx->flush_ctx;
+	uint64_t latency_us;
+
+	latency_us = env_ticks_to_nsecs(env_get_tick_count() -
+			state->round_start) / 1000 / fctx->clines_flushed;
+	latency_us = OCF_MIN(latency_us, (uint64_t)UINT32_MAX);
+
+	/* Exponentially weighted moving average with weight of 1/4 */
+	if (state->latency_us)
+		state->latency_us = (3ULL * state->latency_us + latency_us) / 4;
+	else
+		state->latency_us = latency_us;
+
+	/* Baseline follows minimum and slowly drifts up to adapt to core */
+	if (!state->latency_base_us || state->latency_us <
+			state->latency_base_us) {
+		state->latency_base_us = state->latency_us;
+	} else {
+		state->latency_base_us += (state->latency_us -
+				state->latency_base_us) / 64;
+	}
+
+	state->rounds++;
+	state->lines += fctx->clines_flushed;
+	if (fctx->idle)
+		state->idle_rounds++;
+}
+
+int cleaning_policy_alru_get_stats(ocf_cache_t cache,
+		struct ocf_stats_cleaning_alru *stats)
+{
+	struct alru_context *ctx = cache->cleaner.cleaning_policy_context;
+	struct alru_cleaning_policy_config *config;
+	struct alru_adaptive_state *state;
+
+	if (!ctx)
+		return -OCF_ERR_INVAL;
+
+	config = (void *)&cache->conf_meta->cleaning[ocf_cleaning_alru].data;
+	state = &ctx->adaptive;
+
+	stats->adaptive = config->adaptive;
+	stats->batch = config->adaptive ? state->batch :
+			config->flush_max_buffers;
+	stats->interval_ms = state->interval_ms;
+	stats->aggressiveness = state->aggressiveness;
+	stats->dirty_ratio = state->dirty_ratio;
+	stats->io_rate = state->io_rate;
+	stats->latency_us = state->latency_us;
+	stats->latency_base_us = state->latency_base_us;
+	stats->rounds = state->rounds;
+	stats->idle_rounds = state->idle_rounds;
+	stats->backoffs = state->backoffs;
+	stats->lines = state->lines;
+
+	return 0;
+}
+
 static bool is_cleanup_possible(ocf_cache_t cache, struct alru_flush_ctx *fctx)
 {
 	struct alru_cleaning_policy_config *config;
@@ -743,7 +980,10 @@ static bool is_cleanup_possible(ocf_cache_t cache, struct alru_flush_ctx *fctx)
 		return true;
 	}
 
-	if (check_for_io_activity(cache, config)) {
+	fctx->idle = !check_for_io_activity(cache, config);
+
+	/* In adaptive mode cleaning is scaled down under load instead */
+	if (!fctx->idle && !config->adaptive) {
 		OCF_DEBUG_PARAM(cache, "IO activity detected");
 		return false;
 	}
@@ -813,7 +1053,7 @@ static bool block_is_busy(struct ocf_cache *cache,
 	return false;
 }
 
-static int get_data_to_flush(struct alru_context *ctx)
+static int get_data_to_flush(struct alru_context *ctx, uint32_t max)
 {
 	struct alru_flush_ctx *fctx = &ctx->flush_ctx;
 	ocf_cache_t cache = fctx->cache;
@@ -832,7 +1072,10 @@ static int get_data_to_flush(struct alru_context *ctx)
 
 		cache_line = user_part->clean_pol->policy.alru.lru_tail;
 
-		last_access = fctx->dirty_ratio_exceeded ? (uint32_t)(~0UL) : compute_timestamp(config);
+		/* In adaptive mode idle cache is cleaned regardless of age */
+		last_access = (fctx->dirty_ratio_exceeded ||
+				(config->adaptive && fctx->idle)) ?
+				(uint32_t)(~0UL) : compute_timestamp(config);
 
 		#if OCF_CLEANING_DEBUG == 1
 		alru = &ocf_metadata_get_cleaning_policy(cache, cache_line)
@@ -843,7 +1086,7 @@ static int get_data_to_flush(struct alru_context *ctx)
 		#endif
 
 		while (more_blocks_to_flush(cache, cache_line, last_access)) {
-			if (to_flush >= fctx->clines_no) {
+			if (to_flush >= max) {
 				env_spinlock_unlock(&ctx->list_lock[part_id]);
 				goto end;
 			}
@@ -868,18 +1111,89 @@ end:
 	return to_flush;
 }
 
+static void alru_elevator_reverse(struct flush_data *tbl,
+		uint32_t first, uint32_t last)
+{
+	struct flush_data tmp;
+
+	while (first + 1 < last) {
+		tmp = tbl[first];
+		tbl[first++] = tbl[--last];
+		tbl[last] = tmp;
+	}
+}
+
+/*
+ * Pick fctx->clines_no out of count stale candidates, so that on each core
+ * cleaning continues in ascending LBA order from the line where previous round
+ * stopped. Each core gets share of the round proportional to its number of
+ * candidates. Selected lines are moved to the front of flush data, ordered
+ * by core and by LBA starting from elevator position.
+ */
+static int alru_elevator_select(struct alru_context *ctx, uint32_t count)
+{
+	struct alru_flush_ctx *fctx = &ctx->flush_ctx;
+	struct alru_elevator_state *elevator = &ctx->elevator;
+	struct flush_data *tbl = fctx->flush_data;
+	uint32_t selected = 0, start, pos, end, quota;
+	ocf_core_id_t core_id;
+
+	ocf_cleaner_sort_sectors(tbl, count);
+
+	for (start = 0; start < count; start = end) {
+		core_id = tbl[start].core_id;
+
+		for (end = start; end < count; end++) {
+			if (tbl[end].core_id != core_id)
+				break;
+		}
+
+		for (pos = start; pos < end; pos++) {
+			if (tbl[pos].core_line >= elevator->position[core_id])
+				break;
+		}
+
+		/* Rotate segment, so that lines ahead of elevator go first */
+		alru_elevator_reverse(tbl, start, pos);
+		alru_elevator_reverse(tbl, pos, end);
+		alru_elevator_reverse(tbl, start, end);
+
+		quota = OCF_DIV_ROUND_UP((uint64_t)(end - start) *
+				fctx->clines_no, count);
+		quota = OCF_MIN(quota, end - start);
+		quota = OCF_MIN(quota, fctx->clines_no - selected);
+		if (!quota)
+			break;
+
+		for (pos = start; pos < start + quota; pos++)
+			tbl[selected++] = tbl[pos];
+
+		elevator->position[core_id] = tbl[selected - 1].core_line + 1;
+	}
+
+	return selected;
+}
+
 static void alru_clean_complete(void *priv, int err)
 {
 	struct alru_cleaning_policy_config *config;
 	struct alru_flush_ctx *fctx = priv;
 	ocf_cache_t cache = fctx->cache;
+	struct alru_context *ctx = cache->cleaner.cleaning_policy_context;
 	int interval;
 
 	OCF_REALLOC_DEINIT(&fctx->flush_data, &fctx->flush_data_limit);
 
 	config = (void *)&cache->conf_meta->cleaning[ocf_cleaning_alru].data;
 
-	interval = fctx->flush_perfomed ? 0 : config->thread_wakeup_time * 1000;
+	if (!fctx->flush_perfomed) {
+		interval = config->thread_wakeup_time * 1000;
+	} else if (config->adaptive) {
+		alru_adaptive_round_end(ctx);
+		interval = ctx->adaptive.interval_ms;
+	} else {
+		interval = 0;
+	}
 
 	fctx->cmpl(&fctx->cache->cleaner, interval);
 }
@@ -888,29 +1202,45 @@ static void alru_clean(struct alru_context *ctx)
 {
 	struct alru_flush_ctx *fctx = &ctx->flush_ctx;
 	ocf_cache_t cache = fctx->cache;
+	struct alru_cleaning_policy_config *config;
+	uint32_t candidates;
 	int to_clean;
 
+	config = (void *)&cache->conf_meta->cleaning[ocf_cleaning_alru].data;
+
 	if (!is_cleanup_possible(cache, fctx)) {
 		alru_clean_complete(fctx, 0);
 		return;
 	}
 
+	if (config->adaptive)
+		fctx->clines_no = alru_adaptive_update(ctx, config);
+
 	if (ocf_metadata_try_start_exclusive_access(&cache->metadata.lock)) {
 		alru_clean_complete(fctx, 0);
 		return;
 	}
 
+	candidates = fctx->clines_no;
+	if (config->elevator)
+		candidates *= OCF_ALRU_ELEVATOR_WINDOW;
+
 	OCF_REALLOC(&fctx->flush_data, sizeof(fctx->flush_data[0]),
-			fctx->clines_no, &fctx->flush_data_limit);
+			candidates, &fctx->flush_data_limit);
 	if (!fctx->flush_data) {
 		ocf_cache_log(cache, log_warn, "No memory to allocate flush "
 				"data for ALRU cleaning policy");
 		goto end;
 	}
 
-	to_clean = get_data_to_flush(ctx);
+	to_clean = get_data_to_flush(ctx, candidates);
+	if (to_clean > 0 && config->elevator)
+		to_clean = alru_elevator_select(ctx, to_clean);
+	fctx->attribs.do_sort = !config->elevator;
 	if (to_clean > 0) {
 		fctx->flush_perfomed = true;
+		fctx->clines_flushed = to_clean;
+		ctx->adaptive.round_start = env_get_tick_count();
 		ocf_cleaner_do_flush_data_async(cache, fctx->flush_data, to_clean,
 				&fctx->attribs);
 		ocf_metadata_end_exclusive_access(&cache->metadata.lock);
@@ -949,6 +1279,8 @@ void cleaning_alru_perform_cleaning(ocf_cache_t cache, ocf_cleaner_end_t cmpl)
 	fctx->cmpl = cmpl;
 	fctx->flush_perfomed = false;
 	fctx->dirty_ratio_exceeded = false;
+	fctx->idle = false;
+	fctx->clines_flushed = 0;
 
 	alru_clean(ctx);
 }
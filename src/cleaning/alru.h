@@ -26,6 +26,8 @@ int cleaning_policy_alru_set_cleaning_param(ocf_cache_t cache,
 		uint32_t param_id, uint32_t param_value);
 int cleaning_policy_alru_get_cleaning_param(ocf_cache_t cache,
 		uint32_t param_id, uint32_t *param_value);
+int cleaning_policy_alru_get_stats(ocf_cache_t cache,
+		struct ocf_stats_cleaning_alru *stats);
 void cleaning_alru_perform_cleaning(ocf_cache_t cache, ocf_cleaner_end_t cmpl);
 
 #endif
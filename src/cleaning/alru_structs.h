@@ -22,6 +22,8 @@ struct alru_cleaning_policy_config {
 	uint32_t flush_max_buffers;	/* in lines */
 	uint32_t activity_threshold;	/* in milliseconds */
 	uint32_t max_dirty_ratio;	/* percent */
+	uint32_t adaptive;		/* bool */
+	uint32_t elevator;		/* bool */
 };
 
 struct alru_cleaning_policy {
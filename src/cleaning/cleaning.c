@@ -13,7 +13,8 @@
 #include "../mngt/ocf_mngt_common.h"
 #include "../metadata/metadata.h"
 #include "../ocf_queue_priv.h"
-#include "cleaning_ops.h"
+#include "../ocf_lru.h"
+#include "../utils/utils_user_part.h"
 
 int ocf_start_cleaner(ocf_cache_t cache)
 {
@@ -79,6 +80,159 @@ static void ocf_cleaner_run_complete(ocf_cleaner_t cleaner, uint32_t interval)
 	cleaner->end(cleaner, interval);
 }
 
+void ocf_cleaner_report_idle(ocf_cleaner_t c)
+{
+	ocf_cache_t cache;
+
+	OCF_CHECK_NULL(c);
+
+	cache = ocf_cleaner_get_cache(c);
+
+	if (c->idle.time_ms == OCF_CLEANER_IDLE_TIME_DISABLED)
+		return;
+
+	env_atomic_set(&c->idle.reported_ms,
+			env_ticks_to_msecs(env_get_tick_count()));
+	env_atomic_set(&c->idle.reported, 1);
+
+	ocf_kick_cleaner(cache);
+}
+
+/*
+ * Cache is idle if there was no foreground I/O for configured idle time or
+ * since adapter reported idleness
+ */
+static bool ocf_cleaner_is_idle(ocf_cache_t cache)
+{
+	struct ocf_cleaner_idle *idle = &cache->cleaner.idle;
+	uint32_t now, last;
+
+	if (idle->time_ms == OCF_CLEANER_IDLE_TIME_DISABLED)
+		return false;
+
+	now = env_ticks_to_msecs(env_get_tick_count());
+	last = env_atomic_read(&cache->last_access_ms);
+
+	if (env_atomic_read(&idle->reported)) {
+		if ((int32_t)(env_atomic_read(&idle->reported_ms) - last) >= 0)
+			return true;
+
+		/* Foreground I/O arrived after report */
+		env_atomic_set(&idle->reported, 0);
+	}
+
+	return now - last >= idle->time_ms;
+}
+
+static bool ocf_cleaner_idle_pending(ocf_cache_t cache)
+{
+	ocf_part_id_t part_id;
+
+	if (!ocf_cleaner_is_idle(cache))
+		return false;
+
+	for (part_id = 0; part_id < OCF_USER_IO_CLASS_MAX; part_id++) {
+		if (ocf_user_part_has_dirty(&cache->user_parts[part_id]))
+			return true;
+	}
+
+	return false;
+}
+
+/*
+ * Maximum number of batches of OCF_EVICTION_CLEAN_SIZE cache lines submitted
+ * by watermark or idle cleaning in single cleaner run
+ */
+#define OCF_CLEANER_WATERMARK_BATCHES 32
+
+static bool ocf_cleaner_watermark_pending(ocf_cache_t cache)
+{
+	ocf_part_id_t part_id;
+
+	for (part_id = 0; part_id < OCF_USER_IO_CLASS_MAX; part_id++) {
+		if (ocf_user_part_is_dirty_urgent(&cache->user_parts[part_id]))
+			return true;
+	}
+
+	return false;
+}
+
+static inline bool ocf_cleaner_watermark_selected(
+		struct ocf_cleaner_watermark *wm,
+		struct ocf_user_part *user_part)
+{
+	if (wm->idle)
+		return ocf_user_part_has_dirty(user_part);
+
+	return ocf_user_part_is_dirty_urgent(user_part);
+}
+
+static void ocf_cleaner_watermark_clean(ocf_cleaner_t cleaner);
+
+static void ocf_cleaner_watermark_end(void *priv, int error)
+{
+	ocf_cleaner_watermark_clean(priv);
+}
+
+/*
+ * Clean IO classes which reached high dirty watermark in LRU order, visiting
+ * them round robin, until all of them reach low watermark or limit of batches
+ * for single run is exhausted. This is done regardless of cleaning policy,
+ * which is run only if there is nothing to be cleaned here.
+ *
+ * While cache is idle all IO classes with dirty data are cleaned the same
+ * way, until foreground I/O arrives, and cleaner is rescheduled immediately.
+ */
+static void ocf_cleaner_watermark_clean(ocf_cleaner_t cleaner)
+{
+	ocf_cache_t cache = ocf_cleaner_get_cache(cleaner);
+	struct ocf_cleaner_watermark *wm = &cleaner->watermark;
+	struct ocf_user_part *user_part;
+	uint32_t skipped_parts, lines;
+
+	while (wm->batches < OCF_CLEANER_WATERMARK_BATCHES &&
+			wm->skipped_parts < OCF_USER_IO_CLASS_MAX) {
+		if (wm->idle && !ocf_cleaner_is_idle(cache))
+			break;
+
+		user_part = &cache->user_parts[wm->part_id];
+		wm->part_id = (wm->part_id + 1) % OCF_USER_IO_CLASS_MAX;
+
+		if (!ocf_cleaner_watermark_selected(wm, user_part)) {
+			wm->skipped_parts++;
+			continue;
+		}
+
+		/* Completion may be called before return, so update state
+		 * as if batch was already submitted */
+		skipped_parts = wm->skipped_parts;
+		wm->skipped_parts = 0;
+		wm->batches++;
+
+		lines = ocf_lru_clean_part(cache, user_part, cleaner->io_queue,
+				ocf_cleaner_watermark_end, cleaner);
+		if (lines) {
+			env_atomic64_add(lines, wm->idle ?
+					&cleaner->stats.idle_lines :
+					&cleaner->stats.watermark_lines);
+			return;
+		}
+
+		wm->batches--;
+		wm->skipped_parts = skipped_parts + 1;
+	}
+
+	if (!wm->batches) {
+		ocf_cleaning_perform_cleaning(cache, ocf_cleaner_run_complete);
+		return;
+	}
+
+	if (wm->idle)
+		env_atomic64_inc(&cleaner->stats.idle_runs);
+
+	ocf_cleaner_run_complete(cleaner, 0);
+}
+
 void ocf_cleaner_run(ocf_cleaner_t cleaner, ocf_queue_t queue)
 {
 	ocf_cache_t cache;
@@ -117,5 +271,21 @@ void ocf_cleaner_run(ocf_cleaner_t cleaner, ocf_queue_t queue)
 	ocf_queue_get(queue);
 	cleaner->io_queue = queue;
 
+	if (ocf_cleaner_watermark_pending(cache)) {
+		cleaner->watermark.batches = 0;
+		cleaner->watermark.skipped_parts = 0;
+		cleaner->watermark.idle = false;
+		ocf_cleaner_watermark_clean(cleaner);
+		return;
+	}
+
+	if (ocf_cleaner_idle_pending(cache)) {
+		cleaner->watermark.batches = 0;
+		cleaner->watermark.skipped_parts = 0;
+		cleaner->watermark.idle = true;
+		ocf_cleaner_watermark_clean(cleaner);
+		return;
+	}
+
 	ocf_cleaning_perform_cleaning(cache, ocf_cleaner_run_complete);
 }
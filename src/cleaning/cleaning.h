@@ -39,6 +39,56 @@ struct cleaning_policy_meta {
 	} meta;
 };
 
+struct ocf_cleaner_stats {
+	env_atomic64 requests;
+		/*!< Cleaning requests which submitted core writes */
+	env_atomic64 core_writes;
+	env_atomic64 core_write_bytes;
+	env_atomic64 watermark_triggers;
+	env_atomic64 watermark_lines;
+	env_atomic64 pipeline_waits;
+	env_atomic64 pipeline_wait_ns;
+	env_atomic64 cache_read_ns;
+	env_atomic64 core_write_ns;
+	env_atomic64 core_flush_ns;
+	env_atomic64 metadata_ns;
+	env_atomic64 cache_flush_ns;
+	env_atomic64 idle_runs;
+	env_atomic64 idle_lines;
+};
+
+/* Cleaning requests in flight, limited by memory budget of their data */
+struct ocf_cleaner_pipeline {
+	env_spinlock lock;
+	struct list_head waiting;
+		/*!< Requests waiting for memory budget */
+	uint64_t in_flight_bytes;
+	uint64_t budget;
+		/*!< Memory budget in bytes */
+};
+
+/* Cleaning of IO classes which reached high dirty watermark */
+struct ocf_cleaner_watermark {
+	uint32_t batches;
+		/*!< Batches submitted in current cleaner run */
+	uint32_t skipped_parts;
+		/*!< Consecutive IO classes visited without submitting batch */
+	ocf_part_id_t part_id;
+		/*!< Next IO class to be visited */
+	bool idle;
+		/*!< Cleaning all IO classes with dirty data as cache is idle */
+};
+
+/* Cleaning while there is no foreground I/O */
+struct ocf_cleaner_idle {
+	uint32_t time_ms;
+		/*!< Time without foreground I/O, after which cache is idle */
+	env_atomic reported;
+		/*!< Adapter reported idleness */
+	env_atomic reported_ms;
+		/*!< Time of last idleness report */
+};
+
 struct ocf_cleaner {
 	struct ocf_refcnt refcnt __attribute__((aligned(64)));
 	ocf_cleaning_t policy;
@@ -46,6 +96,10 @@ struct ocf_cleaner {
 	ocf_queue_t io_queue;
 	ocf_cleaner_end_t end;
 	void *priv;
+	struct ocf_cleaner_watermark watermark;
+	struct ocf_cleaner_idle idle;
+	struct ocf_cleaner_pipeline pipeline;
+	struct ocf_cleaner_stats stats;
 };
 
 int ocf_start_cleaner(ocf_cache_t cache);
@@ -184,6 +184,11 @@ int ocf_req_async_lock_rd(struct ocf_alock *alock,
 	return ocf_alock_lock_rd(alock, req, cmpl);
 }
 
+int ocf_req_trylock_rd(struct ocf_alock *alock, struct ocf_request *req)
+{
+	return ocf_alock_trylock_rd(alock, req);
+}
+
 int ocf_req_async_lock_wr(struct ocf_alock *alock,
 		struct ocf_request *req, ocf_req_async_lock_cb cmpl)
 {
@@ -84,6 +84,18 @@ int ocf_req_async_lock_wr(struct ocf_alock *c,
 int ocf_req_async_lock_rd(struct ocf_alock *c,
 		struct ocf_request *req, ocf_req_async_lock_cb cmpl);
 
+/**
+ * @brief Try to lock OCF request for read access without waiting
+ *
+ * @param c - cacheline concurrency private data
+ * @param req - OCF request
+ *
+ * @retval OCF_LOCK_ACQUIRED - OCF request has been locked and can be processed
+ * @retval OCF_LOCK_NOT_ACQUIRED - some of cache lines are locked, no locks
+ *		are held and request was not added into waiting list
+ */
+int ocf_req_trylock_rd(struct ocf_alock *c, struct ocf_request *req);
+
 /**
  * @brief Unlock OCF request from write access
  *
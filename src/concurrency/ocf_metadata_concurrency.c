@@ -14,10 +14,13 @@ int ocf_metadata_concurrency_init(struct ocf_metadata_lock *metadata_lock)
 	unsigned part_iter;
 	unsigned global_iter;
 
-	for (lru_iter = 0; lru_iter < OCF_NUM_LRU_LISTS; lru_iter++)
+	ENV_BUILD_BUG_ON(OCF_METADATA_GLOBAL_LOCKS_MAX >
+			(1 << OCF_METADATA_GLOBAL_LOCK_IDX_BITS));
+
+	for (lru_iter = 0; lru_iter < OCF_LRU_LISTS_MAX; lru_iter++)
 		env_rwlock_init(&metadata_lock->lru[lru_iter]);
 
-	for (global_iter = 0; global_iter < OCF_NUM_GLOBAL_META_LOCKS;
+	for (global_iter = 0; global_iter < OCF_METADATA_GLOBAL_LOCKS_MAX;
 			global_iter++) {
 		err = env_rwsem_init(&metadata_lock->global[global_iter].sem);
 		if (err)
@@ -53,10 +56,10 @@ void ocf_metadata_concurrency_deinit(struct ocf_metadata_lock *metadata_lock)
 	for (i = 0; i < OCF_USER_IO_CLASS_MAX; i++)
 		env_spinlock_destroy(&metadata_lock->partition[i]);
 
-	for (i = 0; i < OCF_NUM_LRU_LISTS; i++)
+	for (i = 0; i < OCF_LRU_LISTS_MAX; i++)
 		env_rwlock_destroy(&metadata_lock->lru[i]);
 
-	for (i = 0; i < OCF_NUM_GLOBAL_META_LOCKS; i++)
+	for (i = 0; i < OCF_METADATA_GLOBAL_LOCKS_MAX; i++)
 		env_rwsem_destroy(&metadata_lock->global[i].sem);
 }
 
@@ -64,23 +67,27 @@ int ocf_metadata_concurrency_attached_init(
 		struct ocf_metadata_lock *metadata_lock, ocf_cache_t cache,
 		uint32_t hash_table_entries, uint32_t colision_table_pages)
 {
+	uint32_t hash_locks = OCF_DIV_ROUND_UP((uint64_t)hash_table_entries,
+			1ULL << metadata_lock->hash_lock_shift);
 	uint32_t i;
 	int err = 0;
 
-	metadata_lock->hash = env_vzalloc(sizeof(env_rwsem) *
-			hash_table_entries);
+	metadata_lock->hash = env_vzalloc(sizeof(env_rwsem) * hash_locks);
+	metadata_lock->hash_seq = env_vzalloc(sizeof(env_atomic) * hash_locks);
 	metadata_lock->collision_pages = env_vzalloc(sizeof(env_rwsem) *
 			colision_table_pages);
-	if (!metadata_lock->hash ||
+	if (!metadata_lock->hash || !metadata_lock->hash_seq ||
 			!metadata_lock->collision_pages) {
 		env_vfree(metadata_lock->hash);
+		env_vfree(metadata_lock->hash_seq);
 		env_vfree(metadata_lock->collision_pages);
 		metadata_lock->hash = NULL;
+		metadata_lock->hash_seq = NULL;
 		metadata_lock->collision_pages = NULL;
 		return -OCF_ERR_NO_MEM;
 	}
 
-	for (i = 0; i < hash_table_entries; i++) {
+	for (i = 0; i < hash_locks; i++) {
 		err = env_rwsem_init(&metadata_lock->hash[i]);
 		if (err)
 			 break;
@@ -111,6 +118,7 @@ int ocf_metadata_concurrency_attached_init(
 
 	metadata_lock->cache = cache;
 	metadata_lock->num_hash_entries = hash_table_entries;
+	metadata_lock->num_hash_locks = hash_locks;
 	metadata_lock->num_collision_pages = colision_table_pages;
 
 	return 0;
@@ -122,13 +130,17 @@ void ocf_metadata_concurrency_attached_deinit(
 	uint32_t i;
 
 	if (metadata_lock->hash) {
-		for (i = 0; i < metadata_lock->num_hash_entries; i++)
+		for (i = 0; i < metadata_lock->num_hash_locks; i++)
 			env_rwsem_destroy(&metadata_lock->hash[i]);
 		env_vfree(metadata_lock->hash);
 		metadata_lock->hash = NULL;
 		metadata_lock->num_hash_entries = 0;
+		metadata_lock->num_hash_locks = 0;
 	}
 
+	env_vfree(metadata_lock->hash_seq);
+	metadata_lock->hash_seq = NULL;
+
 	if (metadata_lock->collision_pages) {
 		for (i = 0; i < metadata_lock->num_collision_pages; i++)
 			env_rwsem_destroy(&metadata_lock->collision_pages[i]);
@@ -138,14 +150,89 @@ void ocf_metadata_concurrency_attached_deinit(
 	}
 }
 
+/* Acquire rw semaphore accounting contention if lock stats are enabled.
+ * Lock is considered contended if it could not be acquired with trylock. */
+static inline void ocf_metadata_rwsem_lock(
+		struct ocf_metadata_lock *metadata_lock, env_rwsem *sem,
+		struct ocf_metadata_lock_stats *stats, int rw)
+{
+	uint64_t start;
+	int error;
+
+	if (likely(!metadata_lock->stats_enabled)) {
+		if (rw == OCF_METADATA_WR)
+			env_rwsem_down_write(sem);
+		else
+			env_rwsem_down_read(sem);
+		return;
+	}
+
+	env_atomic64_inc(&stats->acquisitions);
+
+	if (rw == OCF_METADATA_WR)
+		error = env_rwsem_down_write_trylock(sem);
+	else
+		error = env_rwsem_down_read_trylock(sem);
+	if (!error)
+		return;
+
+	env_atomic64_inc(&stats->contended);
+
+	start = env_get_tick_count();
+	if (rw == OCF_METADATA_WR)
+		env_rwsem_down_write(sem);
+	else
+		env_rwsem_down_read(sem);
+	env_atomic64_add(env_ticks_to_nsecs(env_get_tick_count() - start),
+			&stats->wait_ns);
+}
+
+static inline int ocf_metadata_rwsem_trylock(
+		struct ocf_metadata_lock *metadata_lock, env_rwsem *sem,
+		struct ocf_metadata_lock_stats *stats, int rw)
+{
+	int error;
+
+	if (rw == OCF_METADATA_WR)
+		error = env_rwsem_down_write_trylock(sem);
+	else
+		error = env_rwsem_down_read_trylock(sem);
+
+	if (unlikely(metadata_lock->stats_enabled)) {
+		if (error)
+			env_atomic64_inc(&stats->contended);
+		else
+			env_atomic64_inc(&stats->acquisitions);
+	}
+
+	return error;
+}
+
+static inline void ocf_metadata_global_lock(
+		struct ocf_metadata_lock *metadata_lock, unsigned lock_idx,
+		int rw)
+{
+	ocf_metadata_rwsem_lock(metadata_lock,
+			&metadata_lock->global[lock_idx].sem,
+			&metadata_lock->global[lock_idx].stats, rw);
+}
+
+static inline int ocf_metadata_global_trylock(
+		struct ocf_metadata_lock *metadata_lock, unsigned lock_idx,
+		int rw)
+{
+	return ocf_metadata_rwsem_trylock(metadata_lock,
+			&metadata_lock->global[lock_idx].sem,
+			&metadata_lock->global[lock_idx].stats, rw);
+}
+
 void ocf_metadata_start_exclusive_access(
 		struct ocf_metadata_lock *metadata_lock)
 {
 	unsigned i;
 
-	for (i = 0; i < OCF_NUM_GLOBAL_META_LOCKS; i++) {
-		env_rwsem_down_write(&metadata_lock->global[i].sem);
-	}
+	for (i = 0; i < metadata_lock->num_global_locks; i++)
+		ocf_metadata_global_lock(metadata_lock, i, OCF_METADATA_WR);
 }
 
 int ocf_metadata_try_start_exclusive_access(
@@ -154,8 +241,9 @@ int ocf_metadata_try_start_exclusive_access(
 	unsigned i;
 	int error;
 
-	for (i = 0; i < OCF_NUM_GLOBAL_META_LOCKS; i++) {
-		error =  env_rwsem_down_write_trylock(&metadata_lock->global[i].sem);
+	for (i = 0; i < metadata_lock->num_global_locks; i++) {
+		error = ocf_metadata_global_trylock(metadata_lock, i,
+				OCF_METADATA_WR);
 		if (error)
 			break;
 	}
@@ -174,7 +262,7 @@ void ocf_metadata_end_exclusive_access(
 {
 	unsigned i;
 
-	for (i = OCF_NUM_GLOBAL_META_LOCKS; i > 0; i--)
+	for (i = metadata_lock->num_global_locks; i > 0; i--)
 	        env_rwsem_up_write(&metadata_lock->global[i - 1].sem);
 }
 
@@ -189,14 +277,15 @@ void ocf_metadata_start_shared_access(
 		struct ocf_metadata_lock *metadata_lock,
 		unsigned lock_idx)
 {
-        env_rwsem_down_read(&metadata_lock->global[lock_idx].sem);
+	ocf_metadata_global_lock(metadata_lock, lock_idx, OCF_METADATA_RD);
 }
 
 int ocf_metadata_try_start_shared_access(
 		struct ocf_metadata_lock *metadata_lock,
 		unsigned lock_idx)
 {
-	return env_rwsem_down_read_trylock(&metadata_lock->global[lock_idx].sem);
+	return ocf_metadata_global_trylock(metadata_lock, lock_idx,
+			OCF_METADATA_RD);
 }
 
 void ocf_metadata_end_shared_access(struct ocf_metadata_lock *metadata_lock,
@@ -212,18 +301,62 @@ void ocf_metadata_end_shared_access(struct ocf_metadata_lock *metadata_lock,
 	 number. Preffered way to lock multiple hash buckets is to use
 	 request lock rountines ocf_req_hash_(un)lock_(rd/wr).
 */
+/* Each hash bucket lock protects 2^hash_lock_shift consecutive hash buckets,
+ * so lock index is monotonic in hash bucket number and locking hash buckets
+ * in increasing order acquires hash bucket locks in increasing order too. */
+static inline uint32_t ocf_hb_lock_id(struct ocf_metadata_lock *metadata_lock,
+		ocf_cache_line_t hash)
+{
+	return hash >> metadata_lock->hash_lock_shift;
+}
+
+static inline struct ocf_metadata_lock_stats *ocf_hb_lock_stats(
+		struct ocf_metadata_lock *metadata_lock, uint32_t id)
+{
+	return &metadata_lock->global[id % metadata_lock->num_global_locks].
+			hash_stats;
+}
+
+/* Sequence number of hash bucket lock is incremented after write lock is
+ * acquired and before it is released, so it is odd while hash buckets
+ * are modified. Optimistic readers check that it did not change. */
+static inline void ocf_hb_seq_inc(struct ocf_metadata_lock *metadata_lock,
+		uint32_t id)
+{
+	env_atomic_inc(&metadata_lock->hash_seq[id]);
+}
+
+static inline void ocf_hb_lock(struct ocf_metadata_lock *metadata_lock,
+		uint32_t id, int rw)
+{
+	ENV_BUG_ON(rw != OCF_METADATA_WR && rw != OCF_METADATA_RD);
+
+	ocf_metadata_rwsem_lock(metadata_lock, &metadata_lock->hash[id],
+			ocf_hb_lock_stats(metadata_lock, id), rw);
+
+	if (rw == OCF_METADATA_WR)
+		ocf_hb_seq_inc(metadata_lock, id);
+}
+
+static inline void ocf_hb_unlock(struct ocf_metadata_lock *metadata_lock,
+		uint32_t id, int rw)
+{
+	if (rw == OCF_METADATA_WR) {
+		ocf_hb_seq_inc(metadata_lock, id);
+		env_rwsem_up_write(&metadata_lock->hash[id]);
+	} else if (rw == OCF_METADATA_RD)
+		env_rwsem_up_read(&metadata_lock->hash[id]);
+	else
+		ENV_BUG();
+}
+
 static inline void ocf_hb_id_naked_lock(
 		struct ocf_metadata_lock *metadata_lock,
 		ocf_cache_line_t hash, int rw)
 {
 	ENV_BUG_ON(hash >= metadata_lock->num_hash_entries);
 
-	if (rw == OCF_METADATA_WR)
-		env_rwsem_down_write(&metadata_lock->hash[hash]);
-	else if (rw == OCF_METADATA_RD)
-		env_rwsem_down_read(&metadata_lock->hash[hash]);
-	else
-		ENV_BUG();
+	ocf_hb_lock(metadata_lock, ocf_hb_lock_id(metadata_lock, hash), rw);
 }
 
 static inline void ocf_hb_id_naked_unlock(
@@ -232,31 +365,24 @@ static inline void ocf_hb_id_naked_unlock(
 {
 	ENV_BUG_ON(hash >= metadata_lock->num_hash_entries);
 
-	if (rw == OCF_METADATA_WR)
-		env_rwsem_up_write(&metadata_lock->hash[hash]);
-	else if (rw == OCF_METADATA_RD)
-		env_rwsem_up_read(&metadata_lock->hash[hash]);
-	else
-		ENV_BUG();
+	ocf_hb_unlock(metadata_lock, ocf_hb_lock_id(metadata_lock, hash), rw);
 }
 
 static int ocf_hb_id_naked_trylock(struct ocf_metadata_lock *metadata_lock,
 		ocf_cache_line_t hash, int rw)
 {
-	int result = -1;
+	uint32_t id = ocf_hb_lock_id(metadata_lock, hash);
+	int result;
 
 	ENV_BUG_ON(hash >= metadata_lock->num_hash_entries);
+	ENV_BUG_ON(rw != OCF_METADATA_WR && rw != OCF_METADATA_RD);
 
-	if (rw == OCF_METADATA_WR) {
-		result = env_rwsem_down_write_trylock(
-				&metadata_lock->hash[hash]);
-	} else if (rw == OCF_METADATA_RD) {
-		result = env_rwsem_down_read_trylock(
-				&metadata_lock->hash[hash]);
-	} else {
-		ENV_BUG();
-	}
+	result = ocf_metadata_rwsem_trylock(metadata_lock,
+			&metadata_lock->hash[id],
+			ocf_hb_lock_stats(metadata_lock, id), rw);
 
+	if (!result && rw == OCF_METADATA_WR)
+		ocf_hb_seq_inc(metadata_lock, id);
 
 	return result;
 }
@@ -441,80 +567,170 @@ void ocf_hb_id_prot_unlock_wr(struct ocf_metadata_lock *metadata_lock,
  * hash bucket are locked, the given core line is hash bucket
  * locked as well).
  */
+/* lock index of hash bucket */
+#define _LOCK_ID(req, hash) ocf_hb_lock_id(&req->cache->metadata.lock, hash)
+
 bool ocf_req_hash_in_range(struct ocf_request *req,
 		ocf_core_id_t core_id, uint64_t core_line)
 {
 	ocf_cache_line_t hash = ocf_metadata_hash_func(
 			req->cache, core_line, core_id);
+	uint32_t id = _LOCK_ID(req, hash);
 
+	/* Hash bucket is locked if it shares lock with any of request hash
+	 * buckets */
 	if (!_HAS_GAP(req)) {
-		return (hash >= _MIN_HASH(req) &&
-				hash <= _MAX_HASH(req));
+		return (id >= _LOCK_ID(req, _MIN_HASH(req)) &&
+				id <= _LOCK_ID(req, _MAX_HASH(req)));
 	}
 
-	return (hash >= _MIN_HASH(req) && hash <= _GAP_START(req)) ||
-		(hash > _GAP_START(req) + _GAP_VAL(req) &&
-				hash <=  _MAX_HASH(req));
+	return (id >= _LOCK_ID(req, _MIN_HASH(req)) &&
+			id <= _LOCK_ID(req, _GAP_START(req))) ||
+		(id >= _LOCK_ID(req, _GAP_START(req) + _GAP_VAL(req) + 1) &&
+			id <= _LOCK_ID(req, _MAX_HASH(req)));
 }
 
-void ocf_hb_req_prot_lock_rd(struct ocf_request *req)
+/* Lock all hash bucket locks of request. Consecutive hash buckets may share
+ * lock, so each lock is acquired only once. */
+static void ocf_hb_req_naked_lock(struct ocf_request *req, int rw)
 {
+	struct ocf_metadata_lock *metadata_lock = &req->cache->metadata.lock;
 	ocf_cache_line_t hash;
+	uint32_t id, prev_id = UINT32_MAX;
 
-	ocf_metadata_start_shared_access(&req->cache->metadata.lock,
-			req->lock_idx);
 	for_each_req_hash_asc(req, hash) {
-		ocf_hb_id_naked_lock(&req->cache->metadata.lock, hash,
-				OCF_METADATA_RD);
+		id = ocf_hb_lock_id(metadata_lock, hash);
+		if (id == prev_id)
+			continue;
+
+		ocf_hb_lock(metadata_lock, id, rw);
+		prev_id = id;
 	}
 }
 
-void ocf_hb_req_prot_unlock_rd(struct ocf_request *req)
+static void ocf_hb_req_naked_unlock(struct ocf_request *req, int rw)
 {
+	struct ocf_metadata_lock *metadata_lock = &req->cache->metadata.lock;
 	ocf_cache_line_t hash;
+	uint32_t id, prev_id = UINT32_MAX;
 
 	for_each_req_hash_asc(req, hash) {
-		ocf_hb_id_naked_unlock(&req->cache->metadata.lock, hash,
-				OCF_METADATA_RD);
+		id = ocf_hb_lock_id(metadata_lock, hash);
+		if (id == prev_id)
+			continue;
+
+		ocf_hb_unlock(metadata_lock, id, rw);
+		prev_id = id;
 	}
+}
+
+void ocf_hb_req_prot_lock_rd(struct ocf_request *req)
+{
+	ocf_metadata_start_shared_access(&req->cache->metadata.lock,
+			req->lock_idx);
+	ocf_hb_req_naked_lock(req, OCF_METADATA_RD);
+}
+
+void ocf_hb_req_prot_unlock_rd(struct ocf_request *req)
+{
+	ocf_hb_req_naked_unlock(req, OCF_METADATA_RD);
 	ocf_metadata_end_shared_access(&req->cache->metadata.lock,
 			req->lock_idx);
 }
 
 void ocf_hb_req_prot_lock_wr(struct ocf_request *req)
 {
-	ocf_cache_line_t hash;
-
 	ocf_metadata_start_shared_access(&req->cache->metadata.lock,
 			req->lock_idx);
-	for_each_req_hash_asc(req, hash) {
-		ocf_hb_id_naked_lock(&req->cache->metadata.lock, hash,
-				OCF_METADATA_WR);
-	}
+	ocf_hb_req_naked_lock(req, OCF_METADATA_WR);
 }
 
 void ocf_hb_req_prot_lock_upgrade(struct ocf_request *req)
 {
-	ocf_cache_line_t hash;
-
-	for_each_req_hash_asc(req, hash) {
-		ocf_hb_id_naked_unlock(&req->cache->metadata.lock, hash,
-				OCF_METADATA_RD);
-	}
-	for_each_req_hash_asc(req, hash) {
-		ocf_hb_id_naked_lock(&req->cache->metadata.lock, hash,
-				OCF_METADATA_WR);
-	}
+	ocf_hb_req_naked_unlock(req, OCF_METADATA_RD);
+	ocf_hb_req_naked_lock(req, OCF_METADATA_WR);
 }
 
 void ocf_hb_req_prot_unlock_wr(struct ocf_request *req)
 {
+	ocf_hb_req_naked_unlock(req, OCF_METADATA_WR);
+	ocf_metadata_end_shared_access(&req->cache->metadata.lock,
+			req->lock_idx);
+}
+
+/* Sum of sequence numbers of request hash bucket locks. Sequence numbers
+ * only grow, so the sum changes whenever any of them changes. */
+static bool ocf_hb_req_seq(struct ocf_request *req, uint64_t *seq)
+{
+	struct ocf_metadata_lock *metadata_lock = &req->cache->metadata.lock;
 	ocf_cache_line_t hash;
+	uint32_t id, prev_id = UINT32_MAX;
+	uint32_t val;
+	bool stable = true;
+
+	*seq = 0;
 
 	for_each_req_hash_asc(req, hash) {
-		ocf_hb_id_naked_unlock(&req->cache->metadata.lock, hash,
-				OCF_METADATA_WR);
+		id = ocf_hb_lock_id(metadata_lock, hash);
+		if (id == prev_id)
+			continue;
+
+		val = env_atomic_read(&metadata_lock->hash_seq[id]);
+		stable &= !(val & 1);
+		*seq += val;
+		prev_id = id;
 	}
+
+	return stable;
+}
+
+static inline void ocf_hb_req_prot_read_count(struct ocf_request *req,
+		bool validated)
+{
+	struct ocf_metadata_lock *metadata_lock = &req->cache->metadata.lock;
+	struct ocf_metadata_global_lock *global =
+			&metadata_lock->global[req->lock_idx];
+
+	if (likely(!metadata_lock->stats_enabled))
+		return;
+
+	if (validated)
+		env_atomic64_inc(&global->optimistic_reads);
+	else
+		env_atomic64_inc(&global->optimistic_retries);
+}
+
+bool ocf_hb_req_prot_read_begin(struct ocf_request *req, uint64_t *seq)
+{
+	bool stable;
+
+	ocf_metadata_start_shared_access(&req->cache->metadata.lock,
+			req->lock_idx);
+
+	stable = ocf_hb_req_seq(req, seq);
+	env_smp_rmb();
+
+	if (!stable)
+		ocf_hb_req_prot_read_count(req, false);
+
+	return stable;
+}
+
+bool ocf_hb_req_prot_read_retry(struct ocf_request *req, uint64_t seq)
+{
+	uint64_t curr;
+	bool retry;
+
+	env_smp_rmb();
+	retry = !ocf_hb_req_seq(req, &curr) || curr != seq;
+
+	ocf_hb_req_prot_read_count(req, !retry);
+
+	return retry;
+}
+
+void ocf_hb_req_prot_read_end(struct ocf_request *req)
+{
 	ocf_metadata_end_shared_access(&req->cache->metadata.lock,
 			req->lock_idx);
 }
@@ -14,7 +14,7 @@
 
 static inline unsigned ocf_metadata_concurrency_next_idx(ocf_queue_t q)
 {
-	return q->lock_idx++ % OCF_NUM_GLOBAL_META_LOCKS;
+	return q->lock_idx++ % q->cache->metadata.lock.num_global_locks;
 }
 
 int ocf_metadata_concurrency_init(struct ocf_metadata_lock *metadata_lock);
@@ -56,7 +56,7 @@ static inline void ocf_metadata_lru_wr_lock_all(
 {
 	uint32_t i;
 
-	for (i = 0; i < OCF_NUM_LRU_LISTS; i++)
+	for (i = 0; i < metadata_lock->cache->lru_lists; i++)
 		ocf_metadata_lru_wr_lock(metadata_lock, i);
 }
 
@@ -65,25 +65,25 @@ static inline void ocf_metadata_lru_wr_unlock_all(
 {
 	uint32_t i;
 
-	for (i = 0; i < OCF_NUM_LRU_LISTS; i++)
+	for (i = 0; i < metadata_lock->cache->lru_lists; i++)
 		ocf_metadata_lru_wr_unlock(metadata_lock, i);
 }
 
 #define OCF_METADATA_LRU_WR_LOCK(cline) \
 		ocf_metadata_lru_wr_lock(&cache->metadata.lock, \
-				cline % OCF_NUM_LRU_LISTS)
+				ocf_cache_lru_list(cache, cline))
 
 #define OCF_METADATA_LRU_WR_UNLOCK(cline) \
 		ocf_metadata_lru_wr_unlock(&cache->metadata.lock, \
-				cline % OCF_NUM_LRU_LISTS)
+				ocf_cache_lru_list(cache, cline))
 
 #define OCF_METADATA_LRU_RD_LOCK(cline) \
 		ocf_metadata_lru_rd_lock(&cache->metadata.lock, \
-				cline % OCF_NUM_LRU_LISTS)
+				ocf_cache_lru_list(cache, cline))
 
 #define OCF_METADATA_LRU_RD_UNLOCK(cline) \
 		ocf_metadata_lru_rd_unlock(&cache->metadata.lock, \
-				cline % OCF_NUM_LRU_LISTS)
+				ocf_cache_lru_list(cache, cline))
 
 
 #define OCF_METADATA_LRU_WR_LOCK_ALL() \
@@ -168,6 +168,21 @@ void ocf_hb_req_prot_lock_wr(struct ocf_request *req);
 void ocf_hb_req_prot_unlock_wr(struct ocf_request *req);
 void ocf_hb_req_prot_lock_upgrade(struct ocf_request *req);
 
+/*
+ * Optimistic read of request hash buckets without taking hash bucket locks.
+ * Reader takes global metadata shared access and sequence number of hash
+ * bucket locks with ocf_hb_req_prot_read_begin(), reads metadata and
+ * checks with ocf_hb_req_prot_read_retry() that no hash bucket was
+ * modified in the meantime. Shared access is released with
+ * ocf_hb_req_prot_read_end() regardless of the outcome.
+ */
+
+/* returns false if some of hash buckets are being modified */
+bool ocf_hb_req_prot_read_begin(struct ocf_request *req, uint64_t *seq);
+/* returns true if metadata read since begin might be inconsistent */
+bool ocf_hb_req_prot_read_retry(struct ocf_request *req, uint64_t seq);
+void ocf_hb_req_prot_read_end(struct ocf_request *req);
+
 /* collision table page lock interface */
 void ocf_collision_start_shared_access(struct ocf_metadata_lock *metadata_lock,
 		uint32_t page);
@@ -157,6 +157,22 @@ static ocf_engine_cb ocf_cache_mode_to_engine_cb(
 	return cache_mode_io_if_map[req_cache_mode]->cbs[rw];
 }
 
+/* Lock-free lists have single consumer - caller must hold io_list_lock */
+static struct ocf_request *_ocf_engine_pop_req_lockless(ocf_queue_t q)
+{
+	struct ocf_mpsc_node *node;
+
+	node = ocf_mpsc_pop(&q->io_mpsc_prio);
+	if (!node)
+		node = ocf_mpsc_pop(&q->io_mpsc);
+	if (!node)
+		return NULL;
+
+	env_atomic_dec(&q->io_no);
+
+	return container_of(node, struct ocf_request, mpsc_node);
+}
+
 struct ocf_request *ocf_engine_pop_req(ocf_queue_t q)
 {
 	unsigned long lock_flags = 0;
@@ -167,6 +183,13 @@ struct ocf_request *ocf_engine_pop_req(ocf_queue_t q)
 	/* LOCK */
 	env_spinlock_lock_irqsave(&q->io_list_lock, lock_flags);
 
+	if (q->lockless) {
+		req = _ocf_engine_pop_req_lockless(q);
+		env_spinlock_unlock_irqrestore(&q->io_list_lock,
+				lock_flags);
+		return req;
+	}
+
 	if (list_empty(&q->io_list)) {
 		/* No items on the list */
 		env_spinlock_unlock_irqrestore(&q->io_list_lock,
@@ -188,6 +211,43 @@ struct ocf_request *ocf_engine_pop_req(ocf_queue_t q)
 	return req;
 }
 
+uint32_t ocf_engine_pop_reqs(ocf_queue_t q, struct list_head *reqs,
+		uint32_t max)
+{
+	unsigned long lock_flags = 0;
+	struct ocf_request *req;
+	uint32_t count = 0;
+
+	OCF_CHECK_NULL(q);
+
+	/* LOCK */
+	env_spinlock_lock_irqsave(&q->io_list_lock, lock_flags);
+
+	if (q->lockless) {
+		while (count < max) {
+			req = _ocf_engine_pop_req_lockless(q);
+			if (!req)
+				break;
+
+			list_add_tail(&req->list, reqs);
+			count++;
+		}
+	} else {
+		/* Detach up to max requests, preserving queue order */
+		while (count < max && !list_empty(&q->io_list)) {
+			list_move_tail(q->io_list.next, reqs);
+			count++;
+		}
+
+		env_atomic_sub(count, &q->io_no);
+	}
+
+	/* UNLOCK */
+	env_spinlock_unlock_irqrestore(&q->io_list_lock, lock_flags);
+
+	return count;
+}
+
 bool ocf_fallback_pt_is_on(ocf_cache_t cache)
 {
 	ENV_BUG_ON(env_atomic_read(&cache->fallback_pt_error_counter) < 0);
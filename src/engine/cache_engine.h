@@ -51,6 +51,9 @@ bool ocf_fallback_pt_is_on(ocf_cache_t cache);
 
 struct ocf_request *ocf_engine_pop_req(struct ocf_queue *q);
 
+uint32_t ocf_engine_pop_reqs(struct ocf_queue *q, struct list_head *reqs,
+		uint32_t max);
+
 int ocf_engine_hndl_req(struct ocf_request *req);
 
 #define OCF_FAST_PATH_YES	7
@@ -53,6 +53,16 @@ void ocf_engine_lookup_map_entry(struct ocf_cache *cache,
 	entry->core_line = core_line;
 	entry->core_id = core_id;
 
+	if (ocf_metadata_lookup_index_ready(cache)) {
+		line = ocf_metadata_lookup_index_find(cache, core_id,
+				core_line);
+		if (line != cache->device->collision_table_entries) {
+			entry->coll_idx = line;
+			entry->status = LOOKUP_HIT;
+		}
+		return;
+	}
+
 	line = ocf_metadata_get_hash(cache, hash);
 
 	while (line != cache->device->collision_table_entries) {
@@ -72,6 +82,76 @@ void ocf_engine_lookup_map_entry(struct ocf_cache *cache,
 	}
 }
 
+/*
+ * Number of core lines, which metadata is prefetched before being looked up.
+ * Should be small enough to keep prefetched entries in L1.
+ */
+#define OCF_ENGINE_LOOKUP_BATCH 16
+
+static void ocf_engine_lookup_prefetch(struct ocf_cache *cache,
+		ocf_core_id_t core_id, uint64_t core_line_first, uint32_t count)
+{
+	ocf_cache_line_t hash, line;
+	uint32_t i;
+
+	if (ocf_metadata_lookup_index_ready(cache)) {
+		for (i = 0; i < count; i++) {
+			ocf_metadata_lookup_index_prefetch(cache, core_id,
+					core_line_first + i);
+		}
+		for (i = 0; i < count; i++) {
+			ocf_metadata_lookup_index_prefetch_lines(cache, core_id,
+					core_line_first + i);
+		}
+		return;
+	}
+
+	/* Hash values of consecutive core lines are consecutive */
+	hash = ocf_metadata_hash_func(cache, core_line_first, core_id);
+	for (i = 0; i < count; i++) {
+		ocf_metadata_prefetch_hash(cache, hash);
+		if (++hash == cache->device->hash_table_entries)
+			hash = 0;
+	}
+
+	/* Prefetch head of each collision list */
+	hash = ocf_metadata_hash_func(cache, core_line_first, core_id);
+	for (i = 0; i < count; i++) {
+		line = ocf_metadata_get_hash(cache, hash);
+		if (line != cache->device->collision_table_entries) {
+			ocf_metadata_prefetch_core_info(cache, line);
+			ocf_metadata_prefetch_collision_info(cache, line);
+		}
+		if (++hash == cache->device->hash_table_entries)
+			hash = 0;
+	}
+}
+
+void ocf_engine_lookup_map_entries(struct ocf_cache *cache,
+		struct ocf_map_info *map, ocf_core_id_t core_id,
+		uint64_t core_line_first, uint32_t count)
+{
+	uint32_t i, j, batch;
+
+	if (count == 1) {
+		ocf_engine_lookup_map_entry(cache, map, core_id,
+				core_line_first);
+		return;
+	}
+
+	for (i = 0; i < count; i += batch) {
+		batch = OCF_MIN(count - i, OCF_ENGINE_LOOKUP_BATCH);
+
+		ocf_engine_lookup_prefetch(cache, core_id,
+				core_line_first + i, batch);
+
+		for (j = i; j < i + batch; j++) {
+			ocf_engine_lookup_map_entry(cache, &map[j], core_id,
+					core_line_first + j);
+		}
+	}
+}
+
 static inline int _ocf_engine_check_map_entry(struct ocf_cache *cache,
 		struct ocf_map_info *entry, ocf_core_id_t core_id)
 {
@@ -184,7 +264,7 @@ static void ocf_engine_update_req_info(struct ocf_cache *cache,
 		req->info.seq_no++;
 }
 
-static void ocf_engine_set_hot(struct ocf_request *req)
+void ocf_engine_set_hot(struct ocf_request *req)
 {
 	struct ocf_cache *cache = req->cache;
 	struct ocf_map_info *entry;
@@ -207,10 +287,9 @@ static void ocf_engine_set_hot(struct ocf_request *req)
 	}
 }
 
-static void ocf_engine_lookup(struct ocf_request *req)
+void ocf_engine_lookup(struct ocf_request *req)
 {
 	uint32_t i;
-	uint64_t core_line;
 
 	struct ocf_cache *cache = req->cache;
 	ocf_core_id_t core_id = ocf_core_get_id(req->core);
@@ -219,14 +298,12 @@ static void ocf_engine_lookup(struct ocf_request *req)
 
 	ocf_req_clear_info(req);
 
-	for (i = 0, core_line = req->core_line_first;
-			core_line <= req->core_line_last; core_line++, i++) {
+	ocf_engine_lookup_map_entries(cache, req->map, core_id,
+			req->core_line_first, req->core_line_count);
 
+	for (i = 0; i < req->core_line_count; i++) {
 		struct ocf_map_info *entry = &(req->map[i]);
 
-		ocf_engine_lookup_map_entry(cache, entry, core_id,
-				core_line);
-
 		if (entry->status != LOOKUP_HIT) {
 			/* There is miss then lookup for next map entry */
 			OCF_DEBUG_PARAM(cache, "Miss, core line = %llu",
@@ -600,12 +677,19 @@ void ocf_engine_push_req_back(struct ocf_request *req, bool allow_sync)
 				env_ticks_to_msecs(env_get_tick_count()));
 	}
 
-	env_spinlock_lock_irqsave(&q->io_list_lock, lock_flags);
+	if (q->lockless) {
+		/* Count the request first, so that consumer never sees
+		 * more requests than io_no */
+		env_atomic_inc(&q->io_no);
+		ocf_mpsc_push(&q->io_mpsc, &req->mpsc_node);
+	} else {
+		env_spinlock_lock_irqsave(&q->io_list_lock, lock_flags);
 
-	list_add_tail(&req->list, &q->io_list);
-	env_atomic_inc(&q->io_no);
+		list_add_tail(&req->list, &q->io_list);
+		env_atomic_inc(&q->io_no);
 
-	env_spinlock_unlock_irqrestore(&q->io_list_lock, lock_flags);
+		env_spinlock_unlock_irqrestore(&q->io_list_lock, lock_flags);
+	}
 
 	/* NOTE: do not dereference @req past this line, it might
 	 * be picked up by concurrent io thread and deallocated
@@ -630,12 +714,17 @@ void ocf_engine_push_req_front(struct ocf_request *req, bool allow_sync)
 				env_ticks_to_msecs(env_get_tick_count()));
 	}
 
-	env_spinlock_lock_irqsave(&q->io_list_lock, lock_flags);
+	if (q->lockless) {
+		env_atomic_inc(&q->io_no);
+		ocf_mpsc_push(&q->io_mpsc_prio, &req->mpsc_node);
+	} else {
+		env_spinlock_lock_irqsave(&q->io_list_lock, lock_flags);
 
-	list_add(&req->list, &q->io_list);
-	env_atomic_inc(&q->io_no);
+		list_add(&req->list, &q->io_list);
+		env_atomic_inc(&q->io_no);
 
-	env_spinlock_unlock_irqrestore(&q->io_list_lock, lock_flags);
+		env_spinlock_unlock_irqrestore(&q->io_list_lock, lock_flags);
+	}
 
 	/* NOTE: do not dereference @req past this line, it might
 	 * be picked up by concurrent io thread and deallocated
@@ -210,6 +210,19 @@ void ocf_engine_lookup_map_entry(struct ocf_cache *cache,
 		struct ocf_map_info *entry, ocf_core_id_t core_id,
 		uint64_t core_line);
 
+/**
+ * @brief Lookup consecutive core lines, prefetching metadata of next lookups
+ *
+ * @param cache OCF cache instance
+ * @param map Array of @count map entries to be filled
+ * @param core_id Core id
+ * @param core_line_first First core line
+ * @param count Number of core lines
+ */
+void ocf_engine_lookup_map_entries(struct ocf_cache *cache,
+		struct ocf_map_info *map, ocf_core_id_t core_id,
+		uint64_t core_line_first, uint32_t count);
+
 /**
  * @brief Engine-specific callbacks for common request handling rountine
  *
@@ -233,6 +246,20 @@ struct ocf_engine_callbacks
  */
 int ocf_engine_prepare_clines(struct ocf_request *req);
 
+/**
+ * @brief Lookup OCF request in cache without updating replacement policy
+ *
+ * @param req OCF request
+ */
+void ocf_engine_lookup(struct ocf_request *req);
+
+/**
+ * @brief Mark cache lines hit by OCF request as recently used
+ *
+ * @param req OCF request
+ */
+void ocf_engine_set_hot(struct ocf_request *req);
+
 /**
  * @brief Traverse OCF request (lookup cache)
  *
@@ -100,6 +100,47 @@ static int _ocf_read_fast_do(struct ocf_request *req)
 	return 0;
 }
 
+/*
+ * Lookup read hit without taking hash bucket locks. Mapping is validated
+ * with hash bucket lock sequence numbers after cache lines are locked, as
+ * cache line read lock prevents them from being evicted or invalidated.
+ * Lookup index is required, as its lookup is bounded, unlike walking
+ * collision list which may be modified concurrently.
+ */
+static bool _ocf_read_fast_optimistic(struct ocf_request *req)
+{
+	struct ocf_alock *c = ocf_cache_line_concurrency(req->cache);
+	bool locked = false;
+	uint64_t seq;
+
+	if (!ocf_metadata_lookup_index_ready(req->cache))
+		return false;
+
+	if (!ocf_hb_req_prot_read_begin(req, &seq))
+		goto end;
+
+	ocf_engine_lookup(req);
+
+	if (!ocf_engine_is_hit(req) || !ocf_user_part_has_space(req))
+		goto end;
+
+	if (ocf_req_trylock_rd(c, req) != OCF_LOCK_ACQUIRED)
+		goto end;
+
+	if (ocf_hb_req_prot_read_retry(req, seq)) {
+		ocf_req_unlock_rd(c, req);
+		goto end;
+	}
+
+	ocf_engine_set_hot(req);
+	locked = true;
+
+end:
+	ocf_hb_req_prot_read_end(req);
+
+	return locked;
+}
+
 int ocf_read_fast(struct ocf_request *req)
 {
 	bool hit;
@@ -112,9 +153,17 @@ int ocf_read_fast(struct ocf_request *req)
 	/* Set resume handler */
 	req->engine_handler = _ocf_read_fast_do;
 
+	ocf_req_hash(req);
+
+	if (_ocf_read_fast_optimistic(req)) {
+		OCF_DEBUG_RQ(req, "Optimistic fast path success");
+		_ocf_read_fast_do(req);
+		ocf_req_put(req);
+		return OCF_FAST_PATH_YES;
+	}
+
 	/*- Metadata RD access -----------------------------------------------*/
 
-	ocf_req_hash(req);
 	ocf_hb_req_prot_lock_rd(req);
 
 	/* Traverse request to cache if there is hit */
@@ -60,6 +60,12 @@ static inline size_t ocf_metadata_status_sizeof(ocf_cache_line_size_t line_size)
 	return size;
 }
 
+static inline size_t ocf_metadata_map_sizeof(bool compact)
+{
+	return compact ? sizeof(struct ocf_metadata_map_compact) :
+			sizeof(struct ocf_metadata_map);
+}
+
 /*
  * get entries for specified metadata hash type
  */
@@ -118,7 +124,7 @@ static ocf_cache_line_t ocf_metadata_get_entries(
  */
 static int64_t ocf_metadata_get_element_size(
 		enum ocf_metadata_segment_id type,
-		ocf_cache_line_size_t line_size)
+		ocf_cache_line_size_t line_size, bool compact)
 {
 	int64_t size = 0;
 
@@ -134,7 +140,7 @@ static int64_t ocf_metadata_get_element_size(
 		break;
 
 	case metadata_segment_collision:
-		size = sizeof(struct ocf_metadata_map)
+		size = ocf_metadata_map_sizeof(compact)
 			+ ocf_metadata_status_sizeof(line_size);
 		break;
 
@@ -216,6 +222,27 @@ static bool ocf_metadata_is_flapped(
 	}
 }
 
+/*
+ * Check if modified pages of particular metadata type are tracked, so that
+ * only those need to be written on flush. This requires all updates to go
+ * through accessors which mark modified pages.
+ */
+static bool ocf_metadata_is_tracked(
+		enum ocf_metadata_segment_id type)
+{
+	switch (type) {
+	case metadata_segment_cleaning:
+	case metadata_segment_lru:
+	case metadata_segment_collision:
+	case metadata_segment_list_info:
+	case metadata_segment_hash:
+		return true;
+
+	default:
+		return false;
+	}
+}
+
 /*
  * Metadata calculation exception handling.
  *
@@ -439,6 +466,9 @@ void ocf_metadata_deinit_variable_size(struct ocf_cache *cache)
 
 	ocf_metadata_concurrency_attached_deinit(&cache->metadata.lock);
 
+	ocf_metadata_lookup_index_deinit(cache);
+	ocf_metadata_dirty_index_deinit(cache);
+
 	/*
 	 * De initialize RAW types
 	 */
@@ -513,7 +543,7 @@ static struct ocf_metadata_ctrl *ocf_metadata_ctrl_init(
 
 		/* Entry size configuration */
 		raw->entry_size
-			= ocf_metadata_get_element_size(i, 0);
+			= ocf_metadata_get_element_size(i, 0, false);
 		raw->entries_in_page = PAGE_SIZE / raw->entry_size;
 
 		/* Setup flapping support */
@@ -643,7 +673,7 @@ static void ocf_metadata_flush_unlock_collision_page(
  */
 int ocf_metadata_init_variable_size(struct ocf_cache *cache,
 		uint64_t device_size, ocf_cache_line_size_t line_size,
-		bool cleaner_disabled)
+		bool cleaner_disabled, bool compact)
 {
 	int result = 0;
 	uint32_t i = 0;
@@ -673,8 +703,10 @@ int ocf_metadata_init_variable_size(struct ocf_cache *cache,
 		/* Re-initialize metadata with different cache line size */
 		ocf_metadata_config_init(cache, line_size);
 
+	cache->metadata.compact = compact;
+
 	ctrl->mapping_size = ocf_metadata_status_sizeof(line_size)
-		+ sizeof(struct ocf_metadata_map);
+		+ ocf_metadata_map_sizeof(compact);
 
 	/* Initial setup of dynamic size RAW containers */
 	for (i = metadata_segment_variable_size_start;
@@ -700,11 +732,14 @@ int ocf_metadata_init_variable_size(struct ocf_cache *cache,
 
 		/* Entry size configuration */
 		raw->entry_size
-			= ocf_metadata_get_element_size(i, line_size);
+			= ocf_metadata_get_element_size(i, line_size,
+					compact);
 		raw->entries_in_page = PAGE_SIZE / raw->entry_size;
 
 		/* Setup flapping support */
 		raw->flapping = ocf_metadata_is_flapped(i);
+
+		raw->tracked = ocf_metadata_is_tracked(i);
 	}
 
 	if (0 != ocf_metadata_calculate_metadata_size(cache, ctrl, line_size)) {
@@ -795,12 +830,16 @@ finalize:
 	cache->conf_meta->cachelines = ctrl->cachelines;
 	cache->conf_meta->line_size = line_size;
 	cache->conf_meta->cleaner_disabled = cleaner_disabled;
+	cache->conf_meta->compact_metadata = compact;
 
 	ocf_metadata_raw_info(cache, ctrl);
 
 	ocf_cache_log(cache, log_info, "Cache line size: %llu kiB\n",
 			line_size / KiB);
 
+	if (compact)
+		ocf_cache_log(cache, log_info, "Compact metadata layout\n");
+
 	ocf_cache_log(cache, log_info, "Metadata size on device: %llu kiB\n",
 			cache->device->metadata_offset / KiB);
 
@@ -815,6 +854,16 @@ finalize:
 		return  result;
 	}
 
+	if (cache->use_lookup_index) {
+		result = ocf_metadata_lookup_index_init(cache);
+		if (result) {
+			ocf_cache_log(cache, log_err, "Failed to initialize "
+					"lookup index\n");
+			ocf_metadata_deinit_variable_size(cache);
+			return result;
+		}
+	}
+
 	return 0;
 }
 
@@ -919,6 +968,8 @@ static int ocf_metadata_init_hash_table_handle(ocf_parallelize_t parallelize,
 		ocf_metadata_set_hash(cache, entry, invalid_idx);
 	}
 
+	ocf_metadata_lookup_index_reset(cache, shard_id, shards_cnt);
+
 	return 0;
 }
 
@@ -1231,20 +1282,31 @@ struct ocf_pipeline_arg ocf_metadata_load_all_args[] = {
 	OCF_PL_ARG_TERMINATOR(),
 };
 
+struct ocf_pipeline_arg ocf_metadata_load_all_cleaning_args[] = {
+	OCF_PL_ARG_INT(metadata_segment_cleaning),
+	OCF_PL_ARG_INT(metadata_segment_core_runtime),
+	OCF_PL_ARG_INT(metadata_segment_lru),
+	OCF_PL_ARG_INT(metadata_segment_collision),
+	OCF_PL_ARG_INT(metadata_segment_list_info),
+	OCF_PL_ARG_INT(metadata_segment_hash),
+	OCF_PL_ARG_TERMINATOR(),
+};
+
+static bool ocf_check_if_cleaner_disabled(ocf_pipeline_t pipeline,
+		void* priv, ocf_pipeline_arg_t arg)
+{
+	return !ocf_check_if_cleaner_enabled(pipeline, priv, arg);
+}
+
 struct ocf_pipeline_properties ocf_metadata_load_all_pipeline_props = {
 	.priv_size = sizeof(struct ocf_metadata_context),
 	.finish = ocf_metadata_load_all_finish,
 	.steps = {
-		OCF_PL_STEP_COND_ARG_INT(ocf_check_if_cleaner_enabled,
-				ocf_metadata_load_segment,
-				metadata_segment_cleaning),
-		OCF_PL_STEP_FOREACH(ocf_metadata_load_segment,
-				ocf_metadata_load_all_args),
-
-		OCF_PL_STEP_COND_ARG_INT(ocf_check_if_cleaner_enabled,
-				ocf_metadata_check_crc,
-				metadata_segment_cleaning),
-		OCF_PL_STEP_FOREACH(ocf_metadata_check_crc,
+		OCF_PL_STEP_COND_ARG_PTR(ocf_check_if_cleaner_enabled,
+				ocf_metadata_load_segments,
+				ocf_metadata_load_all_cleaning_args),
+		OCF_PL_STEP_COND_ARG_PTR(ocf_check_if_cleaner_disabled,
+				ocf_metadata_load_segments,
 				ocf_metadata_load_all_args),
 		OCF_PL_STEP_TERMINATOR(),
 	},
@@ -1512,8 +1574,12 @@ void ocf_metadata_get_core_and_part_id(struct ocf_cache *cache,
 
 	ENV_BUG_ON(!collision || !info);
 
-	if (core_id)
-		*core_id = collision->core_id;
+	if (core_id) {
+		*core_id = cache->metadata.compact ?
+			((const struct ocf_metadata_map_compact *)
+					collision)->core_id :
+			collision->core_id;
+	}
 	if (part_id)
 		*part_id = info->partition_id;
 }
@@ -1534,6 +1600,19 @@ ocf_cache_line_t ocf_metadata_get_hash(struct ocf_cache *cache,
 			&(ctrl->raw_desc[metadata_segment_hash]), index);
 }
 
+/*
+ * Hash Table - Prefetch
+ */
+void ocf_metadata_prefetch_hash(struct ocf_cache *cache,
+		ocf_cache_line_t index)
+{
+	struct ocf_metadata_ctrl *ctrl
+		= (struct ocf_metadata_ctrl *) cache->metadata.priv;
+
+	env_prefetch(ocf_metadata_raw_rd_access(cache,
+			&(ctrl->raw_desc[metadata_segment_hash]), index));
+}
+
 /*
  * Hash Table - Set
  */
@@ -1553,21 +1632,32 @@ void ocf_metadata_set_hash(struct ocf_cache *cache, ocf_cache_line_t index,
 
 #include "metadata_bit.h"
 
+/* Select status bit function of metadata layout used by cache */
+#define _ocf_metadata_bit(what, type, cache, ...) \
+	((cache)->metadata.compact ? \
+		_ocf_metadata_##what##_compact_##type(cache, __VA_ARGS__) : \
+		_ocf_metadata_##what##_##type(cache, __VA_ARGS__))
+
 #define _ocf_metadata_funcs_5arg(what) \
 bool ocf_metadata_##what(struct ocf_cache *cache, \
 	 ocf_cache_line_t line, uint8_t start, uint8_t stop, bool all) \
 { \
 	switch (cache->metadata.line_size) { \
 		case ocf_cache_line_size_4: \
-			return _ocf_metadata_##what##_u8(cache, line, start, stop, all); \
+			return _ocf_metadata_bit(what, u8, cache, \
+				line, start, stop, all); \
 		case ocf_cache_line_size_8: \
-			return _ocf_metadata_##what##_u16(cache, line, start, stop, all); \
+			return _ocf_metadata_bit(what, u16, cache, \
+				line, start, stop, all); \
 		case ocf_cache_line_size_16: \
-			return _ocf_metadata_##what##_u32(cache, line, start, stop, all); \
+			return _ocf_metadata_bit(what, u32, cache, \
+				line, start, stop, all); \
 		case ocf_cache_line_size_32: \
-			return _ocf_metadata_##what##_u64(cache, line, start, stop, all); \
+			return _ocf_metadata_bit(what, u64, cache, \
+				line, start, stop, all); \
 		case ocf_cache_line_size_64: \
-			return _ocf_metadata_##what##_u128(cache, line, start, stop, all); \
+			return _ocf_metadata_bit(what, u128, cache, \
+				line, start, stop, all); \
 		case ocf_cache_line_size_none: \
 		default: \
 			ENV_BUG_ON(1); \
@@ -1582,15 +1672,20 @@ bool ocf_metadata_##what(struct ocf_cache *cache, \
 { \
 	switch (cache->metadata.line_size) { \
 		case ocf_cache_line_size_4: \
-			return _ocf_metadata_##what##_u8(cache, line, start, stop); \
+			return _ocf_metadata_bit(what, u8, cache, \
+				line, start, stop); \
 		case ocf_cache_line_size_8: \
-			return _ocf_metadata_##what##_u16(cache, line, start, stop); \
+			return _ocf_metadata_bit(what, u16, cache, \
+				line, start, stop); \
 		case ocf_cache_line_size_16: \
-			return _ocf_metadata_##what##_u32(cache, line, start, stop); \
+			return _ocf_metadata_bit(what, u32, cache, \
+				line, start, stop); \
 		case ocf_cache_line_size_32: \
-			return _ocf_metadata_##what##_u64(cache, line, start, stop); \
+			return _ocf_metadata_bit(what, u64, cache, \
+				line, start, stop); \
 		case ocf_cache_line_size_64: \
-			return _ocf_metadata_##what##_u128(cache, line, start, stop); \
+			return _ocf_metadata_bit(what, u128, cache, \
+				line, start, stop); \
 		case ocf_cache_line_size_none: \
 		default: \
 			ENV_BUG_ON(1); \
@@ -1614,19 +1709,19 @@ bool ocf_metadata_clear_valid_if_clean(struct ocf_cache *cache,
 {
 	switch (cache->metadata.line_size) {
 		case ocf_cache_line_size_4:
-			return _ocf_metadata_clear_valid_if_clean_u8(cache,
+			return _ocf_metadata_bit(clear_valid_if_clean, u8, cache,
 					line, start, stop);
 		case ocf_cache_line_size_8:
-			return _ocf_metadata_clear_valid_if_clean_u16(cache,
+			return _ocf_metadata_bit(clear_valid_if_clean, u16, cache,
 					line, start, stop);
 		case ocf_cache_line_size_16:
-			return _ocf_metadata_clear_valid_if_clean_u32(cache,
+			return _ocf_metadata_bit(clear_valid_if_clean, u32, cache,
 					line, start, stop);
 		case ocf_cache_line_size_32:
-			return _ocf_metadata_clear_valid_if_clean_u64(cache,
+			return _ocf_metadata_bit(clear_valid_if_clean, u64, cache,
 					line, start, stop);
 		case ocf_cache_line_size_64:
-			return _ocf_metadata_clear_valid_if_clean_u128(cache,
+			return _ocf_metadata_bit(clear_valid_if_clean, u128, cache,
 					line, start, stop);
 		case ocf_cache_line_size_none:
 		default:
@@ -1640,19 +1735,19 @@ void ocf_metadata_clear_dirty_if_invalid(struct ocf_cache *cache,
 {
 	switch (cache->metadata.line_size) {
 		case ocf_cache_line_size_4:
-			return _ocf_metadata_clear_dirty_if_invalid_u8(cache,
+			return _ocf_metadata_bit(clear_dirty_if_invalid, u8, cache,
 					line, start, stop);
 		case ocf_cache_line_size_8:
-			return _ocf_metadata_clear_dirty_if_invalid_u16(cache,
+			return _ocf_metadata_bit(clear_dirty_if_invalid, u16, cache,
 					line, start, stop);
 		case ocf_cache_line_size_16:
-			return _ocf_metadata_clear_dirty_if_invalid_u32(cache,
+			return _ocf_metadata_bit(clear_dirty_if_invalid, u32, cache,
 					line, start, stop);
 		case ocf_cache_line_size_32:
-			return _ocf_metadata_clear_dirty_if_invalid_u64(cache,
+			return _ocf_metadata_bit(clear_dirty_if_invalid, u64, cache,
 					line, start, stop);
 		case ocf_cache_line_size_64:
-			return _ocf_metadata_clear_dirty_if_invalid_u128(cache,
+			return _ocf_metadata_bit(clear_dirty_if_invalid, u128, cache,
 					line, start, stop);
 		case ocf_cache_line_size_none:
 		default:
@@ -1664,15 +1759,15 @@ bool ocf_metadata_check(struct ocf_cache *cache, ocf_cache_line_t line)
 {
 	switch (cache->metadata.line_size) {
 		case ocf_cache_line_size_4:
-			return _ocf_metadata_check_u8(cache, line);
+			return _ocf_metadata_bit(check, u8, cache, line);
 		case ocf_cache_line_size_8:
-			return _ocf_metadata_check_u16(cache, line);
+			return _ocf_metadata_bit(check, u16, cache, line);
 		case ocf_cache_line_size_16:
-			return _ocf_metadata_check_u32(cache, line);
+			return _ocf_metadata_bit(check, u32, cache, line);
 		case ocf_cache_line_size_32:
-			return _ocf_metadata_check_u64(cache, line);
+			return _ocf_metadata_bit(check, u64, cache, line);
 		case ocf_cache_line_size_64:
-			return _ocf_metadata_check_u128(cache, line);
+			return _ocf_metadata_bit(check, u128, cache, line);
 		case ocf_cache_line_size_none:
 		default:
 			ENV_BUG_ON(1);
@@ -1742,6 +1837,7 @@ static void ocf_metadata_load_properties_cmpl(
 		OCF_CMPL_RET(priv, result, NULL);
 
 	properties.line_size = superblock->line_size;
+	properties.compact_metadata = superblock->compact_metadata;
 	properties.cache_mode = superblock->cache_mode;
 	properties.shutdown_status = superblock->clean_shutdown;
 	properties.dirty_flushed = superblock->dirty_flushed;
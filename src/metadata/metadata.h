@@ -16,6 +16,9 @@
 #include "metadata_superblock.h"
 #include "metadata_status.h"
 #include "metadata_collision.h"
+#include "metadata_lookup_index.h"
+#include "metadata_dirty_index.h"
+#include "metadata_lazy_load.h"
 #include "metadata_core.h"
 #include "metadata_misc.h"
 #include "metadata_passive_update.h"
@@ -52,11 +55,12 @@ int ocf_metadata_init(struct ocf_cache *cache,
  * @param device_size - Device size in bytes
  * @param cache_line_size Cache line size
  * @param cleaner_disabled Cleaner is disabled
+ * @param compact Use compact layout of per cache line metadata
  * @return 0 - Operation success otherwise failure
  */
 int ocf_metadata_init_variable_size(struct ocf_cache *cache,
 		uint64_t device_size, ocf_cache_line_size_t line_size,
-		bool cleaner_disabled);
+		bool cleaner_disabled, bool compact);
 
 /**
  * @brief Initialize collision table
@@ -209,11 +213,15 @@ ocf_metadata_get_hash(struct ocf_cache *cache, ocf_cache_line_t index);
 void ocf_metadata_set_hash(struct ocf_cache *cache,
 		ocf_cache_line_t index, ocf_cache_line_t line);
 
+void ocf_metadata_prefetch_hash(struct ocf_cache *cache,
+		ocf_cache_line_t index);
+
 struct ocf_metadata_load_properties {
 	enum ocf_metadata_shutdown_status shutdown_status;
 	uint8_t dirty_flushed;
 	ocf_cache_mode_t cache_mode;
 	ocf_cache_line_size_t line_size;
+	bool compact_metadata;
 	char *cache_name;
 	bool cleaner_disabled;
 };
@@ -44,15 +44,15 @@ static inline u128 _get_mask_u128(uint8_t start, uint8_t stop)
 	return mask;
 }
 
-#define ocf_metadata_bit_struct(type) \
-struct ocf_metadata_map_##type { \
-	struct ocf_metadata_map map; \
+#define ocf_metadata_bit_struct(name, header, type) \
+struct ocf_metadata_map_##name { \
+	struct header map; \
 	type valid; \
 	type dirty; \
 } __attribute__((packed))
 
-#define ocf_metadata_bit_func(what, type) \
-static bool _ocf_metadata_test_##what##_##type(struct ocf_cache *cache, \
+#define ocf_metadata_bit_func(what, name, type) \
+static bool _ocf_metadata_test_##what##_##name(struct ocf_cache *cache, \
 		ocf_cache_line_t line, uint8_t start, uint8_t stop, bool all) \
 { \
 	type mask = _get_mask_##type(start, stop); \
@@ -63,7 +63,7 @@ static bool _ocf_metadata_test_##what##_##type(struct ocf_cache *cache, \
 	struct ocf_metadata_raw *raw = \
 			&ctrl->raw_desc[metadata_segment_collision]; \
 \
-	const struct ocf_metadata_map_##type *map = raw->mem_pool; \
+	const struct ocf_metadata_map_##name *map = raw->mem_pool; \
 \
 	_raw_bug_on(raw, line); \
 \
@@ -82,7 +82,7 @@ static bool _ocf_metadata_test_##what##_##type(struct ocf_cache *cache, \
 	} \
 } \
 \
-static bool _ocf_metadata_test_out_##what##_##type(struct ocf_cache *cache, \
+static bool _ocf_metadata_test_out_##what##_##name(struct ocf_cache *cache, \
 		ocf_cache_line_t line, uint8_t start, uint8_t stop) \
 { \
 	type mask = _get_mask_##type(start, stop); \
@@ -93,7 +93,7 @@ static bool _ocf_metadata_test_out_##what##_##type(struct ocf_cache *cache, \
 	struct ocf_metadata_raw *raw = \
 			&ctrl->raw_desc[metadata_segment_collision]; \
 \
-	const struct ocf_metadata_map_##type *map = raw->mem_pool; \
+	const struct ocf_metadata_map_##name *map = raw->mem_pool; \
 \
 	_raw_bug_on(raw, line); \
 \
@@ -104,7 +104,7 @@ static bool _ocf_metadata_test_out_##what##_##type(struct ocf_cache *cache, \
 	} \
 } \
 \
-static bool _ocf_metadata_clear_##what##_##type(struct ocf_cache *cache, \
+static bool _ocf_metadata_clear_##what##_##name(struct ocf_cache *cache, \
 		ocf_cache_line_t line, uint8_t start, uint8_t stop) \
 { \
 	type mask = _get_mask_##type(start, stop); \
@@ -115,9 +115,10 @@ static bool _ocf_metadata_clear_##what##_##type(struct ocf_cache *cache, \
 	struct ocf_metadata_raw *raw = \
 			&ctrl->raw_desc[metadata_segment_collision]; \
 \
-	struct ocf_metadata_map_##type *map = raw->mem_pool; \
+	struct ocf_metadata_map_##name *map = raw->mem_pool; \
 \
 	_raw_bug_on(raw, line); \
+	ocf_metadata_raw_set_modified(raw, line); \
 \
 	map[line].what &= ~mask; \
 \
@@ -128,7 +129,7 @@ static bool _ocf_metadata_clear_##what##_##type(struct ocf_cache *cache, \
 	} \
 } \
 \
-static bool _ocf_metadata_set_##what##_##type(struct ocf_cache *cache, \
+static bool _ocf_metadata_set_##what##_##name(struct ocf_cache *cache, \
 		ocf_cache_line_t line, uint8_t start, uint8_t stop) \
 { \
 	bool result; \
@@ -140,9 +141,10 @@ static bool _ocf_metadata_set_##what##_##type(struct ocf_cache *cache, \
 	struct ocf_metadata_raw *raw = \
 			&ctrl->raw_desc[metadata_segment_collision]; \
 \
-	struct ocf_metadata_map_##type *map = raw->mem_pool; \
+	struct ocf_metadata_map_##name *map = raw->mem_pool; \
 \
 	_raw_bug_on(raw, line); \
+	ocf_metadata_raw_set_modified(raw, line); \
 \
 	result = map[line].what ? true : false; \
 \
@@ -151,7 +153,7 @@ static bool _ocf_metadata_set_##what##_##type(struct ocf_cache *cache, \
 	return result; \
 } \
 \
-static bool _ocf_metadata_test_and_set_##what##_##type( \
+static bool _ocf_metadata_test_and_set_##what##_##name( \
 		struct ocf_cache *cache, ocf_cache_line_t line, \
 		uint8_t start, uint8_t stop, bool all) \
 { \
@@ -164,9 +166,10 @@ static bool _ocf_metadata_test_and_set_##what##_##type( \
 	struct ocf_metadata_raw *raw = \
 			&ctrl->raw_desc[metadata_segment_collision]; \
 \
-	struct ocf_metadata_map_##type *map = raw->mem_pool; \
+	struct ocf_metadata_map_##name *map = raw->mem_pool; \
 \
 	_raw_bug_on(raw, line); \
+	ocf_metadata_raw_set_modified(raw, line); \
 \
 	if (all) { \
 		if (mask == (map[line].what & mask)) { \
@@ -186,7 +189,7 @@ static bool _ocf_metadata_test_and_set_##what##_##type( \
 	return test; \
 } \
 \
-static bool _ocf_metadata_test_and_clear_##what##_##type( \
+static bool _ocf_metadata_test_and_clear_##what##_##name( \
 		struct ocf_cache *cache, ocf_cache_line_t line, \
 		uint8_t start, uint8_t stop, bool all) \
 { \
@@ -199,9 +202,10 @@ static bool _ocf_metadata_test_and_clear_##what##_##type( \
 	struct ocf_metadata_raw *raw = \
 			&ctrl->raw_desc[metadata_segment_collision]; \
 \
-	struct ocf_metadata_map_##type *map = raw->mem_pool; \
+	struct ocf_metadata_map_##name *map = raw->mem_pool; \
 \
 	_raw_bug_on(raw, line); \
+	ocf_metadata_raw_set_modified(raw, line); \
 \
 	if (all) { \
 		if (mask == (map[line].what & mask)) { \
@@ -221,8 +225,8 @@ static bool _ocf_metadata_test_and_clear_##what##_##type( \
 	return test; \
 } \
 
-#define ocf_metadata_bit_func_basic(type) \
-static bool _ocf_metadata_clear_valid_if_clean_##type(struct ocf_cache *cache, \
+#define ocf_metadata_bit_func_basic(name, type) \
+static bool _ocf_metadata_clear_valid_if_clean_##name(struct ocf_cache *cache, \
 		ocf_cache_line_t line, uint8_t start, uint8_t stop) \
 { \
 	type mask = _get_mask_##type(start, stop); \
@@ -233,9 +237,10 @@ static bool _ocf_metadata_clear_valid_if_clean_##type(struct ocf_cache *cache, \
 	struct ocf_metadata_raw *raw = \
 			&ctrl->raw_desc[metadata_segment_collision]; \
 \
-	struct ocf_metadata_map_##type *map = raw->mem_pool; \
+	struct ocf_metadata_map_##name *map = raw->mem_pool; \
 \
 	_raw_bug_on(raw, line); \
+	ocf_metadata_raw_set_modified(raw, line); \
 \
 	map[line].valid &= (mask & map[line].dirty) | (~mask); \
 \
@@ -246,7 +251,7 @@ static bool _ocf_metadata_clear_valid_if_clean_##type(struct ocf_cache *cache, \
 	} \
 } \
 \
-static void _ocf_metadata_clear_dirty_if_invalid_##type(struct ocf_cache *cache, \
+static void _ocf_metadata_clear_dirty_if_invalid_##name(struct ocf_cache *cache, \
 		ocf_cache_line_t line, uint8_t start, uint8_t stop) \
 { \
 	type mask = _get_mask_##type(start, stop); \
@@ -257,15 +262,16 @@ static void _ocf_metadata_clear_dirty_if_invalid_##type(struct ocf_cache *cache,
 	struct ocf_metadata_raw *raw = \
 			&ctrl->raw_desc[metadata_segment_collision]; \
 \
-	struct ocf_metadata_map_##type *map = raw->mem_pool; \
+	struct ocf_metadata_map_##name *map = raw->mem_pool; \
 \
 	_raw_bug_on(raw, line); \
+	ocf_metadata_raw_set_modified(raw, line); \
 \
 	map[line].dirty &= (mask & map[line].valid) | (~mask); \
 } \
 \
 /* true if no incorrect combination of status bits */ \
-static bool _ocf_metadata_check_##type(struct ocf_cache *cache, \
+static bool _ocf_metadata_check_##name(struct ocf_cache *cache, \
 		ocf_cache_line_t line) \
 { \
 	struct ocf_metadata_ctrl *ctrl = \
@@ -274,21 +280,28 @@ static bool _ocf_metadata_check_##type(struct ocf_cache *cache, \
 	struct ocf_metadata_raw *raw = \
 			&ctrl->raw_desc[metadata_segment_collision]; \
 \
-	struct ocf_metadata_map_##type *map = raw->mem_pool; \
+	struct ocf_metadata_map_##name *map = raw->mem_pool; \
 \
 	_raw_bug_on(raw, line); \
 \
 	return (map[line].dirty & (~map[line].valid)) == 0; \
 } \
 
-#define ocf_metadata_bit_funcs(type) \
-ocf_metadata_bit_struct(type); \
-ocf_metadata_bit_func(dirty, type); \
-ocf_metadata_bit_func(valid, type); \
-ocf_metadata_bit_func_basic(type); \
+#define ocf_metadata_bit_funcs(name, header, type) \
+ocf_metadata_bit_struct(name, header, type); \
+ocf_metadata_bit_func(dirty, name, type); \
+ocf_metadata_bit_func(valid, name, type); \
+ocf_metadata_bit_func_basic(name, type); \
 
-ocf_metadata_bit_funcs(u8);
-ocf_metadata_bit_funcs(u16);
-ocf_metadata_bit_funcs(u32);
-ocf_metadata_bit_funcs(u64);
-ocf_metadata_bit_funcs(u128);
+ocf_metadata_bit_funcs(u8, ocf_metadata_map, u8);
+ocf_metadata_bit_funcs(u16, ocf_metadata_map, u16);
+ocf_metadata_bit_funcs(u32, ocf_metadata_map, u32);
+ocf_metadata_bit_funcs(u64, ocf_metadata_map, u64);
+ocf_metadata_bit_funcs(u128, ocf_metadata_map, u128);
+
+/* Compact layout, see struct ocf_metadata_map_compact */
+ocf_metadata_bit_funcs(compact_u8, ocf_metadata_map_compact, u8);
+ocf_metadata_bit_funcs(compact_u16, ocf_metadata_map_compact, u16);
+ocf_metadata_bit_funcs(compact_u32, ocf_metadata_map_compact, u32);
+ocf_metadata_bit_funcs(compact_u64, ocf_metadata_map_compact, u64);
+ocf_metadata_bit_funcs(compact_u128, ocf_metadata_map_compact, u128);
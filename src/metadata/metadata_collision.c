@@ -86,6 +86,15 @@ void ocf_metadata_get_collision_info(struct ocf_cache *cache,
 	}
 }
 
+void ocf_metadata_prefetch_collision_info(struct ocf_cache *cache,
+		ocf_cache_line_t line)
+{
+	struct ocf_metadata_ctrl *ctrl =
+		(struct ocf_metadata_ctrl *) cache->metadata.priv;
+
+	env_prefetch(ocf_metadata_raw_rd_access(cache,
+			&(ctrl->raw_desc[metadata_segment_list_info]), line));
+}
 
 /*
  *
@@ -122,6 +131,11 @@ void ocf_metadata_add_to_collision(struct ocf_cache *cache,
 	 * collision table so it contains indexes in collision table
 	 */
 	ocf_metadata_set_hash(cache, hash, cache_line);
+
+	if (ocf_metadata_lookup_index_enabled(cache)) {
+		ocf_metadata_lookup_index_insert(cache, core_id, core_line,
+				cache_line);
+	}
 }
 
 /*
@@ -160,6 +174,11 @@ void ocf_metadata_remove_from_collision(struct ocf_cache *cache,
 	if (ocf_metadata_get_hash(cache, hash_father) == line)
 		ocf_metadata_set_hash(cache, hash_father, next_line);
 
+	if (ocf_metadata_lookup_index_enabled(cache)) {
+		ocf_metadata_lookup_index_remove(cache, core_id, core_sector,
+				line);
+	}
+
 	ocf_metadata_set_collision_info(cache, line,
 			line_entries, line_entries);
 
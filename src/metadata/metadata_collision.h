@@ -34,6 +34,32 @@ struct ocf_metadata_map {
 		/*!<  Entry status structure e.g. valid, dirty...*/
 } __attribute__((packed));
 
+/*
+ * Compact map takes 6 bytes instead of 10. Core id has to hold OCF_CORE_MAX,
+ * which marks unmapped cache line. Core line field addresses 128 TiB of core
+ * with 4 KiB cache line and 2 PiB with 64 KiB cache line, bigger cores can't
+ * be added to cache with compact metadata.
+ */
+#define OCF_METADATA_COMPACT_CORE_ID_BITS 13
+#define OCF_METADATA_COMPACT_CORE_LINE_BITS 35
+#define OCF_METADATA_COMPACT_CORE_LINE_INVALID \
+	((1ULL << OCF_METADATA_COMPACT_CORE_LINE_BITS) - 1)
+
+/**
+ * @brief Metadata map structure of compact metadata layout
+ */
+
+struct ocf_metadata_map_compact {
+	uint64_t core_line : OCF_METADATA_COMPACT_CORE_LINE_BITS;
+		/*!<  Core line addres on cache mapped by this strcture */
+
+	uint64_t core_id : OCF_METADATA_COMPACT_CORE_ID_BITS;
+		/*!<  ID of core where is assigned this cache line*/
+
+	uint8_t status[];
+		/*!<  Entry status structure e.g. valid, dirty...*/
+} __attribute__((packed));
+
 void ocf_metadata_set_collision_info(
 		struct ocf_cache *cache, ocf_cache_line_t line,
 		ocf_cache_line_t next, ocf_cache_line_t prev);
@@ -50,6 +76,9 @@ void ocf_metadata_get_collision_info(
 		struct ocf_cache *cache, ocf_cache_line_t line,
 		ocf_cache_line_t *next, ocf_cache_line_t *prev);
 
+void ocf_metadata_prefetch_collision_info(
+		struct ocf_cache *cache, ocf_cache_line_t line);
+
 static inline ocf_cache_line_t ocf_metadata_get_collision_next(
 		struct ocf_cache *cache, ocf_cache_line_t line)
 {
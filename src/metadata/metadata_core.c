@@ -10,10 +10,43 @@
 #include "metadata_internal.h"
 #include "metadata_raw.h"
 
+static inline uint64_t ocf_metadata_compact_get_core_line(
+		const struct ocf_metadata_map_compact *collision)
+{
+	if (collision->core_line == OCF_METADATA_COMPACT_CORE_LINE_INVALID)
+		return ULLONG_MAX;
+
+	return collision->core_line;
+}
+
+static inline void ocf_metadata_compact_set_core_line(
+		struct ocf_metadata_map_compact *collision, uint64_t core_line)
+{
+	ENV_BUILD_BUG_ON(OCF_CORE_MAX >=
+			(1 << OCF_METADATA_COMPACT_CORE_ID_BITS));
+
+	/* Core lines not fitting in compact map are only invalid ones */
+	if (core_line >= OCF_METADATA_COMPACT_CORE_LINE_INVALID)
+		core_line = OCF_METADATA_COMPACT_CORE_LINE_INVALID;
+
+	collision->core_line = core_line;
+}
+
+bool ocf_metadata_core_length_supported(struct ocf_cache *cache,
+		uint64_t length)
+{
+	if (!cache->metadata.compact)
+		return true;
+
+	return OCF_DIV_ROUND_UP(length, ocf_line_size(cache)) <=
+			OCF_METADATA_COMPACT_CORE_LINE_INVALID;
+}
+
 void ocf_metadata_get_core_info(struct ocf_cache *cache,
 		ocf_cache_line_t line, ocf_core_id_t *core_id,
 		uint64_t *core_sector)
 {
+	const struct ocf_metadata_map_compact *compact;
 	const struct ocf_metadata_map *collision;
 	struct ocf_metadata_ctrl *ctrl =
 		(struct ocf_metadata_ctrl *) cache->metadata.priv;
@@ -23,6 +56,15 @@ void ocf_metadata_get_core_info(struct ocf_cache *cache,
 
 	ENV_BUG_ON(!collision);
 
+	if (cache->metadata.compact) {
+		compact = (const void *)collision;
+		if (core_id)
+			*core_id = compact->core_id;
+		if (core_sector)
+			*core_sector = ocf_metadata_compact_get_core_line(compact);
+		return;
+	}
+
 	if (core_id)
 		*core_id = collision->core_id;
 	if (core_sector)
@@ -33,6 +75,7 @@ void ocf_metadata_set_core_info(struct ocf_cache *cache,
 		ocf_cache_line_t line, ocf_core_id_t core_id,
 		uint64_t core_sector)
 {
+	struct ocf_metadata_map_compact *compact;
 	struct ocf_metadata_map *collision;
 	struct ocf_metadata_ctrl *ctrl =
 		(struct ocf_metadata_ctrl *) cache->metadata.priv;
@@ -40,14 +83,31 @@ void ocf_metadata_set_core_info(struct ocf_cache *cache,
 	collision = ocf_metadata_raw_wr_access(cache,
 			&(ctrl->raw_desc[metadata_segment_collision]), line);
 
-	if (collision) {
+	if (!collision) {
+		ocf_metadata_error(cache);
+		return;
+	}
+
+	if (cache->metadata.compact) {
+		compact = (void *)collision;
+		compact->core_id = core_id;
+		ocf_metadata_compact_set_core_line(compact, core_sector);
+	} else {
 		collision->core_id = core_id;
 		collision->core_line = core_sector;
-	} else {
-		ocf_metadata_error(cache);
 	}
 }
 
+void ocf_metadata_prefetch_core_info(struct ocf_cache *cache,
+		ocf_cache_line_t line)
+{
+	struct ocf_metadata_ctrl *ctrl =
+		(struct ocf_metadata_ctrl *) cache->metadata.priv;
+
+	env_prefetch(ocf_metadata_raw_rd_access(cache,
+			&(ctrl->raw_desc[metadata_segment_collision]), line));
+}
+
 ocf_core_id_t ocf_metadata_get_core_id(struct ocf_cache *cache,
 		ocf_cache_line_t line)
 {
@@ -58,11 +118,15 @@ ocf_core_id_t ocf_metadata_get_core_id(struct ocf_cache *cache,
 	collision = ocf_metadata_raw_rd_access(cache,
 			&(ctrl->raw_desc[metadata_segment_collision]), line);
 
-	if (collision)
-		return collision->core_id;
+	if (!collision) {
+		ocf_metadata_error(cache);
+		return OCF_CORE_MAX;
+	}
+
+	if (cache->metadata.compact)
+		return ((const struct ocf_metadata_map_compact *)collision)->core_id;
 
-	ocf_metadata_error(cache);
-	return OCF_CORE_MAX;
+	return collision->core_id;
 }
 
 struct ocf_metadata_uuid *ocf_metadata_get_core_uuid(
@@ -16,6 +16,20 @@ void ocf_metadata_set_core_info(struct ocf_cache *cache,
 		ocf_cache_line_t line, ocf_core_id_t core_id,
 		uint64_t core_sector);
 
+void ocf_metadata_prefetch_core_info(struct ocf_cache *cache,
+		ocf_cache_line_t line);
+
+/**
+ * @brief Check if all core lines of core with given length can be mapped
+ *	with metadata layout of cache
+ *
+ * @param cache - Cache instance
+ * @param length - Core volume length in bytes
+ * @return true if core can be added to cache
+ */
+bool ocf_metadata_core_length_supported(struct ocf_cache *cache,
+		uint64_t length);
+
 ocf_core_id_t ocf_metadata_get_core_id(
 		struct ocf_cache *cache, ocf_cache_line_t line);
 
@@ -0,0 +1,172 @@
+/*
+ * Copyright(c) 2024 Huawei Technologies
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "ocf/ocf.h"
+#include "metadata.h"
+#include "metadata_dirty_index.h"
+#include "../utils/utils_parallelize.h"
+
+int ocf_metadata_dirty_index_core_init(struct ocf_cache *cache,
+		ocf_core_t core)
+{
+	ocf_cache_line_t entries = cache->device->collision_table_entries;
+	struct ocf_dirty_index *index;
+	uint32_t chunks_cnt, groups_cnt;
+
+	chunks_cnt = OCF_DIV_ROUND_UP((uint64_t)entries,
+			OCF_DIRTY_INDEX_CHUNK_LINES);
+	groups_cnt = OCF_DIV_ROUND_UP(chunks_cnt,
+			1U << OCF_DIRTY_INDEX_GROUP_SHIFT);
+
+	index = env_vzalloc(sizeof(*index) +
+			(chunks_cnt + groups_cnt) * sizeof(env_atomic));
+	if (!index)
+		return -OCF_ERR_NO_MEM;
+
+	index->chunks = (env_atomic *)(index + 1);
+	index->groups = index->chunks + chunks_cnt;
+	index->chunks_cnt = chunks_cnt;
+	index->groups_cnt = groups_cnt;
+	index->valid_chunks = chunks_cnt;
+
+	ocf_metadata_dirty_index_core_deinit(core);
+	core->dirty_index = index;
+
+	return 0;
+}
+
+void ocf_metadata_dirty_index_core_deinit(ocf_core_t core)
+{
+	env_vfree(core->dirty_index);
+	core->dirty_index = NULL;
+}
+
+void ocf_metadata_dirty_index_deinit(struct ocf_cache *cache)
+{
+	ocf_core_id_t core_id;
+
+	for (core_id = 0; core_id < OCF_CORE_MAX; core_id++)
+		ocf_metadata_dirty_index_core_deinit(&cache->core[core_id]);
+}
+
+ocf_cache_line_t ocf_metadata_dirty_index_next(struct ocf_dirty_index *index,
+		ocf_cache_line_t line, ocf_cache_line_t entries)
+{
+	uint32_t chunk = line >> OCF_DIRTY_INDEX_CHUNK_SHIFT;
+	uint32_t group;
+
+	while (chunk < index->chunks_cnt) {
+		/* Chunk not populated yet may contain dirty lines */
+		if (chunk >= index->valid_chunks) {
+			return OCF_MAX(line, (ocf_cache_line_t)chunk <<
+					OCF_DIRTY_INDEX_CHUNK_SHIFT);
+		}
+
+		group = chunk >> OCF_DIRTY_INDEX_GROUP_SHIFT;
+		if (!env_atomic_read(&index->groups[group])) {
+			/* Group counter covers only its populated chunks */
+			chunk = OCF_MIN((group + 1) <<
+					OCF_DIRTY_INDEX_GROUP_SHIFT,
+					index->valid_chunks);
+			continue;
+		}
+
+		if (env_atomic_read(&index->chunks[chunk])) {
+			return OCF_MAX(line, (ocf_cache_line_t)chunk <<
+					OCF_DIRTY_INDEX_CHUNK_SHIFT);
+		}
+
+		chunk++;
+	}
+
+	return entries;
+}
+
+struct ocf_dirty_index_populate_context {
+	ocf_cache_t cache;
+	ocf_metadata_end_t cmpl;
+	void *priv;
+};
+
+static int ocf_metadata_dirty_index_populate_handle(
+		ocf_parallelize_t parallelize, void *priv, unsigned shard_id,
+		unsigned shards_cnt)
+{
+	struct ocf_dirty_index_populate_context *context = priv;
+	ocf_cache_t cache = context->cache;
+	ocf_cache_line_t entries = cache->device->collision_table_entries;
+	ocf_cache_line_t line, portion, begin, end;
+	ocf_core_id_t core_id;
+	uint64_t core_line;
+	uint32_t step = 0;
+
+	portion = OCF_DIV_ROUND_UP((uint64_t)entries, shards_cnt);
+	begin = OCF_MIN((uint64_t)portion * shard_id, entries);
+	end = OCF_MIN((uint64_t)portion * (shard_id + 1), entries);
+
+	for (line = begin; line < end; line++) {
+		OCF_COND_RESCHED_DEFAULT(step);
+
+		ocf_metadata_get_core_info(cache, line, &core_id, &core_line);
+		if (core_id >= OCF_CORE_MAX)
+			continue;
+
+		if (!metadata_test_valid_any(cache, line) ||
+				!metadata_test_dirty(cache, line)) {
+			continue;
+		}
+
+		ocf_metadata_dirty_index_inc(&cache->core[core_id], line);
+	}
+
+	return 0;
+}
+
+static void ocf_metadata_dirty_index_populate_finish(
+		ocf_parallelize_t parallelize, void *priv, int error)
+{
+	struct ocf_dirty_index_populate_context *context = priv;
+
+	context->cmpl(context->priv, error);
+
+	ocf_parallelize_destroy(parallelize);
+}
+
+void ocf_metadata_dirty_index_populate(struct ocf_cache *cache,
+		ocf_metadata_end_t cmpl, void *priv)
+{
+	struct ocf_dirty_index_populate_context *context;
+	ocf_parallelize_t parallelize;
+	ocf_core_t core;
+	ocf_core_id_t core_id;
+	bool dirty = false;
+	int result;
+
+	for_each_core(cache, core, core_id) {
+		result = ocf_metadata_dirty_index_core_init(cache, core);
+		if (result)
+			OCF_CMPL_RET(priv, result);
+
+		if (env_atomic_read(&core->runtime_meta->dirty_clines))
+			dirty = true;
+	}
+
+	if (!dirty)
+		OCF_CMPL_RET(priv, 0);
+
+	result = ocf_parallelize_create(&parallelize, cache,
+			ocf_cache_get_queue_count(cache), sizeof(*context),
+			ocf_metadata_dirty_index_populate_handle,
+			ocf_metadata_dirty_index_populate_finish);
+	if (result)
+		OCF_CMPL_RET(priv, result);
+
+	context = ocf_parallelize_get_priv(parallelize);
+	context->cache = cache;
+	context->cmpl = cmpl;
+	context->priv = priv;
+
+	ocf_parallelize_run(parallelize);
+}
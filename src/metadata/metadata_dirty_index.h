@@ -0,0 +1,111 @@
+/*
+ * Copyright(c) 2024 Huawei Technologies
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __METADATA_DIRTY_INDEX_H__
+#define __METADATA_DIRTY_INDEX_H__
+
+#include "metadata_common.h"
+#include "../ocf_core_priv.h"
+
+/*
+ * Dirty index is a volatile, per-core summary of dirty cache lines. Cache
+ * lines are split into chunks and chunks into groups, and each chunk and
+ * group has a counter of dirty lines of given core which it contains. It is
+ * updated together with dirty lines counters of the core and allows flush of
+ * single core to visit only chunks containing its dirty data instead of
+ * scanning whole collision table.
+ */
+
+#define OCF_DIRTY_INDEX_CHUNK_SHIFT 12
+#define OCF_DIRTY_INDEX_CHUNK_LINES (1U << OCF_DIRTY_INDEX_CHUNK_SHIFT)
+#define OCF_DIRTY_INDEX_GROUP_SHIFT 6
+
+struct ocf_dirty_index {
+	env_atomic *chunks;
+	env_atomic *groups;
+	uint32_t chunks_cnt;
+	uint32_t groups_cnt;
+	uint32_t valid_chunks;
+		/*!< Chunks below this one are counted. Counters of the others
+		 * are not maintained until they are populated in background
+		 * after lazy load, and they are assumed to contain dirty
+		 * lines */
+};
+
+/**
+ * @brief Allocate empty dirty index of core for all cache lines of attached
+ *	cache
+ *
+ * @param cache - Cache instance
+ * @param core - Core
+ * @return 0 - Operation success otherwise failure
+ */
+int ocf_metadata_dirty_index_core_init(struct ocf_cache *cache,
+		ocf_core_t core);
+
+/**
+ * @brief Free dirty index of core
+ *
+ * @param core - Core
+ */
+void ocf_metadata_dirty_index_core_deinit(ocf_core_t core);
+
+/**
+ * @brief Free dirty indexes of all cores
+ *
+ * @param cache - Cache instance
+ */
+void ocf_metadata_dirty_index_deinit(struct ocf_cache *cache);
+
+/**
+ * @brief Allocate dirty indexes of all added cores and fill them with dirty
+ *	cache lines found in collision table
+ *
+ * @param cache - Cache instance
+ * @param cmpl - Completion callback
+ * @param priv - Completion context
+ */
+void ocf_metadata_dirty_index_populate(struct ocf_cache *cache,
+		ocf_metadata_end_t cmpl, void *priv);
+
+/**
+ * @brief Find first cache line not lower than given one, which belongs to
+ *	chunk containing dirty cache lines of core
+ *
+ * @param index - Dirty index of core
+ * @param line - Cache line to start search from
+ * @param entries - Number of cache lines
+ * @return Cache line or entries if there are no more dirty chunks
+ */
+ocf_cache_line_t ocf_metadata_dirty_index_next(struct ocf_dirty_index *index,
+		ocf_cache_line_t line, ocf_cache_line_t entries);
+
+static inline void ocf_metadata_dirty_index_inc(ocf_core_t core,
+		ocf_cache_line_t line)
+{
+	struct ocf_dirty_index *index = core->dirty_index;
+	uint32_t chunk = line >> OCF_DIRTY_INDEX_CHUNK_SHIFT;
+
+	if (!index || chunk >= index->valid_chunks)
+		return;
+
+	env_atomic_inc(&index->chunks[chunk]);
+	env_atomic_inc(&index->groups[chunk >> OCF_DIRTY_INDEX_GROUP_SHIFT]);
+}
+
+static inline void ocf_metadata_dirty_index_dec(ocf_core_t core,
+		ocf_cache_line_t line)
+{
+	struct ocf_dirty_index *index = core->dirty_index;
+	uint32_t chunk = line >> OCF_DIRTY_INDEX_CHUNK_SHIFT;
+
+	if (!index || chunk >= index->valid_chunks)
+		return;
+
+	env_atomic_dec(&index->chunks[chunk]);
+	env_atomic_dec(&index->groups[chunk >> OCF_DIRTY_INDEX_GROUP_SHIFT]);
+}
+
+#endif /* __METADATA_DIRTY_INDEX_H__ */
@@ -57,8 +57,6 @@ enum ocf_mio_size {
 	ocf_mio_size_max,
 };
 
-#define METADATA_IO_REQS_LIMIT 128
-
 static void metadata_io_read_i_atomic_complete(
 		struct metadata_io_read_i_atomic_context *context, int error)
 {
@@ -221,6 +219,7 @@ static int metadata_io_do(struct ocf_request *req)
 {
 	struct metadata_io_request *m_req = req->priv;
 	ocf_cache_t cache = req->cache;
+	unsigned lock_idx;
 	struct ocf_io *io;
 	int ret;
 
@@ -228,11 +227,12 @@ static int metadata_io_do(struct ocf_request *req)
 
 	/* Fill with the latest metadata. */
 	if (m_req->req.rw == OCF_WRITE) {
+		lock_idx = m_req->page % cache->metadata.lock.num_global_locks;
 		ocf_metadata_start_shared_access(&cache->metadata.lock,
-				m_req->page % OCF_NUM_GLOBAL_META_LOCKS);
+				lock_idx);
 		metadata_io_req_fill(m_req);
 		ocf_metadata_end_shared_access(&cache->metadata.lock,
-				 m_req->page % OCF_NUM_GLOBAL_META_LOCKS);
+				lock_idx);
 	}
 
 	io = ocf_new_cache_io(cache, req->io_queue,
@@ -403,12 +403,40 @@ void metadata_io_req_complete(struct metadata_io_request *m_req)
 	ocf_engine_push_req_front(&m_req->req, true);
 }
 
+/*
+ * Pick queue for request starting at given chunk of metadata. If spreading
+ * is requested, requests are distributed round robin over I/O queues, so
+ * that their submission and completion handling run in parallel, also
+ * across concurrently loaded segments.
+ */
+static ocf_queue_t metadata_io_get_queue(ocf_cache_t cache, ocf_queue_t queue,
+		bool spread, uint32_t chunk)
+{
+	ocf_queue_t io_queue;
+	uint32_t queue_count;
+
+	if (!spread)
+		return queue;
+
+	queue_count = ocf_cache_get_queue_count(cache);
+	if (queue_count == 0)
+		return queue;
+
+	chunk %= queue_count;
+	list_for_each_entry(io_queue, &cache->io_queues, list) {
+		if (chunk-- == 0)
+			return io_queue;
+	}
+
+	return queue;
+}
+
 /*
  * Iterative write request asynchronously
  */
 static int metadata_io_i_asynch(ocf_cache_t cache, ocf_queue_t queue, int dir,
 		void *context, uint32_t page, uint32_t count, int flags,
-		ocf_metadata_io_event_t io_hndl,
+		bool spread, ocf_metadata_io_event_t io_hndl,
 		ocf_metadata_io_end_t compl_hndl,
 		struct ocf_alock *mio_conc)
 {
@@ -416,7 +444,7 @@ static int metadata_io_i_asynch(ocf_cache_t cache, ocf_queue_t queue, int dir,
 	struct metadata_io_request *m_req;
 	uint32_t max_count = metadata_io_max_page(cache);
 	uint32_t io_count = OCF_DIV_ROUND_UP(count, max_count);
-	uint32_t req_count = OCF_MIN(io_count, METADATA_IO_REQS_LIMIT);
+	uint32_t req_count = OCF_MIN(io_count, cache->metadata.io_depth);
 	int i;
 	struct env_mpool *mio_allocator = cache->owner->resources.mio;
 
@@ -449,7 +477,8 @@ static int metadata_io_i_asynch(ocf_cache_t cache, ocf_queue_t queue, int dir,
 		m_req->cache = cache;
 		m_req->context = context;
 		m_req->req.engine_handler = metadata_io_restart_req;
-		m_req->req.io_queue = queue;
+		m_req->req.io_queue = metadata_io_get_queue(cache, queue,
+				spread, page / max_count + i);
 		m_req->req.cache = cache;
 		m_req->req.priv = m_req;
 		m_req->req.info.internal = true;
@@ -495,7 +524,8 @@ int metadata_io_write_i_asynch(ocf_cache_t cache, ocf_queue_t queue,
 		struct ocf_alock *mio_conc)
 {
 	return metadata_io_i_asynch(cache, queue, OCF_WRITE, context,
-			page, count, flags, fill_hndl, compl_hndl, mio_conc);
+			page, count, flags, false, fill_hndl, compl_hndl,
+			mio_conc);
 }
 
 int metadata_io_read_i_asynch(ocf_cache_t cache, ocf_queue_t queue,
@@ -504,7 +534,18 @@ int metadata_io_read_i_asynch(ocf_cache_t cache, ocf_queue_t queue,
 		ocf_metadata_io_end_t compl_hndl)
 {
 	return metadata_io_i_asynch(cache, queue, OCF_READ, context,
-			page, count, flags, drain_hndl, compl_hndl, NULL);
+			page, count, flags, false, drain_hndl, compl_hndl,
+			NULL);
+}
+
+int metadata_io_read_i_asynch_parallel(ocf_cache_t cache, ocf_queue_t queue,
+		void *context, uint32_t page, uint32_t count, int flags,
+		ocf_metadata_io_event_t drain_hndl,
+		ocf_metadata_io_end_t compl_hndl)
+{
+	return metadata_io_i_asynch(cache, queue, OCF_READ, context,
+			page, count, flags, true, drain_hndl, compl_hndl,
+			NULL);
 }
 
 #define MIO_RPOOL_LIMIT 16
@@ -146,6 +146,25 @@ int metadata_io_read_i_asynch(ocf_cache_t cache, ocf_queue_t queue,
 		ocf_metadata_io_event_t drain_hndl,
 		ocf_metadata_io_end_t compl_hndl);
 
+/**
+ * @brief Iterative asynchronous pages read spread over all I/O queues
+ *
+ * @param cache - Cache instance
+ * @param queue - Queue to be used if cache has no I/O queues
+ * @param context - Read context
+ * @param page - Start page of SSD (cache device) where data will be read
+ * @param count - Counts of page to be processed
+ * @param drain_hndl - Drain callback, may be called concurrently
+ *		for different pages
+ * @param compl_hndl - All IOs completed callback
+ *
+ * @return 0 - No errors, otherwise error occurred
+ */
+int metadata_io_read_i_asynch_parallel(ocf_cache_t cache, ocf_queue_t queue,
+		void *context, uint32_t page, uint32_t count, int flags,
+		ocf_metadata_io_event_t drain_hndl,
+		ocf_metadata_io_end_t compl_hndl);
+
 /**
  * Initialize ocf_ctx related structures of metadata_io (mpool).
  */
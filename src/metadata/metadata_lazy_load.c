@@ -0,0 +1,167 @@
+/*
+ * Copyright(c) 2024 Huawei Technologies
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "ocf/ocf.h"
+#include "metadata.h"
+#include "metadata_lazy_load.h"
+#include "metadata_lookup_index.h"
+#include "metadata_dirty_index.h"
+#include "../engine/engine_common.h"
+#include "../ocf_request.h"
+
+/*
+ * Number of cache lines populated under single exclusive metadata access.
+ * Multiple of dirty index chunk, so that chunks are populated at once.
+ */
+#define OCF_LAZY_LOAD_WINDOW_CHUNKS 32
+#define OCF_LAZY_LOAD_WINDOW_LINES \
+	(OCF_LAZY_LOAD_WINDOW_CHUNKS * OCF_DIRTY_INDEX_CHUNK_LINES)
+
+int ocf_metadata_lazy_load_prepare(struct ocf_cache *cache)
+{
+	struct ocf_request *req;
+	ocf_core_t core;
+	ocf_core_id_t core_id;
+	int result;
+
+	req = ocf_req_new(cache->mngt_queue, NULL, 0, 0, 0);
+	if (!req)
+		return -OCF_ERR_NO_MEM;
+
+	for_each_core(cache, core, core_id) {
+		result = ocf_metadata_dirty_index_core_init(cache, core);
+		if (result) {
+			ocf_req_put(req);
+			return result;
+		}
+
+		core->dirty_index->valid_chunks = 0;
+	}
+
+	if (ocf_metadata_lookup_index_enabled(cache))
+		cache->metadata.lookup_index->ready = false;
+
+	req->info.internal = true;
+	req->byte_position = 0;
+	cache->metadata.lazy_load_req = req;
+	env_atomic_set(&cache->metadata.lazy_load_pending, 1);
+
+	return 0;
+}
+
+static void ocf_metadata_lazy_load_finish(struct ocf_request *req,
+		bool complete)
+{
+	ocf_cache_t cache = req->cache;
+
+	if (complete) {
+		ocf_cache_log(cache, log_info,
+				"Volatile metadata indexes populated\n");
+	} else {
+		ocf_cache_log(cache, log_warn,
+				"Population of volatile metadata indexes "
+				"abandoned\n");
+	}
+
+	cache->metadata.lazy_load_req = NULL;
+	env_atomic_set(&cache->metadata.lazy_load_pending, 0);
+	ocf_req_put(req);
+
+	ocf_refcnt_dec(&cache->refcnt.metadata);
+}
+
+static void ocf_metadata_lazy_load_populate(struct ocf_cache *cache,
+		ocf_cache_line_t begin, ocf_cache_line_t end)
+{
+	ocf_cache_line_t entries = cache->device->collision_table_entries;
+	bool lookup_index = ocf_metadata_lookup_index_enabled(cache);
+	uint32_t valid_chunks;
+	ocf_cache_line_t line;
+	ocf_core_id_t core_id;
+	uint64_t core_line;
+	ocf_core_t core;
+
+	/* Dirty index counters of the window are maintained from now on */
+	valid_chunks = OCF_DIV_ROUND_UP((uint64_t)end,
+			OCF_DIRTY_INDEX_CHUNK_LINES);
+	for_each_core(cache, core, core_id) {
+		if (core->dirty_index)
+			core->dirty_index->valid_chunks = valid_chunks;
+	}
+
+	for (line = begin; line < end; line++) {
+		ocf_metadata_get_core_info(cache, line, &core_id, &core_line);
+		if (core_id >= OCF_CORE_MAX)
+			continue;
+
+		/* Mapping could be inserted by I/O since load */
+		if (lookup_index && ocf_metadata_lookup_index_find(cache,
+				core_id, core_line) != line) {
+			ocf_metadata_lookup_index_insert(cache, core_id,
+					core_line, line);
+		}
+
+		if (metadata_test_valid_any(cache, line) &&
+				metadata_test_dirty(cache, line)) {
+			ocf_metadata_dirty_index_inc(&cache->core[core_id],
+					line);
+		}
+	}
+
+	if (lookup_index && end == entries)
+		cache->metadata.lookup_index->ready = true;
+}
+
+static int ocf_metadata_lazy_load_step(struct ocf_request *req)
+{
+	ocf_cache_t cache = req->cache;
+	ocf_cache_line_t entries = cache->device->collision_table_entries;
+	ocf_cache_line_t begin = req->byte_position;
+	ocf_cache_line_t end;
+
+	/* Do not delay detach or stop */
+	if (ocf_refcnt_frozen(&cache->refcnt.metadata)) {
+		ocf_metadata_lazy_load_finish(req, false);
+		return 0;
+	}
+
+	end = OCF_MIN((uint64_t)begin + OCF_LAZY_LOAD_WINDOW_LINES, entries);
+
+	ocf_metadata_start_exclusive_access(&cache->metadata.lock);
+	ocf_metadata_lazy_load_populate(cache, begin, end);
+	ocf_metadata_end_exclusive_access(&cache->metadata.lock);
+
+	if (end == entries) {
+		ocf_metadata_lazy_load_finish(req, true);
+		return 0;
+	}
+
+	/* Let I/O waiting for metadata access go first */
+	req->byte_position = end;
+	ocf_engine_push_req_back(req, false);
+
+	return 0;
+}
+
+void ocf_metadata_lazy_load_start(struct ocf_cache *cache)
+{
+	struct ocf_request *req = cache->metadata.lazy_load_req;
+
+	ENV_BUG_ON(!req);
+
+	/* Keep metadata alive until population is finished or abandoned */
+	ENV_BUG_ON(!ocf_refcnt_inc(&cache->refcnt.metadata));
+
+	ocf_cache_log(cache, log_info, "Populating volatile metadata indexes "
+			"in background\n");
+
+	req->engine_handler = ocf_metadata_lazy_load_step;
+	ocf_engine_push_req_back(req, false);
+}
+
+bool ocf_metadata_lazy_load_pending(struct ocf_cache *cache)
+{
+	return !!env_atomic_read(&cache->metadata.lazy_load_pending);
+}
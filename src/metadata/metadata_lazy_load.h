@@ -0,0 +1,48 @@
+/*
+ * Copyright(c) 2024 Huawei Technologies
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __METADATA_LAZY_LOAD_H__
+#define __METADATA_LAZY_LOAD_H__
+
+#include "metadata_common.h"
+
+/*
+ * After lazy load cache starts serving I/O before volatile indexes (lookup
+ * index and dirty index) are populated. They are populated in background,
+ * window by window, with exclusive metadata access. Until then lookup walks
+ * collision lists and flush treats chunks not populated yet as dirty, so
+ * I/O and flush are correct, only slower. Collision table, LRU and cleaning
+ * metadata are loaded from cache device before I/O is accepted.
+ */
+
+/**
+ * @brief Allocate background population and mark volatile indexes as not
+ *	populated
+ *
+ * @param cache - Cache instance
+ * @return 0 - Operation success otherwise failure
+ */
+int ocf_metadata_lazy_load_prepare(struct ocf_cache *cache);
+
+/**
+ * @brief Start background population of volatile indexes prepared with
+ *	ocf_metadata_lazy_load_prepare()
+ *
+ * @note Population holds metadata reference, so detach and stop wait for
+ *	it. It is abandoned as soon as metadata reference counter is frozen.
+ *
+ * @param cache - Cache instance
+ */
+void ocf_metadata_lazy_load_start(struct ocf_cache *cache);
+
+/**
+ * @brief Check if volatile indexes are still populated in background
+ *
+ * @param cache - Cache instance
+ * @return true if population is in progress
+ */
+bool ocf_metadata_lazy_load_pending(struct ocf_cache *cache);
+
+#endif /* __METADATA_LAZY_LOAD_H__ */
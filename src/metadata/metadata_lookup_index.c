@@ -0,0 +1,342 @@
+/*
+ * Copyright(c) 2024 Huawei Technologies
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "ocf/ocf.h"
+#include "metadata.h"
+#include "metadata_lookup_index.h"
+#include "../utils/utils_parallelize.h"
+
+/* Maximum fill ratio of lookup index slots is 4/5 */
+#define OCF_LOOKUP_INDEX_LOAD_NUM 4
+#define OCF_LOOKUP_INDEX_LOAD_DEN 5
+
+static inline uint64_t ocf_lookup_index_hash(ocf_core_id_t core_id,
+		uint64_t core_line)
+{
+	uint64_t h = core_line ^ ((uint64_t)core_id * 0x9e3779b97f4a7c15ULL);
+
+	/* 64-bit finalizer of MurmurHash3 */
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+
+	return h;
+}
+
+static inline uint32_t ocf_lookup_index_home(struct ocf_lookup_index *index,
+		uint64_t h)
+{
+	/* Map upper half of the hash onto [0, buckets_cnt) without division,
+	 * lower half is used as fingerprint */
+	return ((h >> 32) * index->buckets_cnt) >> 32;
+}
+
+static inline uint32_t ocf_lookup_index_next(struct ocf_lookup_index *index,
+		uint32_t bucket)
+{
+	return ++bucket == index->buckets_cnt ? 0 : bucket;
+}
+
+static inline long ocf_lookup_index_slot(uint64_t h, ocf_cache_line_t line)
+{
+	return (long)((h << 32) | ((uint64_t)line + 1));
+}
+
+static inline ocf_cache_line_t ocf_lookup_index_slot_line(long slot)
+{
+	return (ocf_cache_line_t)((uint64_t)slot - 1);
+}
+
+static uint32_t ocf_lookup_index_buckets_cnt(uint64_t cache_lines)
+{
+	return OCF_DIV_ROUND_UP(cache_lines * OCF_LOOKUP_INDEX_LOAD_DEN,
+			OCF_LOOKUP_INDEX_BUCKET_SLOTS *
+			OCF_LOOKUP_INDEX_LOAD_NUM) ?: 1;
+}
+
+uint64_t ocf_metadata_lookup_index_size(uint64_t cache_lines)
+{
+	return (uint64_t)ocf_lookup_index_buckets_cnt(cache_lines) *
+			sizeof(struct ocf_lookup_index_bucket) +
+			sizeof(struct ocf_lookup_index_bucket);
+}
+
+int ocf_metadata_lookup_index_init(struct ocf_cache *cache)
+{
+	struct ocf_lookup_index *index;
+	uint64_t cache_lines = cache->device->collision_table_entries;
+	uintptr_t aligned;
+
+	ENV_BUILD_BUG_ON(sizeof(struct ocf_lookup_index_bucket) != 64);
+
+	index = env_vzalloc(sizeof(*index));
+	if (!index)
+		return -OCF_ERR_NO_MEM;
+
+	index->buckets_cnt = ocf_lookup_index_buckets_cnt(cache_lines);
+
+	/* Empty slot is represented by zero, so zeroed memory is empty index */
+	index->mem = env_vzalloc(ocf_metadata_lookup_index_size(cache_lines));
+	if (!index->mem) {
+		env_vfree(index);
+		return -OCF_ERR_NO_MEM;
+	}
+
+	aligned = OCF_DIV_ROUND_UP((uintptr_t)index->mem,
+			sizeof(struct ocf_lookup_index_bucket)) *
+			sizeof(struct ocf_lookup_index_bucket);
+	index->buckets = (struct ocf_lookup_index_bucket *)aligned;
+	index->ready = true;
+
+	cache->metadata.lookup_index = index;
+
+	ocf_cache_log(cache, log_info, "Lookup index size: %llu kiB\n",
+			ocf_metadata_lookup_index_size(cache_lines) / KiB);
+
+	return 0;
+}
+
+void ocf_metadata_lookup_index_deinit(struct ocf_cache *cache)
+{
+	struct ocf_lookup_index *index = cache->metadata.lookup_index;
+
+	if (!index)
+		return;
+
+	cache->metadata.lookup_index = NULL;
+
+	env_vfree(index->mem);
+	env_vfree(index);
+}
+
+void ocf_metadata_lookup_index_reset(struct ocf_cache *cache,
+		unsigned shard_id, unsigned shards_cnt)
+{
+	struct ocf_lookup_index *index = cache->metadata.lookup_index;
+	uint32_t portion, begin, end;
+
+	if (!index)
+		return;
+
+	portion = OCF_DIV_ROUND_UP((uint64_t)index->buckets_cnt, shards_cnt);
+	begin = OCF_MIN((uint64_t)portion * shard_id, index->buckets_cnt);
+	end = OCF_MIN((uint64_t)portion * (shard_id + 1), index->buckets_cnt);
+
+	if (begin == end)
+		return;
+
+	ENV_BUG_ON(env_memset(&index->buckets[begin],
+			(end - begin) * sizeof(*index->buckets), 0));
+}
+
+void ocf_metadata_lookup_index_insert(struct ocf_cache *cache,
+		ocf_core_id_t core_id, uint64_t core_line,
+		ocf_cache_line_t line)
+{
+	struct ocf_lookup_index *index = cache->metadata.lookup_index;
+	struct ocf_lookup_index_bucket *bucket;
+	uint64_t h = ocf_lookup_index_hash(core_id, core_line);
+	long value = ocf_lookup_index_slot(h, line);
+	uint32_t b = ocf_lookup_index_home(index, h);
+	uint32_t probes, i;
+
+	for (probes = 0; probes < index->buckets_cnt; probes++) {
+		bucket = &index->buckets[b];
+
+		for (i = 0; i < OCF_LOOKUP_INDEX_BUCKET_SLOTS; i++) {
+			if (env_atomic64_read(&bucket->slot[i]))
+				continue;
+			if (!env_atomic64_cmpxchg(&bucket->slot[i], 0, value))
+				return;
+		}
+
+		env_atomic_inc(&bucket->overflow);
+		b = ocf_lookup_index_next(index, b);
+	}
+
+	/* Index is sized for all cache lines, it can never be full */
+	ENV_BUG();
+}
+
+void ocf_metadata_lookup_index_remove(struct ocf_cache *cache,
+		ocf_core_id_t core_id, uint64_t core_line,
+		ocf_cache_line_t line)
+{
+	struct ocf_lookup_index *index = cache->metadata.lookup_index;
+	struct ocf_lookup_index_bucket *bucket;
+	uint64_t h = ocf_lookup_index_hash(core_id, core_line);
+	long value = ocf_lookup_index_slot(h, line);
+	uint32_t home = ocf_lookup_index_home(index, h);
+	uint32_t b = home;
+	uint32_t probes, i;
+
+	for (probes = 0; probes < index->buckets_cnt; probes++) {
+		bucket = &index->buckets[b];
+
+		for (i = 0; i < OCF_LOOKUP_INDEX_BUCKET_SLOTS; i++) {
+			if (env_atomic64_read(&bucket->slot[i]) != value)
+				continue;
+
+			env_atomic64_set(&bucket->slot[i], 0);
+
+			/* Entry no longer overflows buckets it skipped */
+			for (; home != b; home = ocf_lookup_index_next(index,
+					home)) {
+				env_atomic_dec(&index->buckets[home].overflow);
+			}
+			return;
+		}
+
+		if (!env_atomic_read(&bucket->overflow))
+			break;
+
+		b = ocf_lookup_index_next(index, b);
+	}
+}
+
+ocf_cache_line_t ocf_metadata_lookup_index_find(struct ocf_cache *cache,
+		ocf_core_id_t core_id, uint64_t core_line)
+{
+	struct ocf_lookup_index *index = cache->metadata.lookup_index;
+	struct ocf_lookup_index_bucket *bucket;
+	uint64_t h = ocf_lookup_index_hash(core_id, core_line);
+	uint32_t tag = (uint32_t)h;
+	uint32_t b = ocf_lookup_index_home(index, h);
+	ocf_core_id_t curr_core_id;
+	uint64_t curr_core_line;
+	ocf_cache_line_t line;
+	uint32_t probes, i;
+	long slot;
+
+	for (probes = 0; probes < index->buckets_cnt; probes++) {
+		bucket = &index->buckets[b];
+
+		for (i = 0; i < OCF_LOOKUP_INDEX_BUCKET_SLOTS; i++) {
+			slot = env_atomic64_read(&bucket->slot[i]);
+			if (!slot || (uint32_t)((uint64_t)slot >> 32) != tag)
+				continue;
+
+			/* Fingerprint matches - verify in collision table */
+			line = ocf_lookup_index_slot_line(slot);
+			ocf_metadata_get_core_info(cache, line, &curr_core_id,
+					&curr_core_line);
+			if (curr_core_id == core_id &&
+					curr_core_line == core_line) {
+				return line;
+			}
+		}
+
+		if (!env_atomic_read(&bucket->overflow))
+			break;
+
+		b = ocf_lookup_index_next(index, b);
+	}
+
+	return cache->device->collision_table_entries;
+}
+
+void ocf_metadata_lookup_index_prefetch(struct ocf_cache *cache,
+		ocf_core_id_t core_id, uint64_t core_line)
+{
+	struct ocf_lookup_index *index = cache->metadata.lookup_index;
+	uint64_t h = ocf_lookup_index_hash(core_id, core_line);
+
+	env_prefetch(&index->buckets[ocf_lookup_index_home(index, h)]);
+}
+
+void ocf_metadata_lookup_index_prefetch_lines(struct ocf_cache *cache,
+		ocf_core_id_t core_id, uint64_t core_line)
+{
+	struct ocf_lookup_index *index = cache->metadata.lookup_index;
+	struct ocf_lookup_index_bucket *bucket;
+	uint64_t h = ocf_lookup_index_hash(core_id, core_line);
+	uint32_t tag = (uint32_t)h;
+	uint32_t i;
+	long slot;
+
+	bucket = &index->buckets[ocf_lookup_index_home(index, h)];
+
+	for (i = 0; i < OCF_LOOKUP_INDEX_BUCKET_SLOTS; i++) {
+		slot = env_atomic64_read(&bucket->slot[i]);
+		if (!slot || (uint32_t)((uint64_t)slot >> 32) != tag)
+			continue;
+
+		ocf_metadata_prefetch_core_info(cache,
+				ocf_lookup_index_slot_line(slot));
+	}
+}
+
+struct ocf_lookup_index_populate_context {
+	ocf_cache_t cache;
+	ocf_metadata_end_t cmpl;
+	void *priv;
+};
+
+static int ocf_metadata_lookup_index_populate_handle(
+		ocf_parallelize_t parallelize, void *priv, unsigned shard_id,
+		unsigned shards_cnt)
+{
+	struct ocf_lookup_index_populate_context *context = priv;
+	ocf_cache_t cache = context->cache;
+	ocf_cache_line_t entries = cache->device->collision_table_entries;
+	ocf_cache_line_t line, portion, begin, end;
+	ocf_core_id_t core_id;
+	uint64_t core_line;
+	uint32_t step = 0;
+
+	portion = OCF_DIV_ROUND_UP((uint64_t)entries, shards_cnt);
+	begin = OCF_MIN((uint64_t)portion * shard_id, entries);
+	end = OCF_MIN((uint64_t)portion * (shard_id + 1), entries);
+
+	for (line = begin; line < end; line++) {
+		OCF_COND_RESCHED_DEFAULT(step);
+
+		ocf_metadata_get_core_info(cache, line, &core_id, &core_line);
+		if (core_id >= OCF_CORE_MAX)
+			continue;
+
+		ocf_metadata_lookup_index_insert(cache, core_id, core_line,
+				line);
+	}
+
+	return 0;
+}
+
+static void ocf_metadata_lookup_index_populate_finish(
+		ocf_parallelize_t parallelize, void *priv, int error)
+{
+	struct ocf_lookup_index_populate_context *context = priv;
+
+	context->cmpl(context->priv, error);
+
+	ocf_parallelize_destroy(parallelize);
+}
+
+void ocf_metadata_lookup_index_populate(struct ocf_cache *cache,
+		ocf_metadata_end_t cmpl, void *priv)
+{
+	struct ocf_lookup_index_populate_context *context;
+	ocf_parallelize_t parallelize;
+	int result;
+
+	if (!ocf_metadata_lookup_index_enabled(cache))
+		OCF_CMPL_RET(priv, 0);
+
+	result = ocf_parallelize_create(&parallelize, cache,
+			ocf_cache_get_queue_count(cache), sizeof(*context),
+			ocf_metadata_lookup_index_populate_handle,
+			ocf_metadata_lookup_index_populate_finish);
+	if (result)
+		OCF_CMPL_RET(priv, result);
+
+	context = ocf_parallelize_get_priv(parallelize);
+	context->cache = cache;
+	context->cmpl = cmpl;
+	context->priv = priv;
+
+	ocf_parallelize_run(parallelize);
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright(c) 2024 Huawei Technologies
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __METADATA_LOOKUP_INDEX_H__
+#define __METADATA_LOOKUP_INDEX_H__
+
+#include "metadata_common.h"
+
+/*
+ * Lookup index is a volatile, open-addressing hash table mapping
+ * (core id, core line) to cache line. It is kept in sync with collision
+ * table, which remains the source of truth persisted on cache device, and
+ * allows to resolve lookup with one bucket read and one collision table read
+ * instead of walking the collision list.
+ */
+
+#define OCF_LOOKUP_INDEX_BUCKET_SLOTS 7
+
+struct ocf_lookup_index_bucket {
+	env_atomic overflow;
+		/*!< Number of entries which hash to this or preceding bucket
+		 * but are stored in one of the following buckets */
+
+	uint32_t reserved;
+
+	env_atomic64 slot[OCF_LOOKUP_INDEX_BUCKET_SLOTS];
+		/*!< Fingerprint of (core id, core line) in upper 32 bits and
+		 * cache line number incremented by one in lower 32 bits,
+		 * 0 if slot is empty */
+} __attribute__((aligned(64)));
+
+struct ocf_lookup_index {
+	struct ocf_lookup_index_bucket *buckets;
+	uint32_t buckets_cnt;
+	bool ready;
+		/*!< Index contains all mapped cache lines. It is maintained
+		 * also while not ready, but lookup has to walk collision
+		 * list then */
+	void *mem;
+};
+
+/**
+ * @brief Get amount of memory required by lookup index
+ *
+ * @param cache_lines - Number of cache lines
+ * @return Size in bytes
+ */
+uint64_t ocf_metadata_lookup_index_size(uint64_t cache_lines);
+
+/**
+ * @brief Allocate lookup index for all cache lines of attached cache
+ *
+ * @param cache - Cache instance
+ * @return 0 - Operation success otherwise failure
+ */
+int ocf_metadata_lookup_index_init(struct ocf_cache *cache);
+
+/**
+ * @brief Free lookup index
+ *
+ * @param cache - Cache instance
+ */
+void ocf_metadata_lookup_index_deinit(struct ocf_cache *cache);
+
+/**
+ * @brief Remove all entries from part of lookup index
+ *
+ * @param cache - Cache instance
+ * @param shard_id - Part of lookup index to be reset
+ * @param shards_cnt - Number of parts lookup index is split into
+ */
+void ocf_metadata_lookup_index_reset(struct ocf_cache *cache,
+		unsigned shard_id, unsigned shards_cnt);
+
+/**
+ * @brief Add all cache lines mapped in collision table to lookup index
+ *
+ * @param cache - Cache instance
+ * @param cmpl - Completion callback
+ * @param priv - Completion context
+ */
+void ocf_metadata_lookup_index_populate(struct ocf_cache *cache,
+		ocf_metadata_end_t cmpl, void *priv);
+
+void ocf_metadata_lookup_index_insert(struct ocf_cache *cache,
+		ocf_core_id_t core_id, uint64_t core_line,
+		ocf_cache_line_t line);
+
+void ocf_metadata_lookup_index_remove(struct ocf_cache *cache,
+		ocf_core_id_t core_id, uint64_t core_line,
+		ocf_cache_line_t line);
+
+/**
+ * @brief Find cache line mapping given core line
+ *
+ * @param cache - Cache instance
+ * @param core_id - Core id
+ * @param core_line - Core line
+ * @return Cache line or collision_table_entries if core line is not mapped
+ */
+ocf_cache_line_t ocf_metadata_lookup_index_find(struct ocf_cache *cache,
+		ocf_core_id_t core_id, uint64_t core_line);
+
+/**
+ * @brief Prefetch lookup index bucket of given core line
+ *
+ * @param cache - Cache instance
+ * @param core_id - Core id
+ * @param core_line - Core line
+ */
+void ocf_metadata_lookup_index_prefetch(struct ocf_cache *cache,
+		ocf_core_id_t core_id, uint64_t core_line);
+
+/**
+ * @brief Prefetch collision entries of cache lines, which fingerprints
+ *	in lookup index bucket match given core line
+ *
+ * @note Bucket should be prefetched before with
+ *	ocf_metadata_lookup_index_prefetch()
+ *
+ * @param cache - Cache instance
+ * @param core_id - Core id
+ * @param core_line - Core line
+ */
+void ocf_metadata_lookup_index_prefetch_lines(struct ocf_cache *cache,
+		ocf_core_id_t core_id, uint64_t core_line);
+
+static inline bool ocf_metadata_lookup_index_enabled(struct ocf_cache *cache)
+{
+	return !!cache->metadata.lookup_index;
+}
+
+static inline bool ocf_metadata_lookup_index_ready(struct ocf_cache *cache)
+{
+	return cache->metadata.lookup_index &&
+			cache->metadata.lookup_index->ready;
+}
+
+#endif /* __METADATA_LOOKUP_INDEX_H__ */
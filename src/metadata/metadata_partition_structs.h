@@ -26,11 +26,13 @@ struct ocf_user_part_config {
 	} flags;
 	int16_t priority;
 	ocf_cache_mode_t cache_mode;
+	uint8_t dirty_high;
+	uint8_t dirty_low;
 };
 
 struct ocf_part_runtime {
 	env_atomic curr_size;
-	struct ocf_lru_part_meta lru[OCF_NUM_LRU_LISTS];
+	struct ocf_lru_part_meta lru[OCF_LRU_LISTS_MAX];
 };
 
 typedef bool ( *_lru_hash_locked_pfn)(struct ocf_request *req,
@@ -41,7 +43,7 @@ typedef bool ( *_lru_hash_locked_pfn)(struct ocf_request *req,
 struct ocf_lru_iter
 {
 	/* per-partition cacheline iterator */
-	ocf_cache_line_t curr_cline[OCF_NUM_LRU_LISTS];
+	ocf_cache_line_t curr_cline[OCF_LRU_LISTS_MAX];
 	/* cache object */
 	ocf_cache_t cache;
 	/* cacheline concurrency */
@@ -55,6 +57,8 @@ struct ocf_lru_iter
 	uint32_t num_avail_lrus;
 	/* current lru list index */
 	uint32_t lru_idx;
+	/* number of lru lists */
+	uint32_t num_lrus;
 	/* callback to determine whether given hash bucket is already
 	 * locked by the caller */
 	_lru_hash_locked_pfn hash_locked;
@@ -62,6 +66,10 @@ struct ocf_lru_iter
 	struct ocf_request *req;
 	/* 1 if iterating over clean lists, 0 if over dirty */
 	bool clean : 1;
+	/* 1 if iterator should stay on current list until it is empty */
+	bool sticky : 1;
+	/* 1 if next cacheline should be taken from current list */
+	bool stay : 1;
 };
 
 #define OCF_EVICTION_CLEAN_SIZE 32U
@@ -69,9 +77,19 @@ struct ocf_lru_iter
 struct ocf_part_cleaning_ctx {
 	ocf_cache_t cache;
 	struct ocf_refcnt counter;
+	ocf_lru_clean_end_t cmpl;
+	void *priv;
 	ocf_cache_line_t cline[OCF_EVICTION_CLEAN_SIZE];
 };
 
+/* Volatile state of dirty watermarks of user partition */
+struct ocf_part_watermark {
+	/* dirty cache lines of all cores in partition */
+	env_atomic dirty;
+	/* high watermark was reached and low one was not reached yet */
+	env_atomic urgent;
+};
+
 /* common partition data for both user-deined partitions as
  * well as freelist
  */
@@ -85,6 +103,8 @@ struct ocf_user_part {
 	struct cleaning_policy *clean_pol;
 	struct ocf_part part;
 	struct ocf_part_cleaning_ctx cleaning;
+	struct ocf_part_watermark watermark;
+	struct ocf_lru_part_stats lru_stats;
 	struct ocf_lst_entry lst_valid;
 };
 
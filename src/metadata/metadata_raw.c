@@ -10,6 +10,7 @@
 #include "metadata_raw_atomic.h"
 #include "../ocf_def_priv.h"
 #include "../ocf_priv.h"
+#include "../utils/utils_parallelize.h"
 
 #define OCF_METADATA_RAW_DEBUG 0
 
@@ -87,6 +88,77 @@ static bool _raw_ssd_page_is_valid(struct ocf_metadata_raw *raw, uint32_t page)
 		env_memcpy(_RAW_RAM_ADDR(raw, line), raw->entry_size, \
 		data, raw->entry_size)
 
+#define _RAW_RAM_MODIFIED_BITS (sizeof(unsigned long) * 8)
+
+/* Unmodified pages shorter than this are written along with neighbours */
+#define _RAW_RAM_FLUSH_MAX_GAP 4
+
+static size_t _raw_ram_modified_size(struct ocf_metadata_raw *raw)
+{
+	return OCF_DIV_ROUND_UP(raw->ssd_pages, _RAW_RAM_MODIFIED_BITS) *
+			sizeof(unsigned long);
+}
+
+static void _raw_ram_set_modified_all(struct ocf_metadata_raw *raw)
+{
+	if (!raw->modified)
+		return;
+
+	ENV_BUG_ON(env_memset(raw->modified, _raw_ram_modified_size(raw),
+			0xff));
+}
+
+static void _raw_ram_clear_modified_all(struct ocf_metadata_raw *raw)
+{
+	if (!raw->modified)
+		return;
+
+	ENV_BUG_ON(env_memset(raw->modified, _raw_ram_modified_size(raw), 0));
+}
+
+/*
+ * Find next range of modified pages starting at or after given page and clear
+ * it in modified pages bitmap. Ranges separated by short runs of unmodified
+ * pages are merged to reduce number of I/Os.
+ */
+static bool _raw_ram_next_modified(struct ocf_metadata_raw *raw,
+		uint64_t *page, uint64_t *count)
+{
+	uint64_t first = *page, last, i;
+	uint32_t step = 0;
+
+	while (first < raw->ssd_pages) {
+		if (!raw->modified[first / _RAW_RAM_MODIFIED_BITS]) {
+			first = (first / _RAW_RAM_MODIFIED_BITS + 1) *
+					_RAW_RAM_MODIFIED_BITS;
+		} else if (!env_bit_test(first, raw->modified)) {
+			first++;
+		} else {
+			break;
+		}
+		OCF_COND_RESCHED_DEFAULT(step);
+	}
+
+	if (first >= raw->ssd_pages)
+		return false;
+
+	last = first;
+	for (i = first + 1; i < raw->ssd_pages; i++) {
+		if (i - last > _RAW_RAM_FLUSH_MAX_GAP)
+			break;
+		if (env_bit_test(i, raw->modified))
+			last = i;
+	}
+
+	for (i = first; i <= last; i++)
+		env_bit_clear(i, raw->modified);
+
+	*page = first;
+	*count = last - first + 1;
+
+	return true;
+}
+
 
 
 /*
@@ -102,6 +174,9 @@ static int _raw_ram_deinit(ocf_cache_t cache,
 		raw->mem_pool = NULL;
 	}
 
+	env_vfree(raw->modified);
+	raw->modified = NULL;
+
 	ocf_mio_concurrency_deinit(&raw->mio_conc);
 
 	return 0;
@@ -139,6 +214,19 @@ static int _raw_ram_init(ocf_cache_t cache,
 	}
 	ENV_BUG_ON(env_memset(raw->mem_pool, mem_pool_size, 0));
 
+	if (raw->tracked) {
+		raw->modified = env_vzalloc(_raw_ram_modified_size(raw));
+		if (!raw->modified) {
+			env_secure_free(raw->mem_pool, raw->mem_pool_limit);
+			raw->mem_pool = NULL;
+			ocf_mio_concurrency_deinit(&raw->mio_conc);
+			return -OCF_ERR_NO_MEM;
+		}
+
+		/* Content of cache device is unknown until first load/flush */
+		_raw_ram_set_modified_all(raw);
+	}
+
 	raw->lock_page = lock_page_pfn;
 	raw->unlock_page = unlock_page_pfn;
 
@@ -172,17 +260,20 @@ static uint32_t _raw_ram_size_on_ssd(struct ocf_metadata_raw *raw)
  * RAM Implementation - Checksum
  */
 static uint32_t _raw_ram_checksum(ocf_cache_t cache,
-		struct ocf_metadata_raw *raw)
+		struct ocf_metadata_raw *raw, uint64_t page, uint64_t count,
+		uint64_t *len)
 {
 	uint64_t i;
 	uint32_t step = 0;
 	uint32_t crc = 0;
 
-	for (i = 0; i < raw->ssd_pages; i++) {
+	for (i = page; i < page + count; i++) {
 		crc = env_crc32(crc, raw->mem_pool + PAGE_SIZE * i, PAGE_SIZE);
 		OCF_COND_RESCHED(step, 10000);
 	}
 
+	*len = count * PAGE_SIZE;
+
 	return crc;
 }
 
@@ -236,8 +327,11 @@ static int _raw_ram_update(ocf_cache_t cache,
 {
 	uint64_t i;
 
-	for (i = 0; i < count; i++)
+	for (i = 0; i < count; i++) {
+		if (raw->modified)
+			env_bit_set(page + i, raw->modified);
 		_raw_ram_drain_page(cache, raw, data, page + i);
+	}
 
 	return 0;
 
@@ -280,6 +374,9 @@ static void raw_ram_zero(ocf_cache_t cache, struct ocf_metadata_raw *raw,
 	ctx->cmpl = cmpl;
 	ctx->priv = priv;
 
+	/* Zeroed pages on cache device no longer match memory */
+	_raw_ram_set_modified_all(raw);
+
 	metadata_io_write_i_asynch(cache, cache->mngt_queue, ctx,
 				raw->ssd_pages_offset,
 				_raw_ram_segment_size_on_ssd_total(raw),
@@ -312,6 +409,9 @@ static void _raw_ram_load_all_complete(ocf_cache_t cache,
 {
 	struct _raw_ram_load_all_context *context = priv;
 
+	if (!error)
+		_raw_ram_clear_modified_all(context->raw);
+
 	context->cmpl(context->priv, error);
 	env_vfree(context);
 }
@@ -338,8 +438,8 @@ static void _raw_ram_load_all(ocf_cache_t cache, struct ocf_metadata_raw *raw,
 	context->ssd_pages_offset = raw->ssd_pages_offset +
 			_raw_ram_segment_size_on_ssd(raw) * flapping_idx;
 
-	result = metadata_io_read_i_asynch(cache, cache->mngt_queue, context,
-			context->ssd_pages_offset, raw->ssd_pages, 0,
+	result = metadata_io_read_i_asynch_parallel(cache, cache->mngt_queue,
+			context, context->ssd_pages_offset, raw->ssd_pages, 0,
 			_raw_ram_load_all_drain, _raw_ram_load_all_complete);
 	if (result)
 		_raw_ram_load_all_complete(cache, context, result);
@@ -350,6 +450,8 @@ struct _raw_ram_flush_all_context {
 	uint64_t ssd_pages_offset;
 	ocf_metadata_end_t cmpl;
 	void *priv;
+	env_atomic flush_req_cnt;
+	int error;
 };
 
 /*
@@ -388,10 +490,53 @@ static void _raw_ram_flush_all_complete(ocf_cache_t cache,
 {
 	struct _raw_ram_flush_all_context *context = priv;
 
-	context->cmpl(context->priv, error);
+	if (error)
+		context->error = error;
+
+	if (env_atomic_dec_return(&context->flush_req_cnt))
+		return;
+
+	/* Pages which were not written may be stale on cache device */
+	if (context->error)
+		_raw_ram_set_modified_all(context->raw);
+
+	context->cmpl(context->priv, context->error);
 	env_vfree(context);
 }
 
+/*
+ * RAM Implementation - Flush pages modified since last load or flush
+ */
+static void _raw_ram_flush_modified(ocf_cache_t cache,
+		struct _raw_ram_flush_all_context *context)
+{
+	struct ocf_metadata_raw *raw = context->raw;
+	uint64_t page = 0, count, written = 0;
+	int result = 0;
+
+	while (_raw_ram_next_modified(raw, &page, &count)) {
+		env_atomic_inc(&context->flush_req_cnt);
+
+		result = metadata_io_write_i_asynch(cache, cache->mngt_queue,
+				context, context->ssd_pages_offset + page,
+				count, 0, _raw_ram_flush_all_fill,
+				_raw_ram_flush_all_complete, raw->mio_conc);
+		if (result) {
+			env_atomic_dec(&context->flush_req_cnt);
+			break;
+		}
+
+		page += count;
+		written += count;
+	}
+
+	OCF_DEBUG_PARAM(cache, "Flushed %llu of %llu pages",
+			(unsigned long long)written,
+			(unsigned long long)raw->ssd_pages);
+
+	_raw_ram_flush_all_complete(cache, context, result);
+}
+
 /*
  * RAM Implementation - Flush all elements
  */
@@ -412,6 +557,14 @@ static void _raw_ram_flush_all(ocf_cache_t cache, struct ocf_metadata_raw *raw,
 	context->priv = priv;
 	context->ssd_pages_offset = raw->ssd_pages_offset +
 			_raw_ram_segment_size_on_ssd(raw) * flapping_idx;
+	context->error = 0;
+	env_atomic_set(&context->flush_req_cnt, 1);
+
+	if (raw->modified) {
+		ENV_BUG_ON(raw->flapping);
+		_raw_ram_flush_modified(cache, context);
+		return;
+	}
 
 	result = metadata_io_write_i_asynch(cache, cache->mngt_queue, context,
 			context->ssd_pages_offset, raw->ssd_pages, 0,
@@ -745,3 +898,138 @@ size_t ocf_metadata_raw_size_on_ssd(struct ocf_metadata_raw* raw)
 
 	return IRAW[raw->raw_type].size_on_ssd(raw);
 }
+
+/*
+ * Segments smaller than that are not worth spreading across queues
+ */
+#define RAW_CHECKSUM_PARALLEL_MIN_PAGES 256
+
+struct _raw_checksum_shard {
+	uint32_t crc;
+	uint64_t len;
+};
+
+struct _raw_checksum_context {
+	ocf_cache_t cache;
+	struct ocf_metadata_raw *raw;
+	ocf_metadata_raw_checksum_end_t cmpl;
+	void *priv;
+	unsigned shards_cnt;
+	struct _raw_checksum_shard shards[];
+};
+
+static int _raw_checksum_handle(ocf_parallelize_t parallelize,
+		void *priv, unsigned shard_id, unsigned shards_cnt)
+{
+	struct _raw_checksum_context *context = priv;
+	struct ocf_metadata_raw *raw = context->raw;
+	struct _raw_checksum_shard *shard = &context->shards[shard_id];
+	uint64_t portion, begin, end;
+
+	portion = OCF_DIV_ROUND_UP((uint64_t)raw->ssd_pages, shards_cnt);
+	begin = OCF_MIN(portion * shard_id, raw->ssd_pages);
+	end = OCF_MIN(portion * (shard_id + 1), raw->ssd_pages);
+
+	shard->crc = raw->iface->checksum(context->cache, raw, begin,
+			end - begin, &shard->len);
+
+	return 0;
+}
+
+/*
+ * Reflected polynomial of CRC32 (IEEE 802.3) computed by env_crc32()
+ */
+#define RAW_CRC32_POLY 0xedb88320
+
+/* Product of a and b modulo CRC polynomial, a must not be zero */
+static uint32_t _raw_crc32_multmodp(uint32_t a, uint32_t b)
+{
+	uint32_t m = (uint32_t)1 << 31;
+	uint32_t p = 0;
+
+	for (;;) {
+		if (a & m) {
+			p ^= b;
+			if ((a & (m - 1)) == 0)
+				break;
+		}
+		m >>= 1;
+		b = (b & 1) ? (b >> 1) ^ RAW_CRC32_POLY : b >> 1;
+	}
+
+	return p;
+}
+
+/*
+ * Checksum of concatenation of two buffers, given checksums of both of them
+ * and length of the second one, the same way zlib crc32_combine() does
+ */
+static uint32_t _raw_crc32_combine(uint32_t crc1, uint32_t crc2, uint64_t len2)
+{
+	/* x^8 - shift by one byte */
+	uint32_t x2k = (uint32_t)1 << 23;
+	/* x^0 */
+	uint32_t p = (uint32_t)1 << 31;
+
+	for (; len2; len2 >>= 1) {
+		if (len2 & 1)
+			p = _raw_crc32_multmodp(x2k, p);
+		x2k = _raw_crc32_multmodp(x2k, x2k);
+	}
+
+	return _raw_crc32_multmodp(p, crc1) ^ crc2;
+}
+
+static void _raw_checksum_finish(ocf_parallelize_t parallelize,
+		void *priv, int error)
+{
+	struct _raw_checksum_context *context = priv;
+	ocf_metadata_raw_checksum_end_t cmpl = context->cmpl;
+	void *cmpl_priv = context->priv;
+	uint32_t crc = context->shards[0].crc;
+	unsigned i;
+
+	/* Checksums of shards are chained as if computed sequentially */
+	for (i = 1; i < context->shards_cnt; i++) {
+		crc = _raw_crc32_combine(crc, context->shards[i].crc,
+				context->shards[i].len);
+	}
+
+	ocf_parallelize_destroy(parallelize);
+
+	cmpl(cmpl_priv, error, crc);
+}
+
+void ocf_metadata_raw_checksum_parallel(ocf_cache_t cache,
+		struct ocf_metadata_raw *raw,
+		ocf_metadata_raw_checksum_end_t cmpl, void *priv)
+{
+	struct _raw_checksum_context *context;
+	ocf_parallelize_t parallelize;
+	unsigned shards_cnt;
+	int result;
+
+	shards_cnt = ocf_cache_get_queue_count(cache);
+
+	if (shards_cnt < 2 || raw->ssd_pages < RAW_CHECKSUM_PARALLEL_MIN_PAGES) {
+		cmpl(priv, 0, ocf_metadata_raw_checksum(cache, raw));
+		return;
+	}
+
+	result = ocf_parallelize_create(&parallelize, cache, shards_cnt,
+			sizeof(*context) + shards_cnt * sizeof(*context->shards),
+			_raw_checksum_handle, _raw_checksum_finish);
+	if (result) {
+		cmpl(priv, result, 0);
+		return;
+	}
+
+	context = ocf_parallelize_get_priv(parallelize);
+	context->cache = cache;
+	context->raw = raw;
+	context->cmpl = cmpl;
+	context->priv = priv;
+	context->shards_cnt = shards_cnt;
+
+	ocf_parallelize_run(parallelize);
+}
@@ -72,6 +72,8 @@ struct ocf_metadata_raw {
 	uint32_t entries_in_page; /*!< Numbers of entries in one page*/
 	uint64_t entries; /*!< Numbers of entries */
 	bool flapping; /* !< Supports flapping */
+	bool tracked; /*!< Modified pages are tracked, so that only those
+			are written on flush all */
 
 	/**
 	 * @name Location on cache device description
@@ -94,6 +96,8 @@ struct ocf_metadata_raw {
 	ocf_flush_page_synch_t unlock_page; /*!< Page unlock callback */
 
 	struct ocf_alock *mio_conc;
+
+	unsigned long *modified; /*!< Pages modified since last load/flush */
 };
 
 /**
@@ -120,8 +124,18 @@ struct raw_iface {
 	 */
 	uint32_t (*size_on_ssd)(struct ocf_metadata_raw *raw);
 
+	/**
+	 * @brief Calculate checksum of range of pages
+	 *
+	 * @param page First page of the range
+	 * @param count Number of pages in the range
+	 * @param len Number of bytes covered by the checksum
+	 *
+	 * @return Checksum of the range as if it started at the first page
+	 */
 	uint32_t (*checksum)(ocf_cache_t cache,
-			struct ocf_metadata_raw *raw);
+			struct ocf_metadata_raw *raw, uint64_t page,
+			uint64_t count, uint64_t *len);
 
 	uint32_t (*page)(struct ocf_metadata_raw *raw, uint32_t entry);
 
@@ -208,9 +222,28 @@ size_t ocf_metadata_raw_size_on_ssd(struct ocf_metadata_raw* raw);
 static inline uint32_t ocf_metadata_raw_checksum(struct ocf_cache* cache,
 		struct ocf_metadata_raw* raw)
 {
-	return raw->iface->checksum(cache, raw);
+	uint64_t len;
+
+	return raw->iface->checksum(cache, raw, 0, raw->ssd_pages, &len);
 }
 
+typedef void (*ocf_metadata_raw_checksum_end_t)(void *priv, int error,
+		uint32_t crc);
+
+/**
+ * @brief Calculate metadata checksum in parallel on all I/O queues
+ *
+ * Result is the same as of ocf_metadata_raw_checksum()
+ *
+ * @param cache - Cache instance
+ * @param raw - RAW descriptor
+ * @param cmpl - Completion callback
+ * @param priv - Completion context
+ */
+void ocf_metadata_raw_checksum_parallel(ocf_cache_t cache,
+		struct ocf_metadata_raw *raw,
+		ocf_metadata_raw_checksum_end_t cmpl, void *priv);
+
 /**
  * @brief Calculate entry page index
  *
@@ -224,6 +257,26 @@ static inline uint32_t ocf_metadata_raw_page(struct ocf_metadata_raw* raw,
 	return raw->iface->page(raw, entry);
 }
 
+/**
+ * @brief Mark page containing given entry as modified
+ *
+ * @param raw - RAW descriptor
+ * @param entry - Entry which is about to be modified
+ */
+static inline void ocf_metadata_raw_set_modified(struct ocf_metadata_raw *raw,
+		uint32_t entry)
+{
+	uint32_t page;
+
+	if (!raw->modified)
+		return;
+
+	/* Test first to avoid atomic operation on hot path */
+	page = entry / raw->entries_in_page;
+	if (!env_bit_test(page, raw->modified))
+		env_bit_set(page, raw->modified);
+}
+
 /**
  * @brief Access specified element of metadata directly
  *
@@ -236,6 +289,8 @@ static inline uint32_t ocf_metadata_raw_page(struct ocf_metadata_raw* raw,
 static inline void *ocf_metadata_raw_wr_access(ocf_cache_t cache,
 		struct ocf_metadata_raw *raw, uint32_t entry)
 {
+	ocf_metadata_raw_set_modified(raw, entry);
+
 	return raw->iface->access(cache, raw, entry);
 }
 
@@ -232,16 +232,21 @@ uint32_t raw_dynamic_size_on_ssd(struct ocf_metadata_raw *raw)
  * RAM DYNAMIC Implementation - Checksum
  */
 uint32_t raw_dynamic_checksum(ocf_cache_t cache,
-		struct ocf_metadata_raw *raw)
+		struct ocf_metadata_raw *raw, uint64_t page, uint64_t count,
+		uint64_t *len)
 {
 	struct _raw_ctrl *ctrl = (struct _raw_ctrl *)raw->priv;
 	uint64_t i;
 	uint32_t step = 0;
 	uint32_t crc = 0;
 
-	for (i = 0; i < raw->ssd_pages; i++) {
-		if (ctrl->pages[i])
+	*len = 0;
+
+	for (i = page; i < page + count; i++) {
+		if (ctrl->pages[i]) {
 			crc = env_crc32(crc, ctrl->pages[i], PAGE_SIZE);
+			*len += PAGE_SIZE;
+		}
 		OCF_COND_RESCHED(step, 10000);
 	}
 
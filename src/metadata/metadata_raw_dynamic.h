@@ -40,7 +40,8 @@ uint32_t raw_dynamic_size_on_ssd(struct ocf_metadata_raw *raw);
  * RAW DYNAMIC Implementation - Checksum
  */
 uint32_t raw_dynamic_checksum(ocf_cache_t cache,
-		struct ocf_metadata_raw *raw);
+		struct ocf_metadata_raw *raw, uint64_t page, uint64_t count,
+		uint64_t *len);
 
 /*
  * RAM DYNAMIC Implementation - Entry page number
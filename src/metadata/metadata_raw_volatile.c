@@ -21,8 +21,11 @@ uint32_t raw_volatile_size_on_ssd(struct ocf_metadata_raw *raw)
  * RAW volatile Implementation - Checksum
  */
 uint32_t raw_volatile_checksum(ocf_cache_t cache,
-		struct ocf_metadata_raw *raw)
+		struct ocf_metadata_raw *raw, uint64_t page, uint64_t count,
+		uint64_t *len)
 {
+	*len = 0;
+
 	return 0;
 }
 
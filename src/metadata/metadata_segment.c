@@ -71,27 +71,22 @@ static void ocf_metadata_generic_complete(void *priv, int error)
 	OCF_PL_NEXT_ON_SUCCESS_RET(context->pipeline, error);
 }
 
-void ocf_metadata_check_crc(ocf_pipeline_t pipeline,
-		void *priv, ocf_pipeline_arg_t arg)
+static int _ocf_metadata_check_crc(ocf_cache_t cache,
+		struct ocf_metadata_segment *segment, int segment_id,
+		uint32_t crc)
 {
-	struct ocf_metadata_context *context = priv;
-	int segment_id = ocf_pipeline_arg_get_int(arg);
-	struct ocf_metadata_segment *segment = context->ctrl->segment[segment_id];
-	ocf_cache_t cache = context->cache;
-	uint32_t crc;
 	uint32_t superblock_crc;
 
-	crc = ocf_metadata_raw_checksum(cache, segment->raw);
 	superblock_crc = ocf_metadata_superblock_get_checksum(segment->superblock,
 			segment_id);
 	if (crc != superblock_crc) {
 		ocf_cache_log(cache, log_err,
 				"Loading %s ERROR, invalid checksum\n",
 				ocf_metadata_segment_names[segment_id]);
-		OCF_PL_FINISH_RET(pipeline, -OCF_ERR_CRC_MISMATCH);
+		return -OCF_ERR_CRC_MISMATCH;
 	}
 
-	ocf_pipeline_next(pipeline);
+	return 0;
 }
 
 void ocf_metadata_calculate_crc(ocf_pipeline_t pipeline,
@@ -140,3 +135,112 @@ void ocf_metadata_load_segment(ocf_pipeline_t pipeline,
 	ocf_metadata_raw_load_all(cache, segment->raw,
 			ocf_metadata_generic_complete, context, flapping_idx);
 }
+
+struct ocf_metadata_load_segments_context;
+
+struct ocf_metadata_load_segments_entry {
+	struct ocf_metadata_load_segments_context *parent;
+	int segment_id;
+};
+
+struct ocf_metadata_load_segments_context {
+	struct ocf_metadata_context *context;
+	env_atomic remaining;
+	env_atomic error;
+	struct ocf_metadata_load_segments_entry entries[metadata_segment_max];
+};
+
+static void ocf_metadata_load_segments_put(
+		struct ocf_metadata_load_segments_context *ctx)
+{
+	ocf_pipeline_t pipeline = ctx->context->pipeline;
+	int error;
+
+	if (env_atomic_dec_return(&ctx->remaining))
+		return;
+
+	error = env_atomic_read(&ctx->error);
+	env_vfree(ctx);
+
+	OCF_PL_NEXT_ON_SUCCESS_RET(pipeline, error);
+}
+
+static void ocf_metadata_load_segments_check_crc(void *priv, int error,
+		uint32_t crc)
+{
+	struct ocf_metadata_load_segments_entry *entry = priv;
+	struct ocf_metadata_load_segments_context *ctx = entry->parent;
+	struct ocf_metadata_context *context = ctx->context;
+
+	if (!error) {
+		error = _ocf_metadata_check_crc(context->cache,
+				context->ctrl->segment[entry->segment_id],
+				entry->segment_id, crc);
+	}
+
+	env_atomic_cmpxchg(&ctx->error, 0, error);
+
+	ocf_metadata_load_segments_put(ctx);
+}
+
+static void ocf_metadata_load_segments_complete(void *priv, int error)
+{
+	struct ocf_metadata_load_segments_entry *entry = priv;
+	struct ocf_metadata_load_segments_context *ctx = entry->parent;
+	struct ocf_metadata_context *context = ctx->context;
+
+	if (error) {
+		env_atomic_cmpxchg(&ctx->error, 0, error);
+		ocf_metadata_load_segments_put(ctx);
+		return;
+	}
+
+	/* Verify segment as soon as it is read, while the others are still
+	 * being loaded */
+	ocf_metadata_raw_checksum_parallel(context->cache,
+			context->ctrl->segment[entry->segment_id]->raw,
+			ocf_metadata_load_segments_check_crc, entry);
+}
+
+/*
+ * Load all segments given in terminated array of int pipeline args at once
+ * and check their checksums
+ */
+void ocf_metadata_load_segments(ocf_pipeline_t pipeline,
+		void *priv, ocf_pipeline_arg_t arg)
+{
+	struct ocf_metadata_context *context = priv;
+	ocf_pipeline_arg_t args = ocf_pipeline_arg_get_ptr(arg);
+	struct ocf_metadata_load_segments_context *ctx;
+	struct ocf_metadata_load_segments_entry *entry;
+	struct ocf_metadata_segment *segment;
+	unsigned flapping_idx;
+	int segment_id;
+
+	ctx = env_vzalloc(sizeof(*ctx));
+	if (!ctx)
+		OCF_PL_FINISH_RET(pipeline, -OCF_ERR_NO_MEM);
+
+	ctx->context = context;
+	env_atomic_set(&ctx->remaining, 1);
+
+	for (; args->type != ocf_pipeline_arg_terminator; args++) {
+		segment_id = ocf_pipeline_arg_get_int(args);
+		segment = context->ctrl->segment[segment_id];
+		entry = &ctx->entries[segment_id];
+
+		entry->parent = ctx;
+		entry->segment_id = segment_id;
+
+		flapping_idx = ocf_metadata_superblock_get_flapping_idx(
+				segment->superblock);
+		flapping_idx = segment->raw->flapping ? flapping_idx : 0;
+
+		env_atomic_inc(&ctx->remaining);
+		ocf_metadata_raw_load_all(context->cache, segment->raw,
+				ocf_metadata_load_segments_complete, entry,
+				flapping_idx);
+	}
+
+	ocf_metadata_load_segments_put(ctx);
+}
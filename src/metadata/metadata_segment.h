@@ -27,9 +27,6 @@ int ocf_metadata_segment_init(
 void ocf_metadata_segment_destroy(struct ocf_cache *cache,
 		struct ocf_metadata_segment *self);
 
-void ocf_metadata_check_crc(ocf_pipeline_t pipeline,
-		void *priv, ocf_pipeline_arg_t arg);
-
 void ocf_metadata_calculate_crc(ocf_pipeline_t pipeline,
 		void *priv, ocf_pipeline_arg_t arg);
 
@@ -39,4 +36,7 @@ void ocf_metadata_flush_segment(ocf_pipeline_t pipeline,
 void ocf_metadata_load_segment(ocf_pipeline_t pipeline,
 		void *priv, ocf_pipeline_arg_t arg);
 
+void ocf_metadata_load_segments(ocf_pipeline_t pipeline,
+		void *priv, ocf_pipeline_arg_t arg);
+
 #endif
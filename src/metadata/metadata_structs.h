@@ -36,24 +36,44 @@ enum ocf_metadata_shutdown_status {
 typedef void (*ocf_metadata_query_cores_end_t)(void *priv, int error,
 		unsigned int num_cores);
 
-#define OCF_METADATA_GLOBAL_LOCK_IDX_BITS 2
-#define OCF_NUM_GLOBAL_META_LOCKS (1 << (OCF_METADATA_GLOBAL_LOCK_IDX_BITS))
+#define OCF_METADATA_GLOBAL_LOCK_IDX_BITS 6
+
+struct ocf_metadata_lock_stats {
+	env_atomic64 acquisitions;
+	env_atomic64 contended;
+		/*!< Acquisitions which had to wait for the lock */
+	env_atomic64 wait_ns;
+};
 
 struct ocf_metadata_global_lock {
 	env_rwsem sem;
+	struct ocf_metadata_lock_stats stats;
+	struct ocf_metadata_lock_stats hash_stats;
+		/*!< Stats of hash bucket locks with index congruent to index
+		 * of this global lock modulo number of global locks */
+	env_atomic64 optimistic_reads;
+		/*!< Optimistic hash bucket reads validated successfully */
+	env_atomic64 optimistic_retries;
+		/*!< Optimistic hash bucket reads which failed validation */
 } __attribute__((aligned(64)));
 
 struct ocf_metadata_lock
 {
-	struct ocf_metadata_global_lock global[OCF_NUM_GLOBAL_META_LOCKS];
+	struct ocf_metadata_global_lock global[OCF_METADATA_GLOBAL_LOCKS_MAX];
 			/*!< global metadata lock (GML) */
-	env_rwlock lru[OCF_NUM_LRU_LISTS]; /*!< Fast locks for lru list */
+	env_rwlock lru[OCF_LRU_LISTS_MAX]; /*!< Fast locks for lru list */
 	env_spinlock partition[OCF_USER_IO_CLASS_MAX]; /* partition lock */
 	env_rwsem *hash; /*!< Hash bucket locks */
+	env_atomic *hash_seq; /*!< Hash bucket lock sequence numbers */
 	env_rwsem *collision_pages; /*!< Collision table page locks */
 	ocf_cache_t cache;  /*!< Parent cache object */
+	uint32_t num_global_locks; /*!< Global metadata lock shard count */
 	uint32_t num_hash_entries;  /*!< Hash bucket count */
+	uint32_t num_hash_locks; /*!< Hash bucket lock count */
+	uint32_t hash_lock_shift;
+		/*!< Log2 of number of hash buckets per hash bucket lock */
 	uint32_t num_collision_pages; /*!< Collision table page count */
+	bool stats_enabled; /*!< Collect lock contention stats */
 };
 
 /**
@@ -66,10 +86,26 @@ struct ocf_metadata {
 	ocf_cache_line_size_t line_size;
 		/*!< Cache line size */
 
+	bool compact;
+		/*!< true if per cache line metadata uses compact layout */
+
 	bool is_volatile;
 		/*!< true if metadata used in volatile mode (RAM only) */
 
 	struct ocf_metadata_lock lock;
+
+	uint32_t io_depth;
+		/*!< Metadata I/O requests in flight per segment */
+
+	struct ocf_lookup_index *lookup_index;
+		/*!< Optional volatile index of collision table */
+
+	struct ocf_request *lazy_load_req;
+		/*!< Background population of volatile indexes after lazy
+		 * load */
+
+	env_atomic lazy_load_pending;
+		/*!< Volatile indexes are being populated in background */
 };
 
 #endif /* __METADATA_STRUCTS_H__ */
@@ -196,6 +196,19 @@ int ocf_metadata_validate_superblock(ocf_ctx_t ctx,
 		return -OCF_ERR_INVAL;
 	}
 
+	if (superblock->replacement_policy_type < 0 ||
+			superblock->replacement_policy_type >=
+					ocf_replacement_max) {
+		ocf_log_invalid_superblock("replacement policy");
+		return -OCF_ERR_INVAL;
+	}
+
+	if (superblock->lru_lists < OCF_LRU_LISTS_MIN ||
+			superblock->lru_lists > OCF_LRU_LISTS_MAX) {
+		ocf_log_invalid_superblock("lru lists");
+		return -OCF_ERR_INVAL;
+	}
+
 	return 0;
 }
 
@@ -324,9 +337,7 @@ struct ocf_pipeline_properties ocf_metadata_load_sb_pipeline_props = {
 		OCF_PL_STEP_ARG_INT(ocf_metadata_load_segment,
 				metadata_segment_sb_config),
 		OCF_PL_STEP(_ocf_metadata_validate_superblock),
-		OCF_PL_STEP_FOREACH(ocf_metadata_load_segment,
-				ocf_metadata_load_sb_load_segment_args),
-		OCF_PL_STEP_FOREACH(ocf_metadata_check_crc,
+		OCF_PL_STEP_ARG_PTR(ocf_metadata_load_segments,
 				ocf_metadata_load_sb_load_segment_args),
 		OCF_PL_STEP(_ocf_metadata_validate_core_config),
 		OCF_PL_STEP_TERMINATOR(),
@@ -390,9 +401,7 @@ struct ocf_pipeline_properties ocf_metadata_load_sb_recov_pipeline_props = {
 		OCF_PL_STEP_ARG_INT(ocf_metadata_load_segment,
 				metadata_segment_sb_config),
 		OCF_PL_STEP(_ocf_metadata_validate_superblock),
-		OCF_PL_STEP_FOREACH(ocf_metadata_load_segment,
-				ocf_metadata_load_sb_recov_load_segment_args),
-		OCF_PL_STEP_FOREACH(ocf_metadata_check_crc,
+		OCF_PL_STEP_ARG_PTR(ocf_metadata_load_segments,
 				ocf_metadata_load_sb_recov_load_segment_args),
 		OCF_PL_STEP(_ocf_metadata_validate_core_config),
 		OCF_PL_STEP_TERMINATOR(),
@@ -52,6 +52,12 @@ struct ocf_superblock_config {
 	ocf_promotion_t promotion_policy_type;
 	struct promotion_policy_config promotion[PROMOTION_POLICY_TYPE_MAX];
 
+	ocf_replacement_t replacement_policy_type;
+
+	uint32_t lru_lists;
+
+	bool compact_metadata;
+
 	/*
 	 * Checksum for each metadata region.
 	 * This field has to be the last one!
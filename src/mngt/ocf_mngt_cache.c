@@ -81,6 +81,10 @@ struct ocf_cache_mngt_init_params {
 		/*!< cache mode */
 
 		ocf_promotion_t promotion_policy;
+
+		ocf_replacement_t replacement_policy;
+
+		uint32_t lru_lists;
 	} metadata;
 };
 
@@ -131,6 +135,9 @@ struct ocf_cache_attach_context {
 		bool promotion_initialized : 1;
 			/*!< Promotion policy has been started */
 
+		bool replacement_initialized : 1;
+			/*!< Replacement policy has been started */
+
 		bool cleaning_initialized : 1;
 			/*!< Cleaning policy has been initialized */
 
@@ -165,6 +172,12 @@ struct ocf_cache_attach_context {
 
 		bool cleaner_disabled;
 		/*!< is cleaner disabled */
+
+		bool lazy_load;
+		/*!< volatile indexes are populated after cache goes online */
+
+		bool compact;
+		/*!< compact layout of per cache line metadata */
 	} metadata;
 
 	struct {
@@ -379,6 +392,7 @@ static void _ocf_mngt_deinit_added_cores(
 		if (core->seq_cutoff)
 			ocf_core_seq_cutoff_deinit(core);
 
+		ocf_metadata_dirty_index_core_deinit(core);
 		env_free(core->counters);
 		core->counters = NULL;
 		core->added = false;
@@ -465,6 +479,9 @@ static void _ocf_mngt_load_add_cores(ocf_pipeline_t pipeline,
 		if (ret < 0)
 			goto err;
 
+		ENV_BUG_ON(env_memset(&core->flush, sizeof(core->flush), 0));
+		core->flush.queue_depth = OCF_FLUSH_QUEUE_DEPTH_DEFAULT;
+
 		if (!core->opened) {
 			env_bit_set(ocf_cache_state_incomplete,
 					&cache->cache_state);
@@ -504,12 +521,12 @@ err:
 typedef void (*ocf_mngt_rebuild_metadata_end_t)(void *priv, int error);
 
 /*
- * IMPORTANT: This value must match number of LRU lists so that adding
+ * IMPORTANT: Number of shards must match number of LRU lists so that adding
  * cache lines to the list can be implemented without locking (each shard
  * owns it's own LRU list). Don't change this value unless you are really
  * sure you know what you're doing.
  */
-#define OCF_MNGT_REBUILD_METADATA_SHARDS_CNT OCF_NUM_LRU_LISTS
+#define OCF_MNGT_REBUILD_METADATA_SHARDS_MAX OCF_LRU_LISTS_MAX
 
 struct ocf_mngt_rebuild_metadata_context {
 	ocf_cache_t cache;
@@ -522,7 +539,7 @@ struct ocf_mngt_rebuild_metadata_context {
 		struct {
 			uint32_t lines;
 		} core[OCF_CORE_MAX];
-	} shard[OCF_MNGT_REBUILD_METADATA_SHARDS_CNT];
+	} shard[OCF_MNGT_REBUILD_METADATA_SHARDS_MAX];
 
 	env_atomic free_lines;
 
@@ -670,8 +687,7 @@ static void ocf_mngt_rebuild_metadata(ocf_cache_t cache,
 	ocf_parallelize_t parallelize;
 	int result;
 
-	result = ocf_parallelize_create(&parallelize, cache,
-			OCF_MNGT_REBUILD_METADATA_SHARDS_CNT,
+	result = ocf_parallelize_create(&parallelize, cache, cache->lru_lists,
 			sizeof(*context), ocf_mngt_rebuild_metadata_handle,
 			ocf_mngt_rebuild_metadata_finish);
         if (result) {
@@ -710,6 +726,58 @@ static void _ocf_mngt_load_rebuild_metadata(ocf_pipeline_t pipeline,
 	ocf_pipeline_next(pipeline);
 }
 
+static void _ocf_mngt_load_init_lookup_index_complete(void *priv, int error)
+{
+	struct ocf_cache_attach_context *context = priv;
+
+	OCF_PL_NEXT_ON_SUCCESS_RET(context->pipeline, error);
+}
+
+static void _ocf_mngt_load_init_lookup_index(ocf_pipeline_t pipeline,
+		void *priv, ocf_pipeline_arg_t arg)
+{
+	struct ocf_cache_attach_context *context = priv;
+	ocf_cache_t cache = context->cache;
+
+	/* After recovery lookup index is filled while rebuilding collision */
+	if (context->metadata.shutdown_status != ocf_metadata_clean_shutdown)
+		OCF_PL_NEXT_RET(pipeline);
+
+	/* On lazy load it is filled in background after cache goes online */
+	if (context->metadata.lazy_load)
+		OCF_PL_NEXT_RET(pipeline);
+
+	ocf_metadata_lookup_index_populate(cache,
+			_ocf_mngt_load_init_lookup_index_complete, context);
+}
+
+static void _ocf_mngt_init_dirty_index_complete(void *priv, int error)
+{
+	struct ocf_cache_attach_context *context = priv;
+
+	if (error) {
+		ocf_cache_log(context->cache, log_err,
+				"Cannot initialize dirty index\n");
+	}
+
+	OCF_PL_NEXT_ON_SUCCESS_RET(context->pipeline, error);
+}
+
+static void _ocf_mngt_init_dirty_index(ocf_pipeline_t pipeline,
+		void *priv, ocf_pipeline_arg_t arg)
+{
+	struct ocf_cache_attach_context *context = priv;
+
+	ocf_user_part_dirty_init(context->cache);
+
+	/* On lazy load it is filled in background after cache goes online */
+	if (context->metadata.lazy_load)
+		OCF_PL_NEXT_RET(pipeline);
+
+	ocf_metadata_dirty_index_populate(context->cache,
+			_ocf_mngt_init_dirty_index_complete, context);
+}
+
 static void _ocf_mngt_cleaning_populate_complete(void *priv, int error)
 {
 	struct ocf_cache_attach_context *context = priv;
@@ -848,6 +916,15 @@ static int _ocf_mngt_init_new_cache(struct ocf_cache_mngt_init_params *params)
 		goto lock_err;
 	}
 
+	if (env_spinlock_init(&cache->cleaner.pipeline.lock)) {
+		result = -OCF_ERR_NO_MEM;
+		goto flush_mutex_err;
+	}
+
+	INIT_LIST_HEAD(&cache->cleaner.pipeline.waiting);
+	cache->cleaner.pipeline.budget =
+			(uint64_t)OCF_CLEANER_MEMORY_BUDGET_DEFAULT * MiB;
+
 	ENV_BUG_ON(!ocf_refcnt_inc(&cache->refcnt.cache));
 
 	/* start with freezed metadata ref counter to indicate detached device*/
@@ -863,6 +940,8 @@ static int _ocf_mngt_init_new_cache(struct ocf_cache_mngt_init_params *params)
 
 	return 0;
 
+flush_mutex_err:
+	env_mutex_destroy(&cache->flush_mutex);
 lock_err:
 	ocf_mngt_cache_lock_deinit(cache);
 alloc_err:
@@ -948,6 +1027,14 @@ static int _ocf_mngt_init_prepare_cache(struct ocf_cache_mngt_init_params *param
 
 	cache->pt_unaligned_io = cfg->pt_unaligned_io;
 	cache->use_submit_io_fast = cfg->use_submit_io_fast;
+	cache->use_lookup_index = cfg->use_lookup_index;
+	cache->lru_queue_affinity = cfg->lru_queue_affinity;
+
+	cache->metadata.lock.num_global_locks = cfg->metadata_global_locks;
+	cache->metadata.lock.hash_lock_shift =
+			__builtin_ctz(cfg->hash_buckets_per_lock);
+	cache->metadata.lock.stats_enabled = cfg->metadata_lock_stats;
+	cache->metadata.io_depth = cfg->metadata_io_depth;
 
 	cache->metadata.is_volatile = cfg->metadata_volatile;
 
@@ -1196,6 +1283,9 @@ static void _ocf_mngt_load_read_properties_end(void *priv, int error,
 	context->metadata.dirty_flushed = properties->dirty_flushed;
 	context->metadata.line_size = properties->line_size;
 	context->metadata.cleaner_disabled = properties->cleaner_disabled;
+	context->metadata.compact = properties->compact_metadata;
+	context->metadata.lazy_load = context->cfg.lazy_load &&
+		properties->shutdown_status == ocf_metadata_clean_shutdown;
 	cache->conf_meta->cache_mode = properties->cache_mode;
 
 	ocf_pipeline_next(context->pipeline);
@@ -1214,6 +1304,7 @@ static void _ocf_mngt_init_properties(ocf_pipeline_t pipeline,
 	context->metadata.line_size = context->cfg.cache_line_size ?:
 			cache->metadata.line_size;
 	context->metadata.cleaner_disabled = context->cfg.disable_cleaner;
+	context->metadata.compact = context->cfg.compact_metadata;
 
 	ocf_pipeline_next(pipeline);
 }
@@ -1246,6 +1337,8 @@ static void _ocf_mngt_attach_prepare_metadata(ocf_pipeline_t pipeline,
 {
 	struct ocf_cache_attach_context *context = priv;
 	ocf_cache_t cache = context->cache;
+	ocf_core_id_t core_id;
+	ocf_core_t core;
 	int ret;
 
 	/*
@@ -1253,12 +1346,23 @@ static void _ocf_mngt_attach_prepare_metadata(ocf_pipeline_t pipeline,
 	 */
 	ret = ocf_metadata_init_variable_size(cache, context->volume_size,
 			context->metadata.line_size,
-			context->metadata.cleaner_disabled);
+			context->metadata.cleaner_disabled,
+			context->metadata.compact);
 	if (ret)
 		OCF_PL_FINISH_RET(pipeline, ret);
 
 	context->flags.attached_metadata_inited = true;
 
+	/* Cores added while cache was detached */
+	for_each_core(cache, core, core_id) {
+		if (!ocf_metadata_core_length_supported(cache,
+				core->conf_meta->length)) {
+			ocf_core_log(core, log_err, "Core is too big for "
+					"compact metadata\n");
+			OCF_PL_FINISH_RET(pipeline, -OCF_ERR_CORE_TOO_BIG);
+		}
+	}
+
 	ret = ocf_concurrency_init(cache);
 	if (ret)
 		OCF_PL_FINISH_RET(pipeline, ret);
@@ -1413,6 +1517,10 @@ int ocf_mngt_get_ram_needed(ocf_cache_t cache,
 	line_size = ocf_line_size(cache);
 	volume_size = ocf_volume_get_length(cfg->volume);
 	*ram_needed = _ocf_mngt_calculate_ram_needed(line_size, volume_size);
+	if (cache->use_lookup_index) {
+		*ram_needed += ocf_metadata_lookup_index_size(
+				volume_size / line_size);
+	}
 
 	ocf_volume_close(cfg->volume);
 
@@ -1457,6 +1565,10 @@ static void _ocf_mngt_cache_init(ocf_cache_t cache,
 	 */
 	cache->conf_meta->cache_mode = params->metadata.cache_mode;
 	cache->conf_meta->promotion_policy_type = params->metadata.promotion_policy;
+	cache->conf_meta->replacement_policy_type =
+			params->metadata.replacement_policy;
+	cache->conf_meta->lru_lists = params->metadata.lru_lists;
+	cache->lru_lists = params->metadata.lru_lists;
 	__set_cleaning_policy(cache, ocf_cleaning_default);
 
 	INIT_LIST_HEAD(&cache->io_queues);
@@ -1484,6 +1596,8 @@ static int _ocf_mngt_cache_start(ocf_ctx_t ctx, ocf_cache_t *cache,
 	params.metadata.line_size = cfg->cache_line_size;
 	params.metadata_volatile = cfg->metadata_volatile;
 	params.metadata.promotion_policy = cfg->promotion_policy;
+	params.metadata.replacement_policy = cfg->replacement_policy;
+	params.metadata.lru_lists = cfg->lru_lists;
 	params.locked = cfg->locked;
 
 	result = env_rmutex_lock_interruptible(&ctx->lock);
@@ -1596,6 +1710,10 @@ static void _ocf_mngt_attach_check_ram(ocf_pipeline_t pipeline,
 	uint64_t free_ram;
 
 	min_free_ram = _ocf_mngt_calculate_ram_needed(line_size, volume_size);
+	if (cache->use_lookup_index) {
+		min_free_ram += ocf_metadata_lookup_index_size(
+				volume_size / line_size);
+	}
 
 	free_ram = env_get_free_memory();
 
@@ -1618,6 +1736,8 @@ static void _ocf_mngt_load_superblock_complete(void *priv, int error)
 	struct ocf_cache_attach_context *context = priv;
 	ocf_cache_t cache = context->cache;
 	ocf_cleaning_t loaded_clean_policy = cache->conf_meta->cleaning_policy_type;
+	ocf_replacement_t loaded_replacement_policy =
+			cache->conf_meta->replacement_policy_type;
 
 	if (error) {
 		ocf_cache_log(cache, log_err,
@@ -1633,6 +1753,13 @@ static void _ocf_mngt_load_superblock_complete(void *priv, int error)
 				-OCF_ERR_START_CACHE_FAIL);
 	}
 
+	if (cache->conf_meta->compact_metadata != cache->metadata.compact) {
+		ocf_cache_log(cache, log_err,
+				"ERROR: Metadata layout mismatch!\n");
+		OCF_PL_FINISH_RET(context->pipeline,
+				-OCF_ERR_SUPERBLOCK_MISMATCH);
+	}
+
 	if (loaded_clean_policy >= ocf_cleaning_max) {
 		ocf_cache_log(cache, log_err,
 				"ERROR: Invalid cleaning policy!\n");
@@ -1640,8 +1767,25 @@ static void _ocf_mngt_load_superblock_complete(void *priv, int error)
 				-OCF_ERR_START_CACHE_FAIL);
 	}
 
+	if (loaded_replacement_policy >= ocf_replacement_max) {
+		ocf_cache_log(cache, log_err,
+				"ERROR: Invalid replacement policy!\n");
+		OCF_PL_FINISH_RET(context->pipeline,
+				-OCF_ERR_START_CACHE_FAIL);
+	}
+
+	if (cache->conf_meta->lru_lists < OCF_LRU_LISTS_MIN ||
+			cache->conf_meta->lru_lists > OCF_LRU_LISTS_MAX) {
+		ocf_cache_log(cache, log_err,
+				"ERROR: Invalid number of LRU lists!\n");
+		OCF_PL_FINISH_RET(context->pipeline,
+				-OCF_ERR_START_CACHE_FAIL);
+	}
+
 	__set_cleaning_policy(cache, loaded_clean_policy);
 
+	cache->lru_lists = cache->conf_meta->lru_lists;
+
 	ocf_pipeline_next(context->pipeline);
 }
 
@@ -1697,6 +1841,24 @@ static void _ocf_mngt_init_promotion(ocf_pipeline_t pipeline,
 	ocf_pipeline_next(pipeline);
 }
 
+static void _ocf_mngt_init_replacement(ocf_pipeline_t pipeline,
+		void *priv, ocf_pipeline_arg_t arg)
+{
+	struct ocf_cache_attach_context *context = priv;
+	ocf_cache_t cache = context->cache;
+	int result;
+
+	result = ocf_lru_ghost_init(cache);
+	if (result) {
+		ocf_cache_log(cache, log_err,
+				"Cannot initialize replacement policy\n");
+		OCF_PL_FINISH_RET(pipeline, result);
+	}
+	context->flags.replacement_initialized = true;
+
+	ocf_pipeline_next(pipeline);
+}
+
 static void _ocf_mngt_zero_superblock_complete(void *priv, int error)
 {
 	struct ocf_cache_attach_context *context = priv;
@@ -1838,6 +2000,36 @@ static void _ocf_mngt_attach_shutdown_status(ocf_pipeline_t pipeline,
 		_ocf_mngt_attach_shutdown_status_complete, context);
 }
 
+static void _ocf_mngt_load_lazy_prepare(ocf_pipeline_t pipeline,
+		void *priv, ocf_pipeline_arg_t arg)
+{
+	struct ocf_cache_attach_context *context = priv;
+	int result;
+
+	if (!context->metadata.lazy_load)
+		OCF_PL_NEXT_RET(pipeline);
+
+	result = ocf_metadata_lazy_load_prepare(context->cache);
+	if (result) {
+		ocf_cache_log(context->cache, log_err,
+				"Cannot prepare lazy metadata load\n");
+		OCF_PL_FINISH_RET(pipeline, result);
+	}
+
+	ocf_pipeline_next(pipeline);
+}
+
+static void _ocf_mngt_load_lazy_start(ocf_pipeline_t pipeline,
+		void *priv, ocf_pipeline_arg_t arg)
+{
+	struct ocf_cache_attach_context *context = priv;
+
+	if (context->metadata.lazy_load)
+		ocf_metadata_lazy_load_start(context->cache);
+
+	ocf_pipeline_next(pipeline);
+}
+
 static void _ocf_mngt_attach_post_init(ocf_pipeline_t pipeline,
 		void *priv, ocf_pipeline_arg_t arg)
 {
@@ -1863,6 +2055,9 @@ static void _ocf_mngt_attach_handle_error(
 	if (context->flags.promotion_initialized)
 		__deinit_promotion_policy(cache);
 
+	if (context->flags.replacement_initialized)
+		ocf_lru_ghost_deinit(cache);
+
 	if (context->flags.cleaning_initialized)
 		__deinit_cleaning_policy(cache);
 
@@ -1929,8 +2124,10 @@ struct ocf_pipeline_properties _ocf_mngt_cache_attach_pipeline_properties = {
 		OCF_PL_STEP(_ocf_mngt_test_volume),
 		OCF_PL_STEP(_ocf_mngt_init_cleaner),
 		OCF_PL_STEP(_ocf_mngt_init_promotion),
+		OCF_PL_STEP(_ocf_mngt_init_replacement),
 		OCF_PL_STEP(_ocf_mngt_attach_init_metadata),
 		OCF_PL_STEP(_ocf_mngt_attach_populate_free),
+		OCF_PL_STEP(_ocf_mngt_init_dirty_index),
 		OCF_PL_STEP(_ocf_mngt_attach_init_services),
 		OCF_PL_STEP(_ocf_mngt_zero_superblock),
 		OCF_PL_STEP(_ocf_mngt_attach_flush_metadata),
@@ -1956,15 +2153,20 @@ struct ocf_pipeline_properties _ocf_mngt_cache_load_pipeline_properties = {
 		OCF_PL_STEP(_ocf_mngt_load_superblock),
 		OCF_PL_STEP(_ocf_mngt_init_cleaner),
 		OCF_PL_STEP(_ocf_mngt_init_promotion),
+		OCF_PL_STEP(_ocf_mngt_init_replacement),
 		OCF_PL_STEP(_ocf_mngt_load_add_cores),
 		OCF_PL_STEP(_ocf_mngt_load_init_structures),
 		OCF_PL_STEP(_ocf_mngt_load_metadata),
 		OCF_PL_STEP(_ocf_mngt_load_rebuild_metadata),
+		OCF_PL_STEP(_ocf_mngt_load_init_lookup_index),
+		OCF_PL_STEP(_ocf_mngt_init_dirty_index),
 		OCF_PL_STEP(_ocf_mngt_load_init_cleaning),
 		OCF_PL_STEP(_ocf_mngt_attach_shutdown_status),
 		OCF_PL_STEP(_ocf_mngt_attach_flush_metadata),
 		OCF_PL_STEP(_ocf_mngt_attach_shutdown_status),
+		OCF_PL_STEP(_ocf_mngt_load_lazy_prepare),
 		OCF_PL_STEP(_ocf_mngt_attach_post_init),
+		OCF_PL_STEP(_ocf_mngt_load_lazy_start),
 		OCF_PL_STEP_TERMINATOR(),
 	},
 };
@@ -2154,6 +2356,7 @@ static void ocf_mngt_cache_remove(ocf_ctx_t ctx, ocf_cache_t cache)
 	/* Deinitialize locks */
 	ocf_mngt_cache_lock_deinit(cache);
 	env_mutex_destroy(&cache->flush_mutex);
+	env_spinlock_destroy(&cache->cleaner.pipeline.lock);
 
 	/* Remove cache from the list */
 	env_rmutex_lock(&ctx->lock);
@@ -2274,6 +2477,7 @@ static void _ocf_mngt_standby_init_properties(ocf_pipeline_t pipeline,
 	context->metadata.line_size = context->cfg.cache_line_size ?:
 			cache->metadata.line_size;
 	context->metadata.cleaner_disabled = context->cfg.disable_cleaner;
+	context->metadata.compact = context->cfg.compact_metadata;
 
 	ocf_pipeline_next(pipeline);
 }
@@ -2454,6 +2658,13 @@ static void _ocf_mngt_activate_check_superblock(ocf_pipeline_t pipeline,
 				-OCF_ERR_CACHE_LINE_SIZE_MISMATCH);
 	}
 
+	if (cache->conf_meta->compact_metadata != cache->metadata.compact) {
+		ocf_cache_log(cache, log_err, "Failed to activate standby instance: "
+				"metadata layout mismatch\n");
+		OCF_PL_FINISH_RET(context->pipeline,
+				-OCF_ERR_SUPERBLOCK_MISMATCH);
+	}
+
 	if (env_strncmp(cache->conf_meta->name, OCF_CACHE_NAME_SIZE,
 				cache->name, OCF_CACHE_NAME_SIZE)) {
 		ocf_cache_log(cache, log_err, "Failed to activate standby instance: "
@@ -2531,6 +2742,9 @@ static void _ocf_mngt_activate_handle_error(
 	if (context->flags.promotion_initialized)
 		__deinit_promotion_policy(cache);
 
+	if (context->flags.replacement_initialized)
+		ocf_lru_ghost_deinit(cache);
+
 	if (context->flags.cores_opened)
 		_ocf_mngt_deinit_added_cores(context);
 
@@ -2595,9 +2809,11 @@ struct ocf_pipeline_properties _ocf_mngt_cache_activate_pipeline_properties = {
 		OCF_PL_STEP(_ocf_mngt_activate_init_properties),
 		OCF_PL_STEP(_ocf_mngt_test_volume),
 		OCF_PL_STEP(_ocf_mngt_init_promotion),
+		OCF_PL_STEP(_ocf_mngt_init_replacement),
 		OCF_PL_STEP(_ocf_mngt_load_add_cores),
 		OCF_PL_STEP(_ocf_mngt_standby_init_structures_load),
 		OCF_PL_STEP(_ocf_mngt_load_rebuild_metadata),
+		OCF_PL_STEP(_ocf_mngt_init_dirty_index),
 		OCF_PL_STEP(_ocf_mngt_load_init_cleaning),
 		OCF_PL_STEP(_ocf_mngt_attach_shutdown_status),
 		OCF_PL_STEP(_ocf_mngt_attach_post_init),
@@ -2921,6 +3137,35 @@ static int _ocf_mngt_cache_validate_cfg(struct ocf_mngt_cache_config *cfg)
 		return -OCF_ERR_INVAL;
 	}
 
+	if (cfg->replacement_policy >= ocf_replacement_max ||
+			cfg->replacement_policy < 0) {
+		return -OCF_ERR_INVAL;
+	}
+
+	if (cfg->lru_lists < OCF_LRU_LISTS_MIN ||
+			cfg->lru_lists > OCF_LRU_LISTS_MAX) {
+		return -OCF_ERR_INVAL;
+	}
+
+	if (cfg->metadata_global_locks < OCF_METADATA_GLOBAL_LOCKS_MIN ||
+			cfg->metadata_global_locks >
+			OCF_METADATA_GLOBAL_LOCKS_MAX) {
+		return -OCF_ERR_INVAL;
+	}
+
+	if (!cfg->hash_buckets_per_lock ||
+			cfg->hash_buckets_per_lock >
+			OCF_HASH_BUCKETS_PER_LOCK_MAX ||
+			(cfg->hash_buckets_per_lock &
+			(cfg->hash_buckets_per_lock - 1))) {
+		return -OCF_ERR_INVAL;
+	}
+
+	if (cfg->metadata_io_depth < OCF_METADATA_IO_DEPTH_MIN ||
+			cfg->metadata_io_depth > OCF_METADATA_IO_DEPTH_MAX) {
+		return -OCF_ERR_INVAL;
+	}
+
 	if (!ocf_cache_line_size_is_valid(cfg->cache_line_size))
 		return -OCF_ERR_INVALID_CACHE_LINE_SIZE;
 
@@ -3080,6 +3325,7 @@ static void _ocf_mngt_cache_unplug(ocf_cache_t cache, bool stop,
 
 	__deinit_cleaning_policy(cache);
 	__deinit_promotion_policy(cache);
+	ocf_lru_ghost_deinit(cache);
 
 	if (!stop) {
 		/* Just set correct shutdown status */
@@ -3616,6 +3862,88 @@ int ocf_mngt_cache_get_fallback_pt_error_threshold(ocf_cache_t cache,
 	return 0;
 }
 
+int ocf_mngt_cache_set_cleaner_memory_budget(ocf_cache_t cache,
+		uint32_t budget)
+{
+	struct ocf_cleaner_pipeline *pipeline;
+
+	OCF_CHECK_NULL(cache);
+
+	if (ocf_cache_is_standby(cache))
+		return -OCF_ERR_CACHE_STANDBY;
+
+	if (budget < OCF_CLEANER_MEMORY_BUDGET_MIN ||
+			budget > OCF_CLEANER_MEMORY_BUDGET_MAX) {
+		ocf_cache_log(cache, log_err, "Refusing setting cleaner memory "
+				"budget - value out of range\n");
+		return -OCF_ERR_INVAL;
+	}
+
+	pipeline = &cache->cleaner.pipeline;
+
+	env_spinlock_lock(&pipeline->lock);
+	pipeline->budget = (uint64_t)budget * MiB;
+	env_spinlock_unlock(&pipeline->lock);
+
+	ocf_cache_log(cache, log_info, "Cleaner memory budget: %u MiB\n",
+			budget);
+
+	return 0;
+}
+
+int ocf_mngt_cache_get_cleaner_memory_budget(ocf_cache_t cache,
+		uint32_t *budget)
+{
+	OCF_CHECK_NULL(cache);
+	OCF_CHECK_NULL(budget);
+
+	if (ocf_cache_is_standby(cache))
+		return -OCF_ERR_CACHE_STANDBY;
+
+	*budget = cache->cleaner.pipeline.budget / MiB;
+
+	return 0;
+}
+
+int ocf_mngt_cache_set_cleaner_idle_time(ocf_cache_t cache, uint32_t time)
+{
+	OCF_CHECK_NULL(cache);
+
+	if (ocf_cache_is_standby(cache))
+		return -OCF_ERR_CACHE_STANDBY;
+
+	if (time > OCF_CLEANER_IDLE_TIME_MAX) {
+		ocf_cache_log(cache, log_err, "Refusing setting cleaner idle "
+				"time - value out of range\n");
+		return -OCF_ERR_INVAL;
+	}
+
+	cache->cleaner.idle.time_ms = time;
+
+	if (time == OCF_CLEANER_IDLE_TIME_DISABLED) {
+		ocf_cache_log(cache, log_info, "Cleaning while cache is idle "
+				"disabled\n");
+	} else {
+		ocf_cache_log(cache, log_info, "Cleaner idle time: %u ms\n",
+				time);
+	}
+
+	return 0;
+}
+
+int ocf_mngt_cache_get_cleaner_idle_time(ocf_cache_t cache, uint32_t *time)
+{
+	OCF_CHECK_NULL(cache);
+	OCF_CHECK_NULL(time);
+
+	if (ocf_cache_is_standby(cache))
+		return -OCF_ERR_CACHE_STANDBY;
+
+	*time = cache->cleaner.idle.time_ms;
+
+	return 0;
+}
+
 struct ocf_mngt_cache_detach_context {
 	/* unplug context - this is private structure of _ocf_mngt_cache_unplug,
 	 * it is member of detach context only to reserve memory in advance for
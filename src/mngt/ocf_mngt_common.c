@@ -15,6 +15,7 @@
 #include "../ocf_logger_priv.h"
 #include "../ocf_queue_priv.h"
 #include "../engine/engine_common.h"
+#include "../utils/utils_user_part.h"
 
 /* Close if opened */
 void cache_mngt_core_deinit(ocf_core_t core)
@@ -52,6 +53,7 @@ void cache_mngt_core_deinit_attached_meta(ocf_core_t core)
 	ocf_core_id_t iter_core_id;
 	ocf_cache_line_t curr_cline, prev_cline;
 	uint32_t hash, num_hash = cache->device->hash_table_entries;
+	ocf_part_id_t part_id;
 	unsigned lock_idx;
 
 	for (hash = 0; hash < num_hash;) {
@@ -100,6 +102,15 @@ void cache_mngt_core_deinit_attached_meta(ocf_core_t core)
 		else
 			env_msleep(100);
 	}
+
+	/* Sparsing doesn't update dirty counters, so drop dirty cache lines
+	 * of removed core from partitions dirty watermark accounting */
+	for (part_id = 0; part_id < OCF_USER_IO_CLASS_MAX; part_id++) {
+		env_atomic_sub(env_atomic_read(&core->runtime_meta->
+					part_counters[part_id].dirty_clines),
+				&cache->user_parts[part_id].watermark.dirty);
+		ocf_user_part_dirty_update(cache, &cache->user_parts[part_id]);
+	}
 }
 
 /* Mark core as removed in metadata */
@@ -129,6 +140,12 @@ void cache_mngt_core_remove_from_cache(ocf_core_t core)
 	ocf_cache_t cache = ocf_core_get_cache(core);
 
 	ocf_core_seq_cutoff_deinit(core);
+
+	/* Dirty index may be populated in background after lazy load */
+	ocf_metadata_start_exclusive_access(&cache->metadata.lock);
+	ocf_metadata_dirty_index_core_deinit(core);
+	ocf_metadata_end_exclusive_access(&cache->metadata.lock);
+
 	env_free(core->counters);
 	core->counters = NULL;
 	core->added = false;
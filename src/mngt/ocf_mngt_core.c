@@ -148,6 +148,8 @@ static void _ocf_mngt_cache_add_core_handle_error(
 	if (context->flags.clean_pol_added)
 		ocf_cleaning_remove_core(cache, core_id);
 
+	ocf_metadata_dirty_index_core_deinit(core);
+
 	if (context->flags.cutoff_initialized)
 		ocf_core_seq_cutoff_deinit(core);
 
@@ -425,6 +427,13 @@ static void ocf_mngt_cache_add_core_insert(ocf_pipeline_t pipeline,
 		OCF_PL_FINISH_RET(pipeline, -OCF_ERR_CORE_NOT_AVAIL);
 	}
 
+	if (ocf_cache_is_device_attached(cache) &&
+			!ocf_metadata_core_length_supported(cache, length)) {
+		ocf_cache_log(cache, log_err, "Core %s is too big for compact "
+				"metadata\n", cfg->name);
+		OCF_PL_FINISH_RET(pipeline, -OCF_ERR_CORE_TOO_BIG);
+	}
+
 	core->conf_meta->length = length;
 	core->conf_meta->type = cfg->volume_type;
 
@@ -434,6 +443,10 @@ static void ocf_mngt_cache_add_core_insert(ocf_pipeline_t pipeline,
 			OCF_PL_FINISH_RET(pipeline, result);
 
 		context->flags.clean_pol_added = true;
+
+		result = ocf_metadata_dirty_index_core_init(cache, core);
+		if (result)
+			OCF_PL_FINISH_RET(pipeline, result);
 	}
 
 	result = ocf_core_seq_cutoff_init(core);
@@ -441,6 +454,9 @@ static void ocf_mngt_cache_add_core_insert(ocf_pipeline_t pipeline,
 		OCF_PL_FINISH_RET(pipeline, result);
 	context->flags.cutoff_initialized = true;
 
+	ENV_BUG_ON(env_memset(&core->flush, sizeof(core->flush), 0));
+	core->flush.queue_depth = OCF_FLUSH_QUEUE_DEPTH_DEFAULT;
+
 	/* When adding new core to cache, allocate stat counters */
 	core->counters =
 		env_zalloc(sizeof(*core->counters), ENV_MEM_NORMAL);
@@ -1252,3 +1268,66 @@ int ocf_mngt_core_get_seq_cutoff_promote_on_threshold(ocf_core_t core,
 
 	return 0;
 }
+
+static int _cache_mngt_set_core_flush_queue_depth(ocf_core_t core,
+		void *cntx)
+{
+	uint32_t queue_depth = *(uint32_t*) cntx;
+
+	if (queue_depth < OCF_FLUSH_QUEUE_DEPTH_MIN ||
+			queue_depth > OCF_FLUSH_QUEUE_DEPTH_MAX) {
+		ocf_core_log(core, log_info,
+				"Invalid flush queue depth!\n");
+		return -OCF_ERR_INVAL;
+	}
+
+	core->flush.queue_depth = queue_depth;
+
+	ocf_core_log(core, log_info, "Flush queue depth set to %u\n",
+			queue_depth);
+
+	return 0;
+}
+
+int ocf_mngt_core_set_flush_queue_depth(ocf_core_t core,
+		uint32_t queue_depth)
+{
+	ocf_cache_t cache;
+
+	OCF_CHECK_NULL(core);
+
+	cache = ocf_core_get_cache(core);
+	if (ocf_cache_is_standby(cache))
+		return -OCF_ERR_CACHE_STANDBY;
+
+	return _cache_mngt_set_core_flush_queue_depth(core, &queue_depth);
+}
+
+int ocf_mngt_core_set_flush_queue_depth_all(ocf_cache_t cache,
+		uint32_t queue_depth)
+{
+	OCF_CHECK_NULL(cache);
+
+	if (ocf_cache_is_standby(cache))
+		return -OCF_ERR_CACHE_STANDBY;
+
+	return ocf_core_visit(cache, _cache_mngt_set_core_flush_queue_depth,
+			&queue_depth, true);
+}
+
+int ocf_mngt_core_get_flush_queue_depth(ocf_core_t core,
+		uint32_t *queue_depth)
+{
+	ocf_cache_t cache;
+
+	OCF_CHECK_NULL(core);
+	OCF_CHECK_NULL(queue_depth);
+
+	cache = ocf_core_get_cache(core);
+	if (ocf_cache_is_standby(cache))
+		return -OCF_ERR_CACHE_STANDBY;
+
+	*queue_depth = core->flush.queue_depth;
+
+	return 0;
+}
@@ -21,18 +21,51 @@
 struct ocf_mngt_cache_flush_context;
 typedef void (*ocf_flush_complete_t)(struct ocf_mngt_cache_flush_context *, int);
 
-struct flush_containers_context
+/* window of dirty cache lines gathered and flushed at once */
+struct flush_window
 {
-	/* array of container descriptors */
+	/* gathered cache lines sorted by core id and core line */
+	struct flush_data *flush_data;
+	/* number of gathered cache lines */
+	uint32_t count;
+	/* per core containers pointing into flush_data */
 	struct flush_container *fctbl;
-	/* fctbl array size */
+	/* number of used containers */
 	uint32_t fcnum;
+};
+
+struct flush_containers_context
+{
+	/* window being flushed and window being gathered */
+	struct flush_window window[2];
+	/* index of window being flushed */
+	unsigned curr;
+	/* capacity of each window in cache lines */
+	uint32_t window_size;
+	/* capacity of each window containers table */
+	uint32_t fcmax;
+	/* flushed core id, OCF_CORE_MAX if flushing all cores */
+	ocf_core_id_t core_id;
+	/* next collision table entry to be scanned */
+	ocf_cache_line_t scan_pos;
+	/* number of dirty cache lines not gathered yet */
+	uint32_t dirty_remaining;
+	/* request gathering next window */
+	struct ocf_request *gather_req;
+	/* flush of current window and gathering of next one in progress */
+	env_atomic window_pending;
 	/* shared error for all concurrent container flushes */
 	env_atomic error;
 	/* number of outstanding container flushes */
 	env_atomic count;
 	/* first container flush to notice interrupt sets this to 1 */
 	env_atomic interrupt_seen;
+	/* I/O queues flush portions are spread across */
+	ocf_queue_t *queues;
+	/* queues array size */
+	uint32_t queues_cnt;
+	/* round robin index of next queue to be used */
+	env_atomic next_queue;
 	/* completion to be called after all containers are flushed */
 	ocf_flush_complete_t complete;
 };
@@ -138,58 +171,58 @@ bool ocf_mngt_cache_is_dirty(ocf_cache_t cache)
 }
 
 /************************FLUSH CORE CODE**************************************/
-/* Returns:
- * 0 if OK and tbl & num is filled:
- * * tbl - table with sectors&cacheline
- * * num - number of items in this table.
- * other value means error.
- * NOTE:
- * Table is not sorted.
+/*
+ * Dirty cache lines are not gathered all at once. Collision table is scanned
+ * in windows of at most OCF_MNG_FLUSH_WINDOW dirty cache lines, each window
+ * is sorted and flushed while the next one is gathered, so that memory usage
+ * does not depend on number of dirty cache lines.
  */
-static int _ocf_mngt_get_sectors(ocf_cache_t cache, ocf_core_id_t core_id,
-		struct flush_data **tbl, uint32_t *num)
+#define OCF_MNG_FLUSH_WINDOW OCF_CONFIG_FLUSH_WINDOW
+
+static void _ocf_mngt_flush_window_gather(ocf_cache_t cache,
+		struct flush_containers_context *fsc,
+		struct flush_window *window)
 {
-	ocf_core_t core = ocf_cache_get_core(cache, core_id);
-	uint64_t core_line;
-	ocf_core_id_t i_core_id;
+	ocf_cache_line_t entries = cache->device->collision_table_entries;
+	struct ocf_dirty_index *index = NULL;
+	struct flush_container *fc = NULL;
 	struct flush_data *elem;
-	uint32_t line, dirty_found = 0, dirty_total = 0;
-	unsigned ret = 0;
+	ocf_core_id_t core_id;
+	uint64_t core_line;
+	ocf_cache_line_t line;
+	uint32_t i;
+
+	window->count = 0;
+	window->fcnum = 0;
 
 	ocf_metadata_start_exclusive_access(&cache->metadata.lock);
 
-	dirty_total = env_atomic_read(&core->runtime_meta->dirty_clines);
-	if (!dirty_total) {
-		*num = 0;
-		*tbl = NULL;
-		goto unlock;
-	}
+	/* Flushing single core visit only chunks containing its dirty lines */
+	if (fsc->core_id != OCF_CORE_MAX)
+		index = ocf_cache_get_core(cache, fsc->core_id)->dirty_index;
 
-	*tbl = env_vmalloc(dirty_total * sizeof(**tbl));
-	if (*tbl == NULL) {
-		ret = -OCF_ERR_NO_MEM;
-		goto unlock;
-	}
+	for (line = fsc->scan_pos; line < entries; line++) {
+		if (!fsc->dirty_remaining || window->count == fsc->window_size)
+			break;
+
+		if (index && !(line % OCF_DIRTY_INDEX_CHUNK_LINES)) {
+			line = ocf_metadata_dirty_index_next(index, line,
+					entries);
+			if (line == entries)
+				break;
+		}
 
-	for (line = 0, elem = *tbl;
-			line < cache->device->collision_table_entries;
-			line++) {
-		ocf_metadata_get_core_info(cache, line, &i_core_id,
-				&core_line);
+		ocf_metadata_get_core_info(cache, line, &core_id, &core_line);
 
-		if (i_core_id == core_id &&
+		if ((fsc->core_id == OCF_CORE_MAX || core_id == fsc->core_id) &&
 				metadata_test_valid_any(cache, line) &&
 				metadata_test_dirty(cache, line)) {
 			/* It's valid and dirty target core cacheline */
+			elem = &window->flush_data[window->count++];
 			elem->cache_line = line;
 			elem->core_line = core_line;
-			elem->core_id = i_core_id;
-			elem++;
-			dirty_found++;
-
-			/* stop if all cachelines were found */
-			if (dirty_found == dirty_total)
-				break;
+			elem->core_id = core_id;
+			fsc->dirty_remaining--;
 		}
 
 		if ((line + 1) % 131072 == 0) {
@@ -201,136 +234,79 @@ static int _ocf_mngt_get_sectors(ocf_cache_t cache, ocf_core_id_t core_id,
 		}
 	}
 
-	ocf_core_log(core, log_debug,
-			"%u dirty cache lines to clean\n", dirty_found);
-
+	/* stop if all cachelines were found */
+	fsc->scan_pos = fsc->dirty_remaining ? line : entries;
 
-	*num = dirty_found;
-
-unlock:
 	ocf_metadata_end_exclusive_access(&cache->metadata.lock);
 
-	return ret;
-}
-
-static int _ocf_mngt_get_flush_containers(ocf_cache_t cache,
-		struct flush_container **fctbl, uint32_t *fcnum)
-{
-	struct flush_container *fc;
-	struct flush_container *curr;
-	uint32_t *core_revmap;
-	uint32_t num;
-	uint64_t core_line;
-	ocf_core_id_t core_id;
-	ocf_core_t core;
-	uint32_t i, j = 0, line;
-	uint32_t dirty_found = 0, dirty_total = 0;
-	int ret = 0;
-
-	ocf_metadata_start_exclusive_access(&cache->metadata.lock);
-
-	/*
-	 * TODO: Create containers for each physical device, not for
-	 *       each core. Cores can be partitions of single device.
-	 */
-	num = cache->conf_meta->core_count;
-	if (num == 0) {
-		*fcnum = 0;
-		goto unlock;
-	}
-
-	core_revmap = env_vzalloc(sizeof(*core_revmap) * OCF_CORE_MAX);
-	if (!core_revmap)
-		return -OCF_ERR_NO_MEM;
-
-	/* TODO: Alloc fcs and data tables in single allocation */
-	fc = env_vzalloc(sizeof(**fctbl) * num);
-	if (!fc) {
-		env_vfree(core_revmap);
-		ret = -OCF_ERR_NO_MEM;
-		goto unlock;
-	}
-
-	for_each_core(cache, core, core_id) {
-		fc[j].core_id = core_id;
-		core_revmap[core_id] = j;
-
-		/* Check for dirty blocks */
-		fc[j].count = env_atomic_read(
-				&core->runtime_meta->dirty_clines);
-		dirty_total += fc[j].count;
+	/* Sort data. Smallest sectors first (0...n). */
+	ocf_cleaner_sort_sectors(window->flush_data, window->count);
 
-		if (fc[j].count) {
-			fc[j].flush_data = env_vmalloc(fc[j].count *
-					sizeof(*fc[j].flush_data));
+	for (i = 0; i < window->count; i++) {
+		elem = &window->flush_data[i];
+		if (fc && fc->core_id == elem->core_id) {
+			fc->count++;
+			continue;
 		}
 
-		if (++j == cache->conf_meta->core_count)
-			break;
-	}
+		ENV_BUG_ON(window->fcnum == fsc->fcmax);
 
-	if (!dirty_total) {
-		env_vfree(core_revmap);
-		env_vfree(fc);
-		*fcnum = 0;
-		goto unlock;
+		fc = &window->fctbl[window->fcnum++];
+		ENV_BUG_ON(env_memset(fc, sizeof(*fc), 0));
+		fc->core_id = elem->core_id;
+		fc->flush_data = elem;
+		fc->count = 1;
 	}
+}
 
-	for (line = 0; line < cache->device->collision_table_entries; line++) {
-		ocf_metadata_get_core_info(cache, line, &core_id, &core_line);
-
-		if (metadata_test_valid_any(cache, line) &&
-				metadata_test_dirty(cache, line)) {
-			curr = &fc[core_revmap[core_id]];
-
-			ENV_BUG_ON(curr->iter >= curr->count);
-
-			/* It's core_id cacheline and it's valid and it's dirty! */
-			curr->flush_data[curr->iter].cache_line = line;
-			curr->flush_data[curr->iter].core_line = core_line;
-			curr->flush_data[curr->iter].core_id = core_id;
-			curr->iter++;
-			dirty_found++;
-
-			/* stop if all cachelines were found */
-			if (dirty_found == dirty_total)
-				break;
-		}
-
-		if ((line + 1) % 131072 == 0) {
-			ocf_metadata_end_exclusive_access(
-					&cache->metadata.lock);
-			env_cond_resched();
-			ocf_metadata_start_exclusive_access(
-					&cache->metadata.lock);
-		}
-	}
+static void _ocf_mngt_flush_window_reset(struct flush_window *window)
+{
+	uint32_t i;
 
-	if (dirty_total != dirty_found) {
-		for (i = 0; i < num; i++)
-			fc[i].count = fc[i].iter;
+	for (i = 0; i < window->fcnum; i++) {
+		env_vfree(window->fctbl[i].portions);
+		window->fctbl[i].portions = NULL;
 	}
 
-	for (i = 0; i < num; i++)
-		fc[i].iter = 0;
+	window->count = 0;
+	window->fcnum = 0;
+}
 
-	env_vfree(core_revmap);
-	*fctbl = fc;
-	*fcnum = num;
+static void _ocf_mngt_flush_windows_free(struct flush_containers_context *fsc)
+{
+	int i;
 
-unlock:
-	ocf_metadata_end_exclusive_access(&cache->metadata.lock);
-	return ret;
+	for (i = 0; i < 2; i++) {
+		if (fsc->window[i].fctbl)
+			_ocf_mngt_flush_window_reset(&fsc->window[i]);
+		env_vfree(fsc->window[i].flush_data);
+		env_vfree(fsc->window[i].fctbl);
+		fsc->window[i].flush_data = NULL;
+		fsc->window[i].fctbl = NULL;
+	}
 }
 
-static void _ocf_mngt_free_flush_containers(struct flush_container *fctbl,
-	uint32_t num)
+static int _ocf_mngt_flush_windows_alloc(struct flush_containers_context *fsc,
+		uint32_t dirty_total)
 {
 	int i;
 
-	for (i = 0; i < num; i++)
-		env_vfree(fctbl[i].flush_data);
-	env_vfree(fctbl);
+	fsc->window_size = OCF_MIN(dirty_total, OCF_MNG_FLUSH_WINDOW);
+
+	for (i = 0; i < 2; i++) {
+		fsc->window[i].count = 0;
+		fsc->window[i].fcnum = 0;
+		fsc->window[i].flush_data = env_vmalloc(fsc->window_size *
+				sizeof(*fsc->window[i].flush_data));
+		fsc->window[i].fctbl = env_vzalloc(fsc->fcmax *
+				sizeof(*fsc->window[i].fctbl));
+		if (!fsc->window[i].flush_data || !fsc->window[i].fctbl) {
+			_ocf_mngt_flush_windows_free(fsc);
+			return -OCF_ERR_NO_MEM;
+		}
+	}
+
+	return 0;
 }
 
 /*
@@ -341,18 +317,26 @@ static void _ocf_mngt_free_flush_containers(struct flush_container *fctbl,
 #define OCF_MNG_FLUSH_MIN (4*MiB / ocf_line_size(cache))
 #define OCF_MNG_FLUSH_MAX (100*MiB / ocf_line_size(cache))
 
-static void _ocf_mngt_flush_portion(struct flush_container *fc)
+/* Flush portion size is adjusted to complete in about this time */
+#define OCF_MNG_FLUSH_PORTION_MSECS 1000
+
+static void _ocf_mngt_flush_portion_adjust(struct flush_container *fc,
+		struct flush_container_portion *portion)
 {
 	ocf_cache_t cache = fc->cache;
+	ocf_core_t core = &cache->core[fc->core_id];
 	uint64_t flush_portion_div;
-	uint32_t curr_count;
 
-	flush_portion_div = env_ticks_to_msecs(fc->ticks2 - fc->ticks1);
-	if (unlikely(!flush_portion_div))
-		flush_portion_div = 1;
+	if (portion->latency) {
+		flush_portion_div = env_ticks_to_msecs(portion->latency);
+		if (unlikely(!flush_portion_div))
+			flush_portion_div = 1;
 
-	fc->flush_portion = fc->flush_portion * 1000 / flush_portion_div;
-	fc->flush_portion &= ~0x3ffULL;
+		fc->flush_portion = (uint64_t)portion->count *
+				OCF_MNG_FLUSH_PORTION_MSECS / flush_portion_div;
+		fc->flush_portion &= ~0x3ffULL;
+		portion->latency = 0;
+	}
 
 	/* regardless those calculations, limit flush portion to be
 	 * between OCF_MNG_FLUSH_MIN and OCF_MNG_FLUSH_MAX
@@ -360,27 +344,84 @@ static void _ocf_mngt_flush_portion(struct flush_container *fc)
 	fc->flush_portion = OCF_MIN(fc->flush_portion, OCF_MNG_FLUSH_MAX);
 	fc->flush_portion = OCF_MAX(fc->flush_portion, OCF_MNG_FLUSH_MIN);
 
-	curr_count = OCF_MIN(fc->count - fc->iter, fc->flush_portion);
+	env_atomic_set(&core->flush.portion, fc->flush_portion);
+}
+
+static ocf_queue_t _ocf_mngt_flush_next_queue(struct flush_containers_context *fsc)
+{
+	uint32_t idx = env_atomic_inc_return(&fsc->next_queue);
+
+	return fsc->queues[idx % fsc->queues_cnt];
+}
+
+static void _ocf_mngt_flush_portion(struct flush_container *fc,
+		struct flush_container_portion *portion)
+{
+	struct flush_containers_context *fsc = &fc->context->fcs;
+	ocf_cache_t cache = fc->cache;
+	ocf_core_t core = &cache->core[fc->core_id];
+	struct ocf_cleaner_attribs attribs = fc->attribs;
+
+	_ocf_mngt_flush_portion_adjust(fc, portion);
+
+	portion->count = OCF_MIN(fc->count - fc->iter, fc->flush_portion);
+	portion->ticks = env_get_tick_count();
+
+	attribs.cmpl_context = portion;
+	attribs.io_queue = _ocf_mngt_flush_next_queue(fsc);
 
-	ocf_cleaner_do_flush_data_async(fc->cache,
-			&fc->flush_data[fc->iter],
-			curr_count, &fc->attribs);
+	env_atomic_inc(&fc->in_flight);
+	env_atomic_inc(&core->flush.in_flight);
 
-	fc->iter += curr_count;
+	fc->iter += portion->count;
+
+	ocf_cleaner_do_flush_data_async(cache, &fc->flush_data[fc->iter -
+			portion->count], portion->count, &attribs);
+}
+
+static void _ocf_mngt_flush_container_put(struct flush_container *fc)
+{
+	if (env_atomic_dec_return(&fc->in_flight))
+		return;
+
+	ocf_req_put(fc->req);
+	fc->end(fc->context);
+}
+
+/*
+ * Has to be called with container reference held. Queued step holds its own
+ * reference, so container can't be finished before the step runs.
+ */
+static void _ocf_mngt_flush_container_schedule(struct flush_container *fc)
+{
+	struct ocf_mngt_cache_flush_context *context = fc->context;
+
+	if (env_atomic_read(&context->fcs.error) || fc->iter == fc->count)
+		return;
+
+	if (env_atomic_cmpxchg(&fc->step_pending, 0, 1))
+		return;
+
+	env_atomic_inc(&fc->in_flight);
+	ocf_engine_push_req_back(fc->req, false);
 }
 
 static void _ocf_mngt_flush_portion_end(void *private_data, int error)
 {
-	struct flush_container *fc = private_data;
+	struct flush_container_portion *portion = private_data;
+	struct flush_container *fc = portion->fc;
 	struct ocf_mngt_cache_flush_context *context = fc->context;
 	struct flush_containers_context *fsc = &context->fcs;
 	ocf_cache_t cache = context->cache;
 	ocf_core_t core = &cache->core[fc->core_id];
 	bool first_interrupt;
 
-	env_atomic_set(&core->flushed, fc->iter);
+	env_atomic_add(portion->count, &core->flushed);
+	env_atomic_add(portion->count, &core->flush.done);
+	env_atomic_dec(&core->flush.in_flight);
 
-	fc->ticks2 = env_get_tick_count();
+	portion->latency = env_get_tick_count() - portion->ticks;
+	env_atomic_dec(&portion->busy);
 
 	env_atomic_cmpxchg(&fsc->error, 0, error);
 
@@ -395,25 +436,36 @@ static void _ocf_mngt_flush_portion_end(void *private_data, int error)
 		}
 	}
 
-	if (env_atomic_read(&fsc->error) || fc->iter == fc->count) {
-		ocf_req_put(fc->req);
-		fc->end(context);
-		return;
-	}
-
-	ocf_engine_push_req_back(fc->req, false);
+	_ocf_mngt_flush_container_schedule(fc);
+	_ocf_mngt_flush_container_put(fc);
 }
 
-
 static int _ofc_flush_container_step(struct ocf_request *req)
 {
 	struct flush_container *fc = req->priv;
+	struct flush_containers_context *fsc = &fc->context->fcs;
 	ocf_cache_t cache = fc->cache;
+	struct flush_container_portion *portion;
+	uint32_t i;
+
+	/* Container is kept alive by reference taken when step was queued */
+	env_atomic_set(&fc->step_pending, 0);
 
 	ocf_metadata_start_exclusive_access(&cache->metadata.lock);
-	_ocf_mngt_flush_portion(fc);
+	for (i = 0; i < fc->queue_depth; i++) {
+		if (env_atomic_read(&fsc->error) || fc->iter == fc->count)
+			break;
+
+		portion = &fc->portions[i];
+		if (env_atomic_cmpxchg(&portion->busy, 0, 1))
+			continue;
+
+		_ocf_mngt_flush_portion(fc, portion);
+	}
 	ocf_metadata_end_exclusive_access(&cache->metadata.lock);
 
+	_ocf_mngt_flush_container_put(fc);
+
 	return 0;
 }
 
@@ -422,18 +474,29 @@ static void _ocf_mngt_flush_container(
 		struct flush_container *fc, ocf_flush_containter_coplete_t end)
 {
 	ocf_cache_t cache = context->cache;
+	ocf_core_t core = &cache->core[fc->core_id];
 	struct ocf_request *req;
 	int error = 0;
-
-	if (!fc->count)
-		goto finish;
+	uint32_t i;
 
 	fc->end = end;
 	fc->context = context;
+	fc->cache = cache;
+	fc->flush_portion = OCF_MNG_FLUSH_MIN;
+	fc->queue_depth = core->flush.queue_depth;
+
+	fc->portions = env_vzalloc(sizeof(*fc->portions) * fc->queue_depth);
+	if (!fc->portions) {
+		error = -OCF_ERR_NO_MEM;
+		goto finish;
+	}
+
+	for (i = 0; i < fc->queue_depth; i++)
+		fc->portions[i].fc = fc;
 
 	req = ocf_req_new(cache->mngt_queue, NULL, 0, 0, 0);
 	if (!req) {
-		error = OCF_ERR_NO_MEM;
+		error = -OCF_ERR_NO_MEM;
 		goto finish;
 	}
 
@@ -444,13 +507,10 @@ static void _ocf_mngt_flush_container(
 	fc->req = req;
 	fc->attribs.lock_cacheline = true;
 	fc->attribs.lock_metadata = false;
-	fc->attribs.cmpl_context = fc;
 	fc->attribs.cmpl_fn = _ocf_mngt_flush_portion_end;
-	fc->attribs.io_queue = cache->mngt_queue;
-	fc->cache = cache;
-	fc->flush_portion = OCF_MNG_FLUSH_MIN;
-	fc->ticks1 = 0;
-	fc->ticks2 = UINT_MAX;
+	/* Reference of the first step */
+	env_atomic_set(&fc->in_flight, 1);
+	env_atomic_set(&fc->step_pending, 1);
 
 	ocf_engine_push_req_back(fc->req, true);
 	return;
@@ -460,82 +520,238 @@ finish:
 	end(context);
 }
 
-void _ocf_flush_container_complete(void *ctx)
+static void _ocf_mngt_flush_put_queues(struct flush_containers_context *fsc)
 {
-	struct ocf_mngt_cache_flush_context *context = ctx;
+	uint32_t i;
 
-	if (env_atomic_dec_return(&context->fcs.count)) {
-		return;
+	for (i = 0; i < fsc->queues_cnt; i++)
+		ocf_queue_put(fsc->queues[i]);
+
+	env_vfree(fsc->queues);
+	fsc->queues = NULL;
+	fsc->queues_cnt = 0;
+}
+
+static int _ocf_mngt_flush_get_queues(ocf_cache_t cache,
+		struct flush_containers_context *fsc)
+{
+	ocf_queue_t queue;
+	uint32_t i = 0;
+
+	fsc->queues_cnt = ocf_cache_get_queue_count(cache) ?: 1;
+	fsc->queues = env_vzalloc(sizeof(*fsc->queues) * fsc->queues_cnt);
+	if (!fsc->queues)
+		return -OCF_ERR_NO_MEM;
+
+	list_for_each_entry(queue, &cache->io_queues, list)
+		fsc->queues[i++] = queue;
+
+	/* Fall back to management queue if there are no I/O queues */
+	if (!i)
+		fsc->queues[0] = cache->mngt_queue;
+
+	for (i = 0; i < fsc->queues_cnt; i++)
+		ocf_queue_get(fsc->queues[i]);
+
+	env_atomic_set(&fsc->next_queue, 0);
+
+	return 0;
+}
+
+static inline bool _ocf_mngt_flush_is_target(
+		struct flush_containers_context *fsc, ocf_core_id_t core_id)
+{
+	return fsc->core_id == OCF_CORE_MAX || fsc->core_id == core_id;
+}
+
+static void _ocf_mngt_flush_progress_start(ocf_core_t core)
+{
+	env_atomic_set(&core->flush.total,
+			env_atomic_read(&core->runtime_meta->dirty_clines));
+	env_atomic_set(&core->flush.done, 0);
+	env_atomic_set(&core->flush.in_flight, 0);
+	env_atomic_set(&core->flush.portion, 0);
+	env_atomic64_set(&core->flush.start, env_get_tick_count());
+	env_atomic64_set(&core->flush.end, 0);
+}
+
+static void _ocf_mngt_flush_progress_end(ocf_cache_t cache,
+		struct flush_containers_context *fsc)
+{
+	ocf_core_t core;
+	ocf_core_id_t core_id;
+
+	for_each_core(cache, core, core_id) {
+		if (_ocf_mngt_flush_is_target(fsc, core_id))
+			env_atomic64_set(&core->flush.end, env_get_tick_count());
 	}
+}
+
+static void _ocf_mngt_flush_windows_finish(
+		struct ocf_mngt_cache_flush_context *context)
+{
+	struct flush_containers_context *fsc = &context->fcs;
+
+	_ocf_mngt_flush_progress_end(context->cache, fsc);
 
-	_ocf_mngt_free_flush_containers(context->fcs.fctbl,
-			context->fcs.fcnum);
+	ocf_req_put(fsc->gather_req);
+	_ocf_mngt_flush_windows_free(fsc);
+	_ocf_mngt_flush_put_queues(fsc);
 
-	context->fcs.complete(context,
-			env_atomic_read(&context->fcs.error));
+	fsc->complete(context, env_atomic_read(&fsc->error));
 }
 
-static void _ocf_mngt_flush_containers(
-		struct ocf_mngt_cache_flush_context *context,
-		struct flush_container *fctbl,
-		uint32_t fcnum, ocf_flush_complete_t complete)
+static void _ocf_mngt_flush_window_put(
+		struct ocf_mngt_cache_flush_context *context);
+
+static void _ocf_flush_container_complete(void *ctx)
 {
-	int i;
+	struct ocf_mngt_cache_flush_context *context = ctx;
 
-	if (fcnum == 0) {
-		complete(context, 0);
+	if (env_atomic_dec_return(&context->fcs.count))
+		return;
+
+	_ocf_mngt_flush_window_put(context);
+}
+
+static void _ocf_mngt_flush_window_advance(
+		struct ocf_mngt_cache_flush_context *context)
+{
+	struct flush_containers_context *fsc = &context->fcs;
+	ocf_cache_t cache = context->cache;
+	struct flush_window *window;
+	bool gather;
+	uint32_t i;
+
+	_ocf_mngt_flush_window_reset(&fsc->window[fsc->curr]);
+
+	fsc->curr ^= 1;
+	window = &fsc->window[fsc->curr];
+
+	if (env_atomic_read(&fsc->error) || !window->count) {
+		_ocf_mngt_flush_windows_finish(context);
 		return;
 	}
 
-	/* Sort data. Smallest sectors first (0...n). */
-	ocf_cleaner_sort_flush_containers(fctbl, fcnum);
-
-	env_atomic_set(&context->fcs.error, 0);
-	env_atomic_set(&context->fcs.count, 1);
-	context->fcs.complete = complete;
-	context->fcs.fctbl = fctbl;
-	context->fcs.fcnum = fcnum;
-
-	for (i = 0; i < fcnum; i++) {
-		env_atomic_inc(&context->fcs.count);
-		_ocf_mngt_flush_container(context, &fctbl[i],
-			_ocf_flush_container_complete);
+	gather = fsc->scan_pos < cache->device->collision_table_entries;
+
+	env_atomic_set(&fsc->window_pending, gather ? 2 : 1);
+	env_atomic_set(&fsc->count, 1);
+
+	/* Gather next window while this one is being flushed */
+	if (gather)
+		ocf_engine_push_req_back(fsc->gather_req, false);
+
+	for (i = 0; i < window->fcnum; i++) {
+		env_atomic_inc(&fsc->count);
+		_ocf_mngt_flush_container(context, &window->fctbl[i],
+				_ocf_flush_container_complete);
 	}
 
 	_ocf_flush_container_complete(context);
 }
 
+static void _ocf_mngt_flush_window_put(
+		struct ocf_mngt_cache_flush_context *context)
+{
+	if (env_atomic_dec_return(&context->fcs.window_pending))
+		return;
 
-static void _ocf_mngt_flush_core(
-	struct ocf_mngt_cache_flush_context *context,
-	ocf_flush_complete_t complete)
+	_ocf_mngt_flush_window_advance(context);
+}
+
+static int _ocf_mngt_flush_gather_step(struct ocf_request *req)
+{
+	struct ocf_mngt_cache_flush_context *context = req->priv;
+	struct flush_containers_context *fsc = &context->fcs;
+
+	_ocf_mngt_flush_window_gather(context->cache, fsc,
+			&fsc->window[fsc->curr ^ 1]);
+
+	_ocf_mngt_flush_window_put(context);
+
+	return 0;
+}
+
+/*
+ * Flush dirty cache lines of given core, or of all cores if core_id is
+ * OCF_CORE_MAX
+ */
+static void _ocf_mngt_flush_containers(
+		struct ocf_mngt_cache_flush_context *context,
+		ocf_core_id_t core_id, ocf_flush_complete_t complete)
 {
+	struct flush_containers_context *fsc = &context->fcs;
 	ocf_cache_t cache = context->cache;
-	ocf_core_t core = context->core;
-	ocf_core_id_t core_id = ocf_core_get_id(core);
-	struct flush_container *fc;
+	ocf_core_t core;
+	ocf_core_id_t i_core_id;
+	uint32_t dirty_total = 0;
 	int ret;
 
-	fc = env_vzalloc(sizeof(*fc));
-	if (!fc) {
-		complete(context, -OCF_ERR_NO_MEM);
-		return;
+	fsc->core_id = core_id;
+	fsc->fcmax = 0;
+
+	for_each_core(cache, core, i_core_id) {
+		if (!_ocf_mngt_flush_is_target(fsc, i_core_id))
+			continue;
+
+		_ocf_mngt_flush_progress_start(core);
+		dirty_total += env_atomic_read(&core->flush.total);
+		fsc->fcmax++;
 	}
 
-	ret = _ocf_mngt_get_sectors(cache, core_id,
-			&fc->flush_data, &fc->count);
-	if (ret) {
-		ocf_core_log(core, log_err, "Flushing operation aborted, "
-				"no memory\n");
-		env_vfree(fc);
-		complete(context, -OCF_ERR_NO_MEM);
+	if (!dirty_total) {
+		_ocf_mngt_flush_progress_end(cache, fsc);
+		complete(context, 0);
 		return;
 	}
 
-	fc->core_id = core_id;
-	fc->iter = 0;
+	ret = _ocf_mngt_flush_windows_alloc(fsc, dirty_total);
+	if (ret)
+		goto err_windows;
+
+	ret = _ocf_mngt_flush_get_queues(cache, fsc);
+	if (ret)
+		goto err_queues;
+
+	fsc->gather_req = ocf_req_new(fsc->queues[0], NULL, 0, 0, 0);
+	if (!fsc->gather_req) {
+		ret = -OCF_ERR_NO_MEM;
+		goto err_req;
+	}
+
+	fsc->gather_req->info.internal = true;
+	fsc->gather_req->engine_handler = _ocf_mngt_flush_gather_step;
+	fsc->gather_req->priv = context;
 
-	_ocf_mngt_flush_containers(context, fc, 1, complete);
+	fsc->scan_pos = 0;
+	fsc->dirty_remaining = dirty_total;
+	fsc->complete = complete;
+	env_atomic_set(&fsc->error, 0);
+
+	/* Start with gathering first window, as if previous one was flushed */
+	fsc->curr = 1;
+	env_atomic_set(&fsc->window_pending, 1);
+	ocf_engine_push_req_back(fsc->gather_req, true);
+
+	return;
+
+err_req:
+	_ocf_mngt_flush_put_queues(fsc);
+err_queues:
+	_ocf_mngt_flush_windows_free(fsc);
+err_windows:
+	ocf_cache_log(cache, log_err, "Flushing operation aborted, "
+			"no memory\n");
+	complete(context, ret);
+}
+
+static void _ocf_mngt_flush_core(
+	struct ocf_mngt_cache_flush_context *context,
+	ocf_flush_complete_t complete)
+{
+	_ocf_mngt_flush_containers(context, ocf_core_get_id(context->core),
+			complete);
 }
 
 static void _ocf_mngt_flush_all_cores(
@@ -543,9 +759,6 @@ static void _ocf_mngt_flush_all_cores(
 	ocf_flush_complete_t complete)
 {
 	ocf_cache_t cache = context->cache;
-	struct flush_container *fctbl = NULL;
-	uint32_t fcnum = 0;
-	int ret;
 
 	if (context->op == flush_cache)
 		ocf_cache_log(cache, log_info, "Flushing cache\n");
@@ -554,17 +767,7 @@ static void _ocf_mngt_flush_all_cores(
 
 	env_atomic_set(&cache->flush_in_progress, 1);
 
-	/* Get all 'dirty' sectors for all cores */
-	ret = _ocf_mngt_get_flush_containers(cache, &fctbl, &fcnum);
-	if (ret) {
-		ocf_cache_log(cache, log_err, "Flushing operation aborted, "
-				"no memory\n");
-		ocf_metadata_end_exclusive_access(&cache->metadata.lock);
-		complete(context, ret);
-		return;
-	}
-
-	_ocf_mngt_flush_containers(context, fctbl, fcnum, complete);
+	_ocf_mngt_flush_containers(context, OCF_CORE_MAX, complete);
 }
 
 static void _ocf_mngt_flush_all_cores_complete(
@@ -922,6 +1125,45 @@ void ocf_mngt_cache_flush_interrupt(ocf_cache_t cache)
 	cache->flushing_interrupted = 1;
 }
 
+int ocf_mngt_core_get_flush_progress(ocf_core_t core,
+		struct ocf_mngt_core_flush_progress *progress)
+{
+	ocf_cache_t cache;
+	uint64_t start, end, elapsed;
+
+	OCF_CHECK_NULL(core);
+	OCF_CHECK_NULL(progress);
+
+	cache = ocf_core_get_cache(core);
+	if (ocf_cache_is_standby(cache))
+		return -OCF_ERR_CACHE_STANDBY;
+
+	ENV_BUG_ON(env_memset(progress, sizeof(*progress), 0));
+
+	start = env_atomic64_read(&core->flush.start);
+	if (!start)
+		return 0;
+
+	end = env_atomic64_read(&core->flush.end);
+
+	progress->active = !end;
+	progress->total = env_atomic_read(&core->flush.total);
+	progress->flushed = env_atomic_read(&core->flush.done);
+	progress->in_flight = env_atomic_read(&core->flush.in_flight);
+	progress->portion = env_atomic_read(&core->flush.portion);
+
+	/* Elapsed time in microseconds */
+	elapsed = env_ticks_to_nsecs((end ?: env_get_tick_count()) - start) /
+			1000;
+	progress->elapsed_ms = elapsed / 1000;
+	if (elapsed) {
+		progress->throughput = (uint64_t)progress->flushed *
+				ocf_line_size(cache) * 1000000 / elapsed;
+	}
+
+	return 0;
+}
+
 struct ocf_mngt_cache_set_cleaning_context
 {
 	/* pipeline for switching cleaning policy */
@@ -72,6 +72,10 @@ int ocf_mngt_add_partition_to_cache(struct ocf_cache *cache,
 	cache->user_parts[part_id].config->max_size = max_size;
 	cache->user_parts[part_id].config->priority = priority;
 	cache->user_parts[part_id].config->cache_mode = ocf_cache_mode_max;
+	cache->user_parts[part_id].config->dirty_high =
+			OCF_IO_CLASS_DIRTY_HIGH_DEFAULT;
+	cache->user_parts[part_id].config->dirty_low =
+			OCF_IO_CLASS_DIRTY_LOW_DEFAULT;
 
 	ocf_user_part_set_valid(cache, part_id, valid);
 	ocf_lst_add(&cache->user_part_list, part_id);
@@ -316,6 +320,11 @@ int ocf_mngt_cache_io_classes_configure(ocf_cache_t cache,
 
 	ocf_user_part_sort(cache);
 
+	if (ocf_cache_is_device_attached(cache)) {
+		for (i = 0; i < OCF_USER_IO_CLASS_MAX; i++)
+			ocf_user_part_dirty_update(cache, &cache->user_parts[i]);
+	}
+
 out_edit:
 	if (result) {
 		ENV_BUG_ON(env_memcpy(cache->user_parts, sizeof(cache->user_parts),
@@ -328,3 +337,45 @@ out_cpy:
 
 	return result;
 }
+
+int ocf_mngt_cache_io_class_set_dirty_watermarks(ocf_cache_t cache,
+		uint32_t class_id, uint8_t high, uint8_t low)
+{
+	struct ocf_user_part *user_part;
+
+	OCF_CHECK_NULL(cache);
+
+	if (ocf_cache_is_standby(cache))
+		return -OCF_ERR_CACHE_STANDBY;
+
+	if (class_id >= OCF_USER_IO_CLASS_MAX)
+		return -OCF_ERR_INVAL;
+
+	user_part = &cache->user_parts[class_id];
+
+	if (!ocf_user_part_is_valid(user_part))
+		return -OCF_ERR_IO_CLASS_NOT_EXIST;
+
+	if (high > OCF_IO_CLASS_DIRTY_WATERMARK_DISABLED || low >= high) {
+		ocf_cache_log(cache, log_err, "Invalid dirty watermarks of "
+				"IO class, id: %u, high: %u%%, low: %u%%\n",
+				class_id, high, low);
+		return -OCF_ERR_INVAL;
+	}
+
+	ocf_metadata_start_exclusive_access(&cache->metadata.lock);
+
+	user_part->config->dirty_high = high;
+	user_part->config->dirty_low = low;
+
+	if (ocf_cache_is_device_attached(cache))
+		ocf_user_part_dirty_update(cache, user_part);
+
+	ocf_metadata_end_exclusive_access(&cache->metadata.lock);
+
+	ocf_cache_log(cache, log_info, "Setting dirty watermarks of IO class, "
+			"id: %u, name: '%s', high: %u%%, low: %u%% [ OK ]\n",
+			class_id, user_part->config->name, high, low);
+
+	return 0;
+}
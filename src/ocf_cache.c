@@ -144,6 +144,8 @@ int ocf_cache_get_info(ocf_cache_t cache, struct ocf_cache_info *info)
 			cache->device->metadata_offset / PAGE_SIZE : 0;
 	info->metadata_footprint = ocf_cache_is_device_attached(cache) ?
 			ocf_metadata_size_of(cache) : 0;
+	info->lazy_load_pending = ocf_cache_is_device_attached(cache) &&
+			ocf_metadata_lazy_load_pending(cache);
 
 	if (ocf_cache_is_standby(cache))
 		return 0;
@@ -222,6 +224,8 @@ int ocf_cache_get_info(ocf_cache_t cache, struct ocf_cache_info *info)
 
 	info->cleaning_policy = cache->cleaner.policy;
 	info->promotion_policy = cache->conf_meta->promotion_policy_type;
+	info->replacement_policy = cache->conf_meta->replacement_policy_type;
+	info->lru_lists = cache->conf_meta->lru_lists;
 	info->cache_line_size = ocf_line_size(cache);
 
 	return 0;
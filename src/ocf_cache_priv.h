@@ -107,6 +107,7 @@ struct ocf_cache {
 
 	struct list_head io_queues;
 	ocf_promotion_policy_t promotion_policy;
+	struct ocf_lru_ghost *lru_ghost;
 
 	struct {
 		uint32_t max_queue_size;
@@ -127,6 +128,13 @@ struct ocf_cache {
 
 	bool use_submit_io_fast;
 
+	bool use_lookup_index;
+
+	/* number of lru lists per partition, copy of conf_meta->lru_lists */
+	uint32_t lru_lists;
+
+	bool lru_queue_affinity;
+
 	struct {
 		struct ocf_async_lock lock;
 	} __attribute__((aligned(64)));
@@ -134,6 +142,12 @@ struct ocf_cache {
 	env_atomic last_access_ms;
 };
 
+static inline uint32_t ocf_cache_lru_list(ocf_cache_t cache,
+		ocf_cache_line_t cline)
+{
+	return cline % cache->lru_lists;
+}
+
 static inline ocf_core_t ocf_cache_get_core(ocf_cache_t cache,
 		ocf_core_id_t core_id)
 {
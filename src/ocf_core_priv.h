@@ -87,6 +87,30 @@ struct ocf_core {
 
 	env_atomic flushed;
 
+	struct {
+		/* Maximum number of flush portions in flight */
+		uint32_t queue_depth;
+
+		/* Cache lines to flush in ongoing or last flush */
+		env_atomic total;
+
+		/* Cache lines flushed in ongoing or last flush */
+		env_atomic done;
+
+		/* Current flush portion size in cache lines */
+		env_atomic portion;
+
+		/* Number of flush portions in flight */
+		env_atomic in_flight;
+
+		/* Start and end timestamps of ongoing or last flush */
+		env_atomic64 start;
+		env_atomic64 end;
+	} flush;
+
+	/* Per-core index of dirty cache lines, NULL if cache is detached */
+	struct ocf_dirty_index *dirty_index;
+
 	/* This bit means that core volume is initialized */
 	uint32_t has_volume : 1;
 	/* This bit means that core volume is open */
@@ -9,6 +9,16 @@
 #include "ocf/ocf.h"
 #include "ocf_env.h"
 
+/* Hint that memory at @addr is going to be read soon, env may override */
+#ifndef env_prefetch
+#define env_prefetch(addr) __builtin_prefetch(addr, 0, 3)
+#endif
+
+/* Order reads before the barrier against reads after it, env may override */
+#ifndef env_smp_rmb
+#define env_smp_rmb() __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#endif
+
 #define BYTES_TO_SECTORS(x) ((x) >> ENV_SECTOR_SHIFT)
 #define SECTORS_TO_BYTES(x) ((x) << ENV_SECTOR_SHIFT)
 
@@ -52,8 +62,13 @@
 static inline unsigned long long
 ocf_rotate_right(unsigned long long bits, unsigned shift, unsigned width)
 {
-	return ((bits >> shift) | (bits << (width - shift))) &
-		((1ULL << width) - 1);
+	unsigned long long mask = ~0ULL >> (sizeof(bits) * 8 - width);
+
+	shift %= width;
+	if (!shift)
+		return bits & mask;
+
+	return ((bits >> shift) | (bits << (width - shift))) & mask;
 }
 
 #endif
@@ -49,6 +49,13 @@ int ocf_cache_io_class_get_info(ocf_cache_t cache, uint32_t io_class,
 
 	info->cache_mode = cache->user_parts[part_id].config->cache_mode;
 
+	info->dirty = ocf_cache_is_device_attached(cache) ? env_atomic_read(
+			&cache->user_parts[part_id].watermark.dirty) : 0;
+	info->dirty_high = cache->user_parts[part_id].config->dirty_high;
+	info->dirty_low = cache->user_parts[part_id].config->dirty_low;
+	info->dirty_urgent = ocf_user_part_is_dirty_urgent(
+			&cache->user_parts[part_id]);
+
 	return 0;
 }
 
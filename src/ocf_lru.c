@@ -18,6 +18,18 @@
 
 static const ocf_cache_line_t end_marker = (ocf_cache_line_t)-1;
 
+static inline bool ocf_lru_clock(ocf_cache_t cache)
+{
+	return cache->conf_meta->replacement_policy_type ==
+			ocf_replacement_clock;
+}
+
+static inline bool ocf_lru_2q(ocf_cache_t cache)
+{
+	return cache->conf_meta->replacement_policy_type ==
+			ocf_replacement_2q;
+}
+
 /* update list last_hot index. returns pivot element (the one for which hot
  * status effectively changes during balancing). */
 static inline ocf_cache_line_t balance_update_last_hot(ocf_cache_t cache,
@@ -54,6 +66,31 @@ static inline ocf_cache_line_t balance_update_last_hot(ocf_cache_t cache,
 	return (change > 0) ? list->last_hot : last_hot_old;
 }
 
+/* Demote hot (protected) elements from the end of hot part of the list
+ * until at least 1/OCF_LRU_2Q_COLD_RATIO of the list is cold (probationary).
+ * While the cache is being filled the limit is relative to list share of
+ * cache capacity, so that lines hit early are not demoted before there is
+ * any pressure on cache space.
+ */
+static void balance_lru_list_2q(ocf_cache_t cache, struct ocf_lru_list *list)
+{
+	unsigned capacity = OCF_MAX(list->num_nodes,
+			cache->device->collision_table_entries /
+			cache->lru_lists);
+	unsigned max_hot_count = OCF_MIN(list->num_nodes,
+			capacity - capacity / OCF_LRU_2Q_COLD_RATIO);
+	struct ocf_lru_meta *node;
+
+	while (list->num_hot > max_hot_count) {
+		ENV_BUG_ON(list->last_hot == end_marker);
+
+		node = ocf_metadata_get_lru(cache, list->last_hot);
+		node->hot = false;
+		list->last_hot = node->prev;
+		--list->num_hot;
+	}
+}
+
 /* Increase / decrease number of hot elements to achieve target count.
  * Asssumes that the list has hot element clustered together at the
  * head of the list.
@@ -67,6 +104,11 @@ static void balance_lru_list(ocf_cache_t cache, struct ocf_lru_list *list)
 	if (!list->track_hot)
 		return;
 
+	if (ocf_lru_2q(cache)) {
+		balance_lru_list_2q(cache, list);
+		return;
+	}
+
 	/* 1 - update hot counter */
 	list->num_hot = target_hot_count;
 
@@ -126,10 +168,73 @@ static void add_lru_head_nobalance(ocf_cache_t cache,
 	}
 }
 
-static void add_lru_head(ocf_cache_t cache, struct ocf_lru_list *list,
-		ocf_cache_line_t collision_index)
+/* Links the given collision_index between @prev and @next list elements */
+static void add_lru_between(ocf_cache_t cache, struct ocf_lru_list *list,
+		ocf_cache_line_t collision_index, ocf_cache_line_t prev,
+		ocf_cache_line_t next)
+{
+	struct ocf_lru_meta *node;
+
+	ENV_BUG_ON(collision_index == end_marker);
+
+	node = ocf_metadata_get_lru(cache, collision_index);
+	node->prev = prev;
+	node->next = next;
+
+	if (prev != end_marker)
+		ocf_metadata_get_lru(cache, prev)->next = collision_index;
+	else
+		list->head = collision_index;
+
+	if (next != end_marker)
+		ocf_metadata_get_lru(cache, next)->prev = collision_index;
+	else
+		list->tail = collision_index;
+
+	++list->num_nodes;
+}
+
+/* Adds the given collision_index to the head of the list as hot element,
+ * 2Q only */
+static void add_lru_hot_nobalance(ocf_cache_t cache,
+		struct ocf_lru_list *list, ocf_cache_line_t collision_index)
 {
-	add_lru_head_nobalance(cache, list, collision_index);
+	add_lru_between(cache, list, collision_index, end_marker, list->head);
+
+	ocf_metadata_get_lru(cache, collision_index)->hot = true;
+	if (list->last_hot == end_marker)
+		list->last_hot = collision_index;
+	++list->num_hot;
+}
+
+/* Adds the given collision_index right behind hot elements of the list,
+ * 2Q only */
+static void add_lru_cold_nobalance(ocf_cache_t cache,
+		struct ocf_lru_list *list, ocf_cache_line_t collision_index)
+{
+	ocf_cache_line_t next = list->head;
+
+	if (list->last_hot != end_marker)
+		next = ocf_metadata_get_lru(cache, list->last_hot)->next;
+
+	add_lru_between(cache, list, collision_index, list->last_hot, next);
+
+	ocf_metadata_get_lru(cache, collision_index)->hot = false;
+}
+
+/* Adds the given collision_index to the list. With 2Q policy it is added
+ * either as hot (protected) or cold (probationary) element depending
+ * on @hot, otherwise it is added to the head of the list. */
+static void add_lru(ocf_cache_t cache, struct ocf_lru_list *list,
+		ocf_cache_line_t collision_index, bool hot)
+{
+	if (!ocf_lru_2q(cache) || !list->track_hot)
+		add_lru_head_nobalance(cache, list, collision_index);
+	else if (hot)
+		add_lru_hot_nobalance(cache, list, collision_index);
+	else
+		add_lru_cold_nobalance(cache, list, collision_index);
+
 	balance_lru_list(cache, list);
 }
 
@@ -188,7 +293,7 @@ static void remove_lru_list_nobalance(ocf_cache_t cache,
 	remove_update_ptrs(cache, list, collision_index, node);
 
 	--list->num_nodes;
-	if (node->hot)
+	if (node->hot && list->track_hot)
 		--list->num_hot;
 
 	node->next = end_marker;
@@ -203,13 +308,18 @@ void ocf_lru_remove_locked(ocf_cache_t cache, struct ocf_lru_list *list,
 	balance_lru_list(cache, list);
 }
 
+static void ocf_lru_reinsert(ocf_cache_t cache, struct ocf_lru_list *list,
+		ocf_cache_line_t cline, bool hot)
+{
+	remove_lru_list_nobalance(cache, list, cline);
+	add_lru(cache, list, cline, hot);
+}
+
 static void ocf_lru_set_hot(ocf_cache_t cache, struct ocf_lru_list *list,
 		ocf_cache_line_t cline)
 
 {
-	remove_lru_list_nobalance(cache, list, cline);
-	add_lru_head_nobalance(cache, list, cline);
-	balance_lru_list(cache, list);
+	ocf_lru_reinsert(cache, list, cline, true);
 }
 
 void ocf_lru_init_cline(ocf_cache_t cache, ocf_cache_line_t cline)
@@ -236,7 +346,7 @@ struct ocf_lru_list *ocf_lru_get_list(struct ocf_part *part,
 static inline struct ocf_lru_list *lru_get_cline_list(ocf_cache_t cache,
 		ocf_cache_line_t cline)
 {
-	uint32_t lru_list = (cline % OCF_NUM_LRU_LISTS);
+	uint32_t lru_list = ocf_cache_lru_list(cache, cline);
 	ocf_part_id_t part_id;
 	struct ocf_part *part;
 
@@ -253,20 +363,21 @@ void ocf_lru_add(ocf_cache_t cache, ocf_cache_line_t cline)
 {
 	struct ocf_lru_list *list = lru_get_cline_list(cache, cline);
 
-	add_lru_head(cache, list, cline);
+	add_lru(cache, list, cline, false);
 }
 
 static inline void ocf_lru_move(ocf_cache_t cache, ocf_cache_line_t cline,
-		struct ocf_lru_list *src_list, struct ocf_lru_list *dst_list)
+		struct ocf_lru_list *src_list, struct ocf_lru_list *dst_list,
+		bool hot)
 {
 	ocf_lru_remove_locked(cache, src_list, cline);
-	add_lru_head(cache, dst_list, cline);
+	add_lru(cache, dst_list, cline, hot);
 }
 
 static void ocf_lru_repart_locked(ocf_cache_t cache, ocf_cache_line_t cline,
-		struct ocf_part *src_part, struct ocf_part *dst_part)
+		struct ocf_part *src_part, struct ocf_part *dst_part, bool hot)
 {
-	uint32_t lru_list = (cline % OCF_NUM_LRU_LISTS);
+	uint32_t lru_list = ocf_cache_lru_list(cache, cline);
 	struct ocf_lru_list *src_list, *dst_list;
 	bool clean;
 
@@ -274,7 +385,7 @@ static void ocf_lru_repart_locked(ocf_cache_t cache, ocf_cache_line_t cline,
 	src_list = ocf_lru_get_list(src_part, lru_list, clean);
 	dst_list = ocf_lru_get_list(dst_part, lru_list, clean);
 
-	ocf_lru_move(cache, cline, src_list, dst_list);
+	ocf_lru_move(cache, cline, src_list, dst_list, hot);
 	ocf_metadata_set_partition_id(cache, cline, dst_part->id);
 	env_atomic_dec(&src_part->runtime->curr_size);
 	env_atomic_inc(&dst_part->runtime->curr_size);
@@ -283,8 +394,11 @@ static void ocf_lru_repart_locked(ocf_cache_t cache, ocf_cache_line_t cline,
 void ocf_lru_repart(ocf_cache_t cache, ocf_cache_line_t cline,
 		struct ocf_part *src_part, struct ocf_part *dst_part)
 {
+	bool hot;
+
 	OCF_METADATA_LRU_WR_LOCK(cline);
-	ocf_lru_repart_locked(cache, cline, src_part, dst_part);
+	hot = ocf_metadata_get_lru(cache, cline)->hot;
+	ocf_lru_repart_locked(cache, cline, src_part, dst_part, hot);
 	OCF_METADATA_LRU_WR_UNLOCK(cline);
 }
 
@@ -306,21 +420,24 @@ static inline void lru_iter_init(struct ocf_lru_iter *iter, ocf_cache_t cache,
 
 	/* entire iterator implementation depends on gcc builtins for
 	   bit operations which works on 64 bit integers at most */
-	ENV_BUILD_BUG_ON(OCF_NUM_LRU_LISTS > sizeof(iter->lru_idx) * 8);
+	ENV_BUILD_BUG_ON(OCF_LRU_LISTS_MAX > sizeof(iter->next_avail_lru) * 8);
 
 	iter->cache = cache;
 	iter->c = ocf_cache_line_concurrency(cache);
 	iter->part = part;
-	/* set iterator value to start_lru - 1 modulo OCF_NUM_LRU_LISTS */
-	iter->lru_idx = (start_lru + OCF_NUM_LRU_LISTS - 1) %
-			OCF_NUM_LRU_LISTS;
-	iter->num_avail_lrus = OCF_NUM_LRU_LISTS;
-	iter->next_avail_lru = ((1ULL << OCF_NUM_LRU_LISTS) - 1);
+	iter->num_lrus = cache->lru_lists;
+	/* set iterator value to start_lru - 1 modulo number of lists */
+	iter->lru_idx = (start_lru + iter->num_lrus - 1) % iter->num_lrus;
+	iter->num_avail_lrus = iter->num_lrus;
+	iter->next_avail_lru = ~0ULL >> (sizeof(iter->next_avail_lru) * 8 -
+			iter->num_lrus);
 	iter->clean = clean;
+	iter->sticky = false;
+	iter->stay = false;
 	iter->hash_locked = hash_locked;
 	iter->req = req;
 
-	for (i = 0; i < OCF_NUM_LRU_LISTS; i++)
+	for (i = 0; i < iter->num_lrus; i++)
 		iter->curr_cline[i] = ocf_lru_get_list(part, i, clean)->tail;
 }
 
@@ -351,8 +468,8 @@ static inline uint32_t _lru_next_lru(struct ocf_lru_iter *iter)
 
 	increment = __builtin_ffsll(iter->next_avail_lru);
 	iter->next_avail_lru = ocf_rotate_right(iter->next_avail_lru,
-			increment, OCF_NUM_LRU_LISTS);
-	iter->lru_idx = (iter->lru_idx + increment) % OCF_NUM_LRU_LISTS;
+			increment, iter->num_lrus);
+	iter->lru_idx = (iter->lru_idx + increment) % iter->num_lrus;
 
 	return iter->lru_idx;
 }
@@ -361,12 +478,12 @@ static inline uint32_t _lru_next_lru(struct ocf_lru_iter *iter)
 
 static inline bool _lru_lru_is_empty(struct ocf_lru_iter *iter)
 {
-	return !(iter->next_avail_lru & (1ULL << (OCF_NUM_LRU_LISTS - 1)));
+	return !(iter->next_avail_lru & (1ULL << (iter->num_lrus - 1)));
 }
 
 static inline void _lru_lru_set_empty(struct ocf_lru_iter *iter)
 {
-	iter->next_avail_lru &= ~(1ULL << (OCF_NUM_LRU_LISTS - 1));
+	iter->next_avail_lru &= ~(1ULL << (iter->num_lrus - 1));
 	iter->num_avail_lrus--;
 }
 
@@ -436,6 +553,117 @@ static bool inline _lru_iter_evition_lock(struct ocf_lru_iter *iter,
 	return true;
 }
 
+static inline uint64_t lru_ghost_hash(ocf_core_id_t core_id,
+		uint64_t core_line)
+{
+	uint64_t h = (core_line ^ ((uint64_t)core_id << 48)) *
+			0x9e3779b97f4a7c15ULL;
+
+	return h ^ (h >> 29);
+}
+
+static inline env_atomic *lru_ghost_set(struct ocf_lru_ghost *ghost,
+		uint64_t h)
+{
+	return &ghost->tags[((h >> 32) % ghost->sets_cnt) *
+			OCF_LRU_GHOST_WAYS];
+}
+
+/* Tag is never zero, which marks empty ghost entry */
+static inline int lru_ghost_tag(uint64_t h)
+{
+	return (int)((uint32_t)h | 1);
+}
+
+/* Remember core line of cacheline evicted from probation. Ghost entries are
+ * replaced randomly within a set and updated without locks, so the list is
+ * approximate - an entry may be lost or overwritten by concurrent eviction,
+ * which only makes a future ghost hit a miss. */
+static void lru_ghost_evicted(ocf_cache_t cache, struct ocf_part *part,
+		ocf_cache_line_t cline, ocf_core_id_t core_id,
+		uint64_t core_line)
+{
+	struct ocf_lru_ghost *ghost = cache->lru_ghost;
+	uint64_t h;
+
+	if (!ghost || ocf_metadata_get_lru(cache, cline)->hot)
+		return;
+
+	h = lru_ghost_hash(core_id, core_line);
+	env_atomic_set(&lru_ghost_set(ghost, h)[(h >> 16) % OCF_LRU_GHOST_WAYS],
+			lru_ghost_tag(h));
+
+	env_atomic64_inc(&cache->user_parts[part->id].lru_stats.
+			ghost_insertions);
+}
+
+/* Check whether core line was recently evicted from probation and forget
+ * it if so */
+static bool lru_ghost_hit(ocf_cache_t cache, ocf_part_id_t part_id,
+		ocf_core_id_t core_id, uint64_t core_line)
+{
+	struct ocf_lru_ghost *ghost = cache->lru_ghost;
+	uint64_t h;
+	env_atomic *set;
+	int tag, i;
+
+	if (!ghost)
+		return false;
+
+	h = lru_ghost_hash(core_id, core_line);
+	set = lru_ghost_set(ghost, h);
+	tag = lru_ghost_tag(h);
+
+	for (i = 0; i < OCF_LRU_GHOST_WAYS; i++) {
+		if (env_atomic_read(&set[i]) != tag)
+			continue;
+
+		if (env_atomic_cmpxchg(&set[i], tag, 0) != tag)
+			continue;
+
+		env_atomic64_inc(&cache->user_parts[part_id].lru_stats.
+				ghost_hits);
+		return true;
+	}
+
+	return false;
+}
+
+/* Find eviction candidate walking list from the tail. In CLOCK mode
+ * referenced cachelines get second chance - their reference bit is cleared
+ * and they are moved to the head of the list, so that each cacheline is
+ * visited at most twice. Caller must hold the lru list write lock. */
+static inline ocf_cache_line_t lru_iter_eviction_scan(struct ocf_lru_iter *iter,
+		struct ocf_lru_list *list, ocf_core_id_t *core_id,
+		uint64_t *core_line)
+{
+	ocf_cache_t cache = iter->cache;
+	bool clock = ocf_lru_clock(cache);
+	struct ocf_lru_meta *node;
+	ocf_cache_line_t cline, prev;
+
+	cline = list->tail;
+	while (cline != end_marker) {
+		node = ocf_metadata_get_lru(cache, cline);
+		prev = node->prev;
+
+		if (clock && node->hot) {
+			ocf_lru_set_hot(cache, list, cline);
+			/* cacheline at the head is unreferenced now */
+			if (prev != end_marker)
+				cline = prev;
+			continue;
+		}
+
+		if (_lru_iter_evition_lock(iter, cline, core_id, core_line))
+			break;
+
+		cline = prev;
+	}
+
+	return cline;
+}
+
 /* Get next clean cacheline from tail of lru lists. Caller must not hold any
  * lru list lock.
  * - returned cacheline is write locked
@@ -446,7 +674,7 @@ static bool inline _lru_iter_evition_lock(struct ocf_lru_iter *iter,
  * replaced cacheline.
  **/
 static inline ocf_cache_line_t lru_iter_eviction_next(struct ocf_lru_iter *iter,
-		struct ocf_part *dst_part, ocf_core_id_t *core_id,
+		struct ocf_part *dst_part, bool hot, ocf_core_id_t *core_id,
 		uint64_t *core_line)
 {
 	uint32_t curr_lru;
@@ -462,18 +690,19 @@ static inline ocf_cache_line_t lru_iter_eviction_next(struct ocf_lru_iter *iter,
 
 		list = ocf_lru_get_list(part, curr_lru, iter->clean);
 
-		cline = list->tail;
-		while (cline != end_marker && !_lru_iter_evition_lock(iter,
-				cline, core_id, core_line)) {
-			cline = ocf_metadata_get_lru(iter->cache, cline)->prev;
-		}
+		cline = lru_iter_eviction_scan(iter, list, core_id, core_line);
 
 		if (cline != end_marker) {
+			if (ocf_lru_2q(cache)) {
+				lru_ghost_evicted(cache, part, cline, *core_id,
+						*core_line);
+			}
+
 			if (dst_part != part) {
 				ocf_lru_repart_locked(cache, cline, part,
-						dst_part);
+						dst_part, hot);
 			} else {
-				ocf_lru_set_hot(cache, list, cline);
+				ocf_lru_reinsert(cache, list, cline, hot);
 			}
 		}
 
@@ -498,7 +727,7 @@ static inline ocf_cache_line_t lru_iter_eviction_next(struct ocf_lru_iter *iter,
  * replaced cacheline.
  **/
 static inline ocf_cache_line_t lru_iter_free_next(struct ocf_lru_iter *iter,
-		struct ocf_part *dst_part)
+		struct ocf_part *dst_part, bool hot)
 {
 	uint32_t curr_lru;
 	ocf_cache_line_t cline;
@@ -509,7 +738,7 @@ static inline ocf_cache_line_t lru_iter_free_next(struct ocf_lru_iter *iter,
 	ENV_BUG_ON(dst_part == free);
 
 	do {
-		curr_lru = _lru_next_lru(iter);
+		curr_lru = iter->stay ? iter->lru_idx : _lru_next_lru(iter);
 
 		ocf_metadata_lru_wr_lock(&cache->metadata.lock, curr_lru);
 
@@ -522,12 +751,15 @@ static inline ocf_cache_line_t lru_iter_free_next(struct ocf_lru_iter *iter,
 		}
 
 		if (cline != end_marker) {
-			ocf_lru_repart_locked(cache, cline, free, dst_part);
+			ocf_lru_repart_locked(cache, cline, free, dst_part,
+					hot);
 		}
 
 		ocf_metadata_lru_wr_unlock(&cache->metadata.lock,
 				curr_lru);
 
+		iter->stay = iter->sticky && cline != end_marker;
+
 		if (cline == end_marker && !_lru_lru_is_empty(iter)) {
 			/* mark list as empty */
 			_lru_lru_set_empty(iter);
@@ -570,6 +802,8 @@ static inline ocf_cache_line_t lru_iter_cleaning_next(struct ocf_lru_iter *iter)
 static void ocf_lru_clean_end(void *private_data, int error)
 {
 	struct ocf_part_cleaning_ctx *ctx = private_data;
+	ocf_lru_clean_end_t cmpl = ctx->cmpl;
+	void *priv = ctx->priv;
 	unsigned i;
 
 	for (i = 0; i < OCF_EVICTION_CLEAN_SIZE; i++) {
@@ -579,6 +813,9 @@ static void ocf_lru_clean_end(void *private_data, int error)
 	}
 
 	ocf_refcnt_dec(&ctx->counter);
+
+	if (cmpl)
+		cmpl(priv, error);
 }
 
 static int ocf_lru_clean_get(ocf_cache_t cache, void *getter_context,
@@ -594,8 +831,9 @@ static int ocf_lru_clean_get(ocf_cache_t cache, void *getter_context,
 	return 0;
 }
 
-void ocf_lru_clean(ocf_cache_t cache, struct ocf_user_part *user_part,
-		ocf_queue_t io_queue, uint32_t count)
+static uint32_t _ocf_lru_clean(ocf_cache_t cache,
+		struct ocf_user_part *user_part, ocf_queue_t io_queue,
+		uint32_t count, ocf_lru_clean_end_t cmpl, void *priv)
 {
 	struct ocf_part_cleaning_ctx *ctx = &user_part->cleaning;
 	struct ocf_cleaner_attribs attribs = {
@@ -620,22 +858,22 @@ void ocf_lru_clean(ocf_cache_t cache, struct ocf_user_part *user_part,
 	unsigned i;
 	unsigned lock_idx;
 
-	if (ocf_mngt_cache_is_locked(cache))
-		return;
 	cnt = ocf_refcnt_inc(&ctx->counter);
 	if (!cnt) {
 		/* cleaner disabled by management operation */
-		return;
+		return 0;
 	}
 
 	if (cnt > 1) {
 		/* cleaning already running for this partition */
 		ocf_refcnt_dec(&ctx->counter);
-		return;
+		return 0;
 	}
 
 	ctx->cache = cache;
-	lru_idx = io_queue->lru_idx++ % OCF_NUM_LRU_LISTS;
+	ctx->cmpl = cmpl;
+	ctx->priv = priv;
+	lru_idx = io_queue->lru_idx++ % cache->lru_lists;
 
 	lock_idx = ocf_metadata_concurrency_next_idx(io_queue);
 	ocf_metadata_start_shared_access(&cache->metadata.lock, lock_idx);
@@ -650,6 +888,7 @@ void ocf_lru_clean(ocf_cache_t cache, struct ocf_user_part *user_part,
 			break;
 		i++;
 	}
+	cnt = i;
 	while (i < OCF_EVICTION_CLEAN_SIZE)
 		cline[i++] = end_marker;
 
@@ -657,7 +896,31 @@ void ocf_lru_clean(ocf_cache_t cache, struct ocf_user_part *user_part,
 
 	ocf_metadata_end_shared_access(&cache->metadata.lock, lock_idx);
 
+	if (!cnt) {
+		/* no dirty cache line available for cleaning */
+		ocf_refcnt_dec(&ctx->counter);
+		return 0;
+	}
+
 	ocf_cleaner_fire(cache, &attribs);
+
+	return cnt;
+}
+
+void ocf_lru_clean(ocf_cache_t cache, struct ocf_user_part *user_part,
+		ocf_queue_t io_queue, uint32_t count)
+{
+	if (ocf_mngt_cache_is_locked(cache))
+		return;
+
+	_ocf_lru_clean(cache, user_part, io_queue, count, NULL, NULL);
+}
+
+uint32_t ocf_lru_clean_part(ocf_cache_t cache, struct ocf_user_part *user_part,
+		ocf_queue_t io_queue, ocf_lru_clean_end_t cmpl, void *priv)
+{
+	return _ocf_lru_clean(cache, user_part, io_queue,
+			OCF_EVICTION_CLEAN_SIZE, cmpl, priv);
 }
 
 static void ocf_lru_invalidate(ocf_cache_t cache, ocf_cache_line_t cline,
@@ -701,6 +964,7 @@ uint32_t ocf_lru_req_clines(struct ocf_request *req,
 	unsigned lru_idx;
 	unsigned req_idx = 0;
 	struct ocf_part *dst_part;
+	bool hot;
 
 
 	if (cline_no == 0)
@@ -717,17 +981,37 @@ uint32_t ocf_lru_req_clines(struct ocf_request *req,
 	ENV_BUG_ON(req->part_id == PARTITION_FREELIST);
 	dst_part = &cache->user_parts[req->part_id].part;
 
-	lru_idx = req->io_queue->lru_idx++ % OCF_NUM_LRU_LISTS;
-
-	lru_iter_eviction_init(&iter, cache, src_part, lru_idx, req);
+	if (cache->lru_queue_affinity && src_part->id == PARTITION_FREELIST) {
+		/* Take free cachelines from queue home list as long as there
+		 * are any, so that cachelines inserted by the queue end up
+		 * on the same lru list */
+		lru_idx = req->io_queue->lru_home % cache->lru_lists;
+		lru_iter_eviction_init(&iter, cache, src_part, lru_idx, req);
+		iter.sticky = true;
+	} else {
+		lru_idx = req->io_queue->lru_idx++ % cache->lru_lists;
+		lru_iter_eviction_init(&iter, cache, src_part, lru_idx, req);
+	}
 
 	i = 0;
 	while (i < cline_no) {
+		/* find next unmapped cacheline in request */
+		while (req_idx + 1 < req->core_line_count &&
+				req->map[req_idx].status != LOOKUP_MISS) {
+			req_idx++;
+		}
+
+		ENV_BUG_ON(req->map[req_idx].status != LOOKUP_MISS);
+
+		hot = ocf_lru_2q(cache) && lru_ghost_hit(cache, req->part_id,
+				ocf_core_get_id(req->core),
+				req->core_line_first + req_idx);
+
 		if (src_part->id != PARTITION_FREELIST) {
-			cline = lru_iter_eviction_next(&iter, dst_part, &core_id,
-					&core_line);
+			cline = lru_iter_eviction_next(&iter, dst_part, hot,
+					&core_id, &core_line);
 		} else {
-			cline = lru_iter_free_next(&iter, dst_part);
+			cline = lru_iter_free_next(&iter, dst_part, hot);
 		}
 
 		if (cline == end_marker)
@@ -738,14 +1022,6 @@ uint32_t ocf_lru_req_clines(struct ocf_request *req,
 		/* TODO: if atomic mode is restored, need to zero metadata
 		 * before proceeding with cleaning (see version <= 20.12) */
 
-		/* find next unmapped cacheline in request */
-		while (req_idx + 1 < req->core_line_count &&
-				req->map[req_idx].status != LOOKUP_MISS) {
-			req_idx++;
-		}
-
-		ENV_BUG_ON(req->map[req_idx].status != LOOKUP_MISS);
-
 		if (src_part->id != PARTITION_FREELIST) {
 			ocf_lru_invalidate(cache, cline, core_id, src_part->id);
 			_lru_unlock_hash(&iter, core_id, core_line);
@@ -753,6 +1029,11 @@ uint32_t ocf_lru_req_clines(struct ocf_request *req,
 
 		ocf_map_cache_line(req, req_idx, cline);
 
+		if (ocf_lru_2q(cache)) {
+			env_atomic64_inc(&cache->user_parts[req->part_id].
+					lru_stats.insertions);
+		}
+
 		req->map[req_idx].status = LOOKUP_REMAPPED;
 		ocf_engine_patch_req_info(cache, req, req_idx);
 
@@ -773,7 +1054,7 @@ uint32_t ocf_lru_req_clines(struct ocf_request *req,
 /* the caller must hold the metadata lock */
 void ocf_lru_hot_cline(ocf_cache_t cache, ocf_cache_line_t cline)
 {
-	const uint32_t lru_list = (cline % OCF_NUM_LRU_LISTS);
+	const uint32_t lru_list = ocf_cache_lru_list(cache, cline);
 	struct ocf_lru_meta *node;
 	struct ocf_lru_list *list;
 	ocf_part_id_t part_id;
@@ -783,6 +1064,15 @@ void ocf_lru_hot_cline(ocf_cache_t cache, ocf_cache_line_t cline)
 
 	node = ocf_metadata_get_lru(cache, cline);
 
+	if (ocf_lru_clock(cache)) {
+		/* Only set reference bit, no need to take lru list lock.
+		 * Racing with list update may lose the bit, which costs
+		 * at most premature eviction of the cacheline. */
+		if (!node->hot)
+			node->hot = true;
+		return;
+	}
+
 	OCF_METADATA_LRU_RD_LOCK(cline);
 	hot = node->hot;
 	OCF_METADATA_LRU_RD_UNLOCK(cline);
@@ -804,6 +1094,11 @@ void ocf_lru_hot_cline(ocf_cache_t cache, ocf_cache_line_t cline)
 	ocf_lru_set_hot(cache, list, cline);
 
 	OCF_METADATA_LRU_WR_UNLOCK(cline);
+
+	if (ocf_lru_2q(cache)) {
+		env_atomic64_inc(&cache->user_parts[part_id].lru_stats.
+				promotions);
+	}
 }
 
 static inline void _lru_init(struct ocf_lru_list *list, bool track_hot)
@@ -822,15 +1117,16 @@ void ocf_lru_init(ocf_cache_t cache, struct ocf_part *part)
 	struct ocf_lru_list *dirty_list;
 	uint32_t i;
 
-	for (i = 0; i < OCF_NUM_LRU_LISTS; i++) {
+	for (i = 0; i < OCF_LRU_LISTS_MAX; i++) {
 		clean_list = ocf_lru_get_list(part, i, true);
 		dirty_list = ocf_lru_get_list(part, i, false);
 
 		if (part->id == PARTITION_FREELIST) {
 			_lru_init(clean_list, false);
 		} else {
-			_lru_init(clean_list, true);
-			_lru_init(dirty_list, true);
+			/* CLOCK keeps reference bits instead of hot elements */
+			_lru_init(clean_list, !ocf_lru_clock(cache));
+			_lru_init(dirty_list, !ocf_lru_clock(cache));
 		}
 	}
 
@@ -840,32 +1136,36 @@ void ocf_lru_init(ocf_cache_t cache, struct ocf_part *part)
 void ocf_lru_clean_cline(ocf_cache_t cache, struct ocf_part *part,
 		ocf_cache_line_t cline)
 {
-	uint32_t lru_list = (cline % OCF_NUM_LRU_LISTS);
+	uint32_t lru_list = ocf_cache_lru_list(cache, cline);
 	struct ocf_lru_list *clean_list;
 	struct ocf_lru_list *dirty_list;
+	bool hot;
 
 	clean_list = ocf_lru_get_list(part, lru_list, true);
 	dirty_list = ocf_lru_get_list(part, lru_list, false);
 
 	OCF_METADATA_LRU_WR_LOCK(cline);
+	hot = ocf_metadata_get_lru(cache, cline)->hot;
 	ocf_lru_remove_locked(cache, dirty_list, cline);
-	add_lru_head(cache, clean_list, cline);
+	add_lru(cache, clean_list, cline, hot);
 	OCF_METADATA_LRU_WR_UNLOCK(cline);
 }
 
 void ocf_lru_dirty_cline(ocf_cache_t cache, struct ocf_part *part,
 		ocf_cache_line_t cline)
 {
-	uint32_t lru_list = (cline % OCF_NUM_LRU_LISTS);
+	uint32_t lru_list = ocf_cache_lru_list(cache, cline);
 	struct ocf_lru_list *clean_list;
 	struct ocf_lru_list *dirty_list;
+	bool hot;
 
 	clean_list = ocf_lru_get_list(part, lru_list, true);
 	dirty_list = ocf_lru_get_list(part, lru_list, false);
 
 	OCF_METADATA_LRU_WR_LOCK(cline);
+	hot = ocf_metadata_get_lru(cache, cline)->hot;
 	ocf_lru_remove_locked(cache, clean_list, cline);
-	add_lru_head(cache, dirty_list, cline);
+	add_lru(cache, dirty_list, cline, hot);
 	OCF_METADATA_LRU_WR_UNLOCK(cline);
 }
 
@@ -939,7 +1239,7 @@ void ocf_lru_populate(ocf_cache_t cache,
 	ocf_parallelize_t parallelize;
 	int result;
 
-	result = ocf_parallelize_create(&parallelize, cache, OCF_NUM_LRU_LISTS,
+	result = ocf_parallelize_create(&parallelize, cache, cache->lru_lists,
 			sizeof(*context), ocf_lru_populate_handle,
 			ocf_lru_populate_finish);
 	if (result) {
@@ -1027,7 +1327,7 @@ int ocf_metadata_actor(struct ocf_cache *cache,
 	ENV_BUG_ON(part_id == PARTITION_FREELIST);
 	part = &cache->user_parts[part_id].part;
 
-	for (i = 0; i < OCF_NUM_LRU_LISTS; i++) {
+	for (i = 0; i < cache->lru_lists; i++) {
 		for (clean = 0; clean <= 1; clean++) {
 			list = ocf_lru_get_list(part, i, clean);
 
@@ -1053,6 +1353,47 @@ int ocf_metadata_actor(struct ocf_cache *cache,
 	return ret;
 }
 
+int ocf_lru_ghost_init(ocf_cache_t cache)
+{
+	struct ocf_lru_ghost *ghost;
+	uint64_t entries;
+
+	if (!ocf_lru_2q(cache))
+		return 0;
+
+	ghost = env_vzalloc(sizeof(*ghost));
+	if (!ghost)
+		return -OCF_ERR_NO_MEM;
+
+	entries = ocf_metadata_collision_table_entries(cache) /
+			OCF_LRU_GHOST_RATIO;
+	ghost->sets_cnt = OCF_DIV_ROUND_UP(entries, OCF_LRU_GHOST_WAYS) ?: 1;
+
+	ghost->tags = env_vzalloc((uint64_t)ghost->sets_cnt *
+			OCF_LRU_GHOST_WAYS * sizeof(*ghost->tags));
+	if (!ghost->tags) {
+		env_vfree(ghost);
+		return -OCF_ERR_NO_MEM;
+	}
+
+	cache->lru_ghost = ghost;
+
+	return 0;
+}
+
+void ocf_lru_ghost_deinit(ocf_cache_t cache)
+{
+	struct ocf_lru_ghost *ghost = cache->lru_ghost;
+
+	if (!ghost)
+		return;
+
+	cache->lru_ghost = NULL;
+
+	env_vfree(ghost->tags);
+	env_vfree(ghost);
+}
+
 uint32_t ocf_lru_num_free(ocf_cache_t cache)
 {
 	return env_atomic_read(&cache->free.runtime->curr_size);
@@ -1060,7 +1401,7 @@ uint32_t ocf_lru_num_free(ocf_cache_t cache)
 
 void ocf_lru_add_free(ocf_cache_t cache, ocf_cache_line_t cline)
 {
-	uint32_t lru_list = (cline % OCF_NUM_LRU_LISTS);
+	uint32_t lru_list = ocf_cache_lru_list(cache, cline);
 	struct ocf_lru_list *list;
 
 	list = ocf_lru_get_list(&cache->free, lru_list, true);
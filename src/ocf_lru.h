@@ -28,10 +28,14 @@ void ocf_lru_clean_cline(struct ocf_cache *cache, struct ocf_part *part,
 		ocf_cache_line_t cline);
 void ocf_lru_clean(ocf_cache_t cache, struct ocf_user_part *user_part,
 		ocf_queue_t io_queue, uint32_t count);
+uint32_t ocf_lru_clean_part(ocf_cache_t cache, struct ocf_user_part *user_part,
+		ocf_queue_t io_queue, ocf_lru_clean_end_t cmpl, void *priv);
 void ocf_lru_repart(ocf_cache_t cache, ocf_cache_line_t cline,
 		struct ocf_part *src_upart, struct ocf_part *dst_upart);
 void ocf_lru_add_free(ocf_cache_t cache, ocf_cache_line_t cline);
 uint32_t ocf_lru_num_free(ocf_cache_t cache);
+int ocf_lru_ghost_init(ocf_cache_t cache);
+void ocf_lru_ghost_deinit(ocf_cache_t cache);
 struct ocf_lru_list *ocf_lru_get_list(struct ocf_part *part,
 		uint32_t lru_idx, bool clean);
 void ocf_lru_remove_locked(ocf_cache_t cache, struct ocf_lru_list *list,
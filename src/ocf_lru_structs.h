@@ -10,6 +10,8 @@ struct ocf_lru_meta {
 	uint32_t prev;
 	uint32_t next;
 	uint8_t hot;
+		/*!< Hot flag of LRU list, reference bit of CLOCK or
+		 * protected flag of 2Q */
 } __attribute__((packed));
 
 struct ocf_lru_list {
@@ -26,6 +28,27 @@ struct ocf_lru_part_meta {
 	struct ocf_lru_list dirty;
 };
 
+struct ocf_lru_part_stats {
+	env_atomic64 insertions;
+	env_atomic64 ghost_hits;
+	env_atomic64 ghost_insertions;
+	env_atomic64 promotions;
+};
+
+struct ocf_lru_ghost {
+	env_atomic *tags;
+	uint32_t sets_cnt;
+};
+
+typedef void (*ocf_lru_clean_end_t)(void *priv, int error);
+
 #define OCF_LRU_HOT_RATIO 2
 
+/* 2Q keeps at least 1/OCF_LRU_2Q_COLD_RATIO of each list in probation */
+#define OCF_LRU_2Q_COLD_RATIO 4
+
+/* Ghost list remembers up to 1/OCF_LRU_GHOST_RATIO of cache lines */
+#define OCF_LRU_GHOST_RATIO 2
+#define OCF_LRU_GHOST_WAYS 4
+
 #endif
@@ -13,8 +13,30 @@
 #include "engine/cache_engine.h"
 #include "ocf_def_priv.h"
 
-int ocf_queue_create(ocf_cache_t cache, ocf_queue_t *queue,
-		const struct ocf_queue_ops *ops)
+/* Lowest lru home not used by any live queue, so that lru lists stay
+ * evenly spread across queues also after some of them were removed */
+static unsigned _ocf_queue_free_lru_home(ocf_cache_t cache)
+{
+	ocf_queue_t queue;
+	unsigned lru_home = 0;
+	bool used;
+
+	do {
+		used = false;
+		list_for_each_entry(queue, &cache->io_queues, list) {
+			if (queue->lru_home == lru_home) {
+				used = true;
+				lru_home++;
+				break;
+			}
+		}
+	} while (used);
+
+	return lru_home;
+}
+
+static int _ocf_queue_create(ocf_cache_t cache, ocf_queue_t *queue,
+		const struct ocf_queue_ops *ops, bool lockless)
 {
 	ocf_queue_t tmp_queue;
 	int result;
@@ -40,6 +62,9 @@ int ocf_queue_create(ocf_cache_t cache, ocf_queue_t *queue,
 	}
 
 	INIT_LIST_HEAD(&tmp_queue->io_list);
+	ocf_mpsc_init(&tmp_queue->io_mpsc);
+	ocf_mpsc_init(&tmp_queue->io_mpsc_prio);
+	tmp_queue->lockless = lockless;
 	env_atomic_set(&tmp_queue->ref_count, 1);
 	tmp_queue->cache = cache;
 	tmp_queue->ops = ops;
@@ -51,6 +76,15 @@ int ocf_queue_create(ocf_cache_t cache, ocf_queue_t *queue,
 		return result;
 	}
 
+	result = ocf_req_cache_init(tmp_queue);
+	if (result) {
+		ocf_queue_seq_cutoff_deinit(tmp_queue);
+		ocf_mngt_cache_put(cache);
+		env_free(tmp_queue);
+		return result;
+	}
+
+	tmp_queue->lru_home = _ocf_queue_free_lru_home(cache);
 	list_add(&tmp_queue->list, &cache->io_queues);
 
 	*queue = tmp_queue;
@@ -58,6 +92,18 @@ int ocf_queue_create(ocf_cache_t cache, ocf_queue_t *queue,
 	return 0;
 }
 
+int ocf_queue_create(ocf_cache_t cache, ocf_queue_t *queue,
+		const struct ocf_queue_ops *ops)
+{
+	return _ocf_queue_create(cache, queue, ops, false);
+}
+
+int ocf_queue_create_lockless(ocf_cache_t cache, ocf_queue_t *queue,
+		const struct ocf_queue_ops *ops)
+{
+	return _ocf_queue_create(cache, queue, ops, true);
+}
+
 void ocf_queue_get(ocf_queue_t queue)
 {
 	OCF_CHECK_NULL(queue);
@@ -73,6 +119,7 @@ void ocf_queue_put(ocf_queue_t queue)
 		list_del(&queue->list);
 		queue->ops->stop(queue);
 		ocf_queue_seq_cutoff_deinit(queue);
+		ocf_req_cache_deinit(queue);
 		ocf_mngt_cache_put(queue->cache);
 		env_spinlock_destroy(&queue->io_list_lock);
 		env_free(queue);
@@ -88,6 +135,14 @@ void ocf_io_handle(struct ocf_io *io, void *opaque)
 	req->engine_handler(req);
 }
 
+static inline void ocf_queue_run_req(struct ocf_request *io_req)
+{
+	if (io_req->ioi.io.handle)
+		io_req->ioi.io.handle(&io_req->ioi.io, io_req);
+	else
+		ocf_io_handle(&io_req->ioi.io, io_req);
+}
+
 void ocf_queue_run_single(ocf_queue_t q)
 {
 	struct ocf_request *io_req = NULL;
@@ -99,10 +154,31 @@ void ocf_queue_run_single(ocf_queue_t q)
 	if (!io_req)
 		return;
 
-	if (io_req->ioi.io.handle)
-		io_req->ioi.io.handle(&io_req->ioi.io, io_req);
-	else
-		ocf_io_handle(&io_req->ioi.io, io_req);
+	ocf_queue_run_req(io_req);
+}
+
+uint32_t ocf_queue_run_batch(ocf_queue_t q, uint32_t max)
+{
+	struct ocf_request *io_req;
+	struct list_head batch;
+	uint32_t count;
+
+	OCF_CHECK_NULL(q);
+
+	INIT_LIST_HEAD(&batch);
+
+	count = ocf_engine_pop_reqs(q, &batch, max);
+
+	/* Request handler may push the request back to the queue, so detach
+	 * it from the private list before handling */
+	while (!list_empty(&batch)) {
+		io_req = list_first_entry(&batch, struct ocf_request, list);
+		list_del(&io_req->list);
+
+		ocf_queue_run_req(io_req);
+	}
+
+	return count;
 }
 
 void ocf_queue_run(ocf_queue_t q)
@@ -130,6 +206,20 @@ void *ocf_queue_get_priv(ocf_queue_t q)
 	return q->priv;
 }
 
+void ocf_queue_get_req_cache_stats(ocf_queue_t q,
+		struct ocf_queue_req_cache_stats *stats)
+{
+	OCF_CHECK_NULL(q);
+	OCF_CHECK_NULL(stats);
+
+	env_spinlock_lock(&q->req_cache.lock);
+	stats->alloc_hits = q->req_cache.alloc_hits;
+	stats->alloc_misses = q->req_cache.alloc_misses;
+	stats->free_hits = q->req_cache.free_hits;
+	stats->free_misses = q->req_cache.free_misses;
+	env_spinlock_unlock(&q->req_cache.lock);
+}
+
 uint32_t ocf_queue_pending_io(ocf_queue_t q)
 {
 	OCF_CHECK_NULL(q);
@@ -7,6 +7,25 @@
 #define OCF_QUEUE_PRIV_H_
 
 #include "ocf_env.h"
+#include "utils/utils_mpsc.h"
+
+/* Number of request allocator size classes cached per queue */
+#define OCF_QUEUE_REQ_CACHE_CLASSES 8
+
+/* Maximum number of free requests of single size class cached per queue */
+#define OCF_QUEUE_REQ_CACHE_DEPTH 32
+
+struct ocf_queue_req_cache {
+	env_spinlock lock;
+
+	uint32_t count[OCF_QUEUE_REQ_CACHE_CLASSES];
+	void *reqs[OCF_QUEUE_REQ_CACHE_CLASSES][OCF_QUEUE_REQ_CACHE_DEPTH];
+
+	uint64_t alloc_hits;
+	uint64_t alloc_misses;
+	uint64_t free_hits;
+	uint64_t free_misses;
+};
 
 struct ocf_queue {
 	ocf_cache_t cache;
@@ -15,14 +34,26 @@ struct ocf_queue {
 
 	struct list_head io_list;
 
+	/* lock-free request lists used instead of io_list by lockless queue,
+	 * prio list is used by requests pushed to front */
+	struct ocf_mpsc io_mpsc;
+	struct ocf_mpsc io_mpsc_prio;
+	bool lockless;
+
 	/* per-queue free running global metadata lock index */
 	unsigned lock_idx;
 
 	/* per-queue free running lru list index */
 	unsigned lru_idx;
 
+	/* lru list to allocate free cachelines from with lru queue affinity */
+	unsigned lru_home;
+
 	struct ocf_seq_cutoff *seq_cutoff;
 
+	/* free requests returned to this queue, reused by ocf_req_new() */
+	struct ocf_queue_req_cache req_cache;
+
 	struct list_head list;
 
 	const struct ocf_queue_ops *ops;
@@ -6,6 +6,7 @@
 #include "ocf/ocf.h"
 #include "ocf_request.h"
 #include "ocf_cache_priv.h"
+#include "ocf_queue_priv.h"
 #include "concurrency/ocf_metadata_concurrency.h"
 #include "utils/utils_cache_line.h"
 
@@ -57,12 +58,30 @@ static inline size_t ocf_req_sizeof_alock_status(uint32_t lines)
 	return OCF_DIV_ROUND_UP(size, sizeof(long)) * sizeof(long);
 }
 
+static inline size_t ocf_req_sizeof_header(void)
+{
+	return sizeof(struct ocf_request) + ocf_req_sizeof_alock_status(
+			(1U << (unsigned)ocf_req_size_128));
+}
+
+/* Allocator size class, which is number of map entries rounded up to
+ * power of two */
+static inline enum ocf_req_size ocf_req_size_class(uint32_t lines)
+{
+	unsigned idx = 31 - __builtin_clz(lines);
+
+	if (lines & (lines - 1))
+		idx++;
+
+	return idx;
+}
+
 int ocf_req_allocator_init(struct ocf_ctx *ocf_ctx)
 {
 	enum ocf_req_size max_req_size = ocf_req_size_128;
-	size_t alock_status_size = ocf_req_sizeof_alock_status(
-			(1U << (unsigned)max_req_size));
-	size_t header_size = sizeof(struct ocf_request) + alock_status_size;
+	size_t header_size = ocf_req_sizeof_header();
+
+	ENV_BUILD_BUG_ON(ocf_req_size_128 >= OCF_QUEUE_REQ_CACHE_CLASSES);
 
 	ocf_ctx->resources.req = env_mpool_create(header_size,
 		sizeof(struct ocf_map_info), ENV_MEM_NORMAL, max_req_size,
@@ -80,6 +99,86 @@ void ocf_req_allocator_deinit(struct ocf_ctx *ocf_ctx)
 	ocf_ctx->resources.req = NULL;
 }
 
+int ocf_req_cache_init(ocf_queue_t queue)
+{
+	struct ocf_queue_req_cache *req_cache = &queue->req_cache;
+
+	ENV_BUG_ON(env_memset(req_cache, sizeof(*req_cache), 0));
+
+	return env_spinlock_init(&req_cache->lock);
+}
+
+void ocf_req_cache_deinit(ocf_queue_t queue)
+{
+	struct ocf_queue_req_cache *req_cache = &queue->req_cache;
+	struct env_mpool *mpool = queue->cache->owner->resources.req;
+	unsigned size, i;
+
+	for (size = 0; size < OCF_QUEUE_REQ_CACHE_CLASSES; size++) {
+		for (i = 0; i < req_cache->count[size]; i++) {
+			env_mpool_del(mpool, req_cache->reqs[size][i],
+					1U << size);
+		}
+		req_cache->count[size] = 0;
+	}
+
+	env_spinlock_destroy(&req_cache->lock);
+}
+
+/*
+ * Take request of given size class from queue's cache of free requests.
+ * Only part of the request used for @lines long mapping is zeroed, which is
+ * what the request allocator would provide.
+ */
+static struct ocf_request *ocf_req_cache_get(ocf_queue_t queue,
+		uint32_t lines)
+{
+	struct ocf_queue_req_cache *req_cache = &queue->req_cache;
+	enum ocf_req_size size = ocf_req_size_class(lines);
+	struct ocf_request *req = NULL;
+
+	if (size > ocf_req_size_128)
+		return NULL;
+
+	env_spinlock_lock(&req_cache->lock);
+	if (req_cache->count[size]) {
+		req = req_cache->reqs[size][--req_cache->count[size]];
+		req_cache->alloc_hits++;
+	} else {
+		req_cache->alloc_misses++;
+	}
+	env_spinlock_unlock(&req_cache->lock);
+
+	if (req) {
+		ENV_BUG_ON(env_memset(req, sizeof(*req) +
+				lines * sizeof(struct ocf_map_info) +
+				ocf_req_sizeof_alock_status(lines), 0));
+	}
+
+	return req;
+}
+
+static void ocf_req_cache_put(ocf_queue_t queue, struct ocf_request *req,
+		uint32_t lines)
+{
+	struct ocf_queue_req_cache *req_cache = &queue->req_cache;
+	enum ocf_req_size size = ocf_req_size_class(lines);
+	bool cached = false;
+
+	env_spinlock_lock(&req_cache->lock);
+	if (req_cache->count[size] < OCF_QUEUE_REQ_CACHE_DEPTH) {
+		req_cache->reqs[size][req_cache->count[size]++] = req;
+		req_cache->free_hits++;
+		cached = true;
+	} else {
+		req_cache->free_misses++;
+	}
+	env_spinlock_unlock(&req_cache->lock);
+
+	if (!cached)
+		env_mpool_del(queue->cache->owner->resources.req, req, lines);
+}
+
 struct ocf_request *ocf_req_new(ocf_queue_t queue, ocf_core_t core,
 		uint64_t addr, uint32_t bytes, int rw)
 {
@@ -98,11 +197,15 @@ struct ocf_request *ocf_req_new(ocf_queue_t queue, ocf_core_t core,
 		core_line_count = 1;
 	}
 
-	req = env_mpool_new(cache->owner->resources.req, core_line_count);
+	req = ocf_req_cache_get(queue, core_line_count);
+	if (!req)
+		req = env_mpool_new(cache->owner->resources.req, core_line_count);
 	if (!req) {
 		map_allocated = false;
-		req = env_mpool_new(cache->owner->resources.req, 1);
+		req = ocf_req_cache_get(queue, 1);
 	}
+	if (!req)
+		req = env_mpool_new(cache->owner->resources.req, 1);
 
 	if (unlikely(!req))
 		return NULL;
@@ -235,8 +338,7 @@ void ocf_req_put(struct ocf_request *req)
 	if (req->map != req->__map)
 		env_free(req->map);
 
-	env_mpool_del(req->cache->owner->resources.req, req,
-			req->alloc_core_line_count);
+	ocf_req_cache_put(queue, req, req->alloc_core_line_count);
 
 	ocf_queue_put(queue);
 }
@@ -11,6 +11,7 @@
 #include "ocf_io_priv.h"
 #include "engine/cache_engine.h"
 #include "metadata/metadata_structs.h"
+#include "utils/utils_mpsc.h"
 
 struct ocf_req_allocator;
 
@@ -43,6 +44,9 @@ struct ocf_req_info {
 	uint32_t cleaner_cache_line_lock : 1;
 	/*!< Cleaner flag - acquire cache line lock */
 
+	uint32_t cleaner_pipeline : 1;
+	/*!< Cleaner flag - request data is accounted in memory budget */
+
 	uint32_t internal : 1;
 	/**!< this is an internal request */
 };
@@ -209,8 +213,13 @@ struct ocf_request {
 	ocf_queue_t io_queue;
 	/*!< I/O queue handle for which request should be submitted */
 
-	struct list_head list;
-	/*!< List item for OCF IO thread workers */
+	union {
+		struct list_head list;
+		/*!< List item for OCF IO thread workers */
+
+		struct ocf_mpsc_node mpsc_node;
+		/*!< Lock-free list item for OCF IO thread workers */
+	};
 
 	struct ocf_req_info info;
 	/*!< Detailed request info */
@@ -248,6 +257,21 @@ int ocf_req_allocator_init(struct ocf_ctx *ocf_ctx);
  */
 void ocf_req_allocator_deinit(struct ocf_ctx *ocf_ctx);
 
+/**
+ * @brief Initialize I/O queue cache of free requests
+ *
+ * @param queue - I/O queue handle
+ * @return Operation status 0 - successful, non-zero failure
+ */
+int ocf_req_cache_init(ocf_queue_t queue);
+
+/**
+ * @brief Return all requests cached in I/O queue to request allocator
+ *
+ * @param queue - I/O queue handle
+ */
+void ocf_req_cache_deinit(ocf_queue_t queue);
+
 /**
  * @brief Allocate new OCF request
  *
@@ -206,6 +206,7 @@ void ocf_core_stats_initialize(ocf_core_t core)
 int ocf_core_stats_initialize_all(ocf_cache_t cache)
 {
 	ocf_core_id_t id;
+	ocf_part_id_t part_id;
 
 	if (ocf_cache_is_standby(cache))
 		return -OCF_ERR_CACHE_STANDBY;
@@ -217,6 +218,26 @@ int ocf_core_stats_initialize_all(ocf_cache_t cache)
 		ocf_core_stats_initialize(&cache->core[id]);
 	}
 
+	for (part_id = 0; part_id < OCF_USER_IO_CLASS_MAX; part_id++) {
+		ENV_BUG_ON(env_memset(&cache->user_parts[part_id].lru_stats,
+				sizeof(cache->user_parts[part_id].lru_stats),
+				0));
+	}
+
+	ENV_BUG_ON(env_memset(&cache->cleaner.stats,
+			sizeof(cache->cleaner.stats), 0));
+
+	for (id = 0; id < OCF_METADATA_GLOBAL_LOCKS_MAX; id++) {
+		struct ocf_metadata_global_lock *lock =
+				&cache->metadata.lock.global[id];
+
+		ENV_BUG_ON(env_memset(&lock->stats, sizeof(lock->stats), 0));
+		ENV_BUG_ON(env_memset(&lock->hash_stats,
+				sizeof(lock->hash_stats), 0));
+		env_atomic64_set(&lock->optimistic_reads, 0);
+		env_atomic64_set(&lock->optimistic_retries, 0);
+	}
+
 	return 0;
 }
 
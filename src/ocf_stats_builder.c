@@ -11,6 +11,7 @@
 #include "utils/utils_user_part.h"
 #include "utils/utils_cache_line.h"
 #include "utils/utils_stats.h"
+#include "cleaning/alru.h"
 
 static void _fill_req(struct ocf_stats_requests *req, struct ocf_stats_core *s)
 {
@@ -314,6 +315,141 @@ int ocf_stats_collect_part_cache(ocf_cache_t cache, ocf_part_id_t part_id,
 	return result;
 }
 
+int ocf_stats_collect_part_replacement(ocf_cache_t cache,
+		ocf_part_id_t part_id, struct ocf_stats_replacement *stats)
+{
+	struct ocf_lru_part_stats *lru_stats;
+
+	OCF_CHECK_NULL(cache);
+	OCF_CHECK_NULL(stats);
+
+	if (ocf_cache_is_standby(cache))
+		return -OCF_ERR_CACHE_STANDBY;
+
+	if (part_id > OCF_IO_CLASS_ID_MAX)
+		return -OCF_ERR_INVAL;
+
+	lru_stats = &cache->user_parts[part_id].lru_stats;
+
+	stats->insertions = env_atomic64_read(&lru_stats->insertions);
+	stats->ghost_hits = env_atomic64_read(&lru_stats->ghost_hits);
+	stats->ghost_insertions = env_atomic64_read(
+			&lru_stats->ghost_insertions);
+	stats->promotions = env_atomic64_read(&lru_stats->promotions);
+
+	return 0;
+}
+
+int ocf_stats_collect_cleaner(ocf_cache_t cache,
+		struct ocf_stats_cleaner *stats)
+{
+	struct ocf_cleaner_stats *cleaner_stats;
+
+	OCF_CHECK_NULL(cache);
+	OCF_CHECK_NULL(stats);
+
+	if (ocf_cache_is_standby(cache))
+		return -OCF_ERR_CACHE_STANDBY;
+
+	cleaner_stats = &cache->cleaner.stats;
+
+	stats->requests = env_atomic64_read(&cleaner_stats->requests);
+	stats->core_writes = env_atomic64_read(&cleaner_stats->core_writes);
+	stats->core_write_bytes = env_atomic64_read(
+			&cleaner_stats->core_write_bytes);
+	stats->watermark_triggers = env_atomic64_read(
+			&cleaner_stats->watermark_triggers);
+	stats->watermark_lines = env_atomic64_read(
+			&cleaner_stats->watermark_lines);
+	stats->pipeline_waits = env_atomic64_read(
+			&cleaner_stats->pipeline_waits);
+	stats->pipeline_wait_ns = env_atomic64_read(
+			&cleaner_stats->pipeline_wait_ns);
+	stats->cache_read_ns = env_atomic64_read(
+			&cleaner_stats->cache_read_ns);
+	stats->core_write_ns = env_atomic64_read(
+			&cleaner_stats->core_write_ns);
+	stats->core_flush_ns = env_atomic64_read(
+			&cleaner_stats->core_flush_ns);
+	stats->metadata_ns = env_atomic64_read(&cleaner_stats->metadata_ns);
+	stats->cache_flush_ns = env_atomic64_read(
+			&cleaner_stats->cache_flush_ns);
+	stats->idle_runs = env_atomic64_read(&cleaner_stats->idle_runs);
+	stats->idle_lines = env_atomic64_read(&cleaner_stats->idle_lines);
+
+	return 0;
+}
+
+int ocf_stats_collect_cleaning_alru(ocf_cache_t cache,
+		struct ocf_stats_cleaning_alru *stats)
+{
+	int result = -OCF_ERR_INVAL;
+
+	OCF_CHECK_NULL(cache);
+	OCF_CHECK_NULL(stats);
+
+	if (ocf_cache_is_standby(cache))
+		return -OCF_ERR_CACHE_STANDBY;
+
+	if (!ocf_cache_is_device_attached(cache))
+		return -OCF_ERR_INVAL;
+
+	if (!ocf_refcnt_inc(&cache->cleaner.refcnt))
+		return -OCF_ERR_NO_LOCK;
+
+	if (cache->cleaner.policy == ocf_cleaning_alru)
+		result = cleaning_policy_alru_get_stats(cache, stats);
+
+	ocf_refcnt_dec(&cache->cleaner.refcnt);
+
+	return result;
+}
+
+static void copy_lock_stats(struct ocf_stats_lock *dest,
+		struct ocf_metadata_lock_stats *from)
+{
+	dest->acquisitions = env_atomic64_read(&from->acquisitions);
+	dest->contended = env_atomic64_read(&from->contended);
+	dest->wait_ns = env_atomic64_read(&from->wait_ns);
+}
+
+int ocf_stats_collect_metadata_locks(ocf_cache_t cache,
+		struct ocf_stats_metadata_locks *stats)
+{
+	struct ocf_metadata_lock *metadata_lock;
+	unsigned i;
+
+	OCF_CHECK_NULL(cache);
+	OCF_CHECK_NULL(stats);
+
+	if (ocf_cache_is_standby(cache))
+		return -OCF_ERR_CACHE_STANDBY;
+
+	metadata_lock = &cache->metadata.lock;
+
+	if (!metadata_lock->stats_enabled)
+		return -OCF_ERR_INVAL;
+
+	ENV_BUG_ON(env_memset(stats, sizeof(*stats), 0));
+
+	stats->global_locks = metadata_lock->num_global_locks;
+	stats->hash_locks = metadata_lock->num_hash_locks;
+	stats->hash_buckets_per_lock = 1U << metadata_lock->hash_lock_shift;
+
+	for (i = 0; i < metadata_lock->num_global_locks; i++) {
+		copy_lock_stats(&stats->global[i],
+				&metadata_lock->global[i].stats);
+		copy_lock_stats(&stats->hash[i],
+				&metadata_lock->global[i].hash_stats);
+		stats->optimistic_reads += env_atomic64_read(
+				&metadata_lock->global[i].optimistic_reads);
+		stats->optimistic_retries += env_atomic64_read(
+				&metadata_lock->global[i].optimistic_retries);
+	}
+
+	return 0;
+}
+
 int ocf_stats_collect_core(ocf_core_t core,
 		struct ocf_stats_usage *usage,
 		struct ocf_stats_requests *req,
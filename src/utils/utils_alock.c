@@ -733,6 +733,16 @@ int ocf_alock_lock_rd(struct ocf_alock *alock,
 	return lock;
 }
 
+/* Lock request entries for read only if it can be done without waiting */
+int ocf_alock_trylock_rd(struct ocf_alock *alock,
+		struct ocf_request *req)
+{
+	ENV_BUG_ON(env_atomic_read(&req->lock_remaining));
+	req->alock_rw = OCF_READ;
+
+	return alock->cbs->lock_entries_fast(alock, req, OCF_READ);
+}
+
 int ocf_alock_lock_wr(struct ocf_alock *alock,
 		struct ocf_request *req, ocf_req_async_lock_cb cmpl)
 {
@@ -51,6 +51,9 @@ void ocf_alock_unlock_one_wr(struct ocf_alock *alock,
 int ocf_alock_lock_rd(struct ocf_alock *alock,
 		struct ocf_request *req, ocf_req_async_lock_cb cmpl);
 
+int ocf_alock_trylock_rd(struct ocf_alock *alock,
+		struct ocf_request *req);
+
 int ocf_alock_lock_wr(struct ocf_alock *alock,
 		struct ocf_request *req, ocf_req_async_lock_cb cmpl);
 
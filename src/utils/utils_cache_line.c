@@ -5,6 +5,7 @@
 
 #include "utils_cache_line.h"
 #include "../promotion/promotion.h"
+#include "utils_user_part.h"
 
 static void __set_cache_line_invalid(struct ocf_cache *cache, uint8_t start_bit,
 		uint8_t end_bit, ocf_cache_line_t line,
@@ -119,6 +120,8 @@ void set_cache_line_clean(struct ocf_cache *cache, uint8_t start_bit,
 			 */
 			env_atomic_dec(&req->core->runtime_meta->
 					part_counters[part_id].dirty_clines);
+			ocf_metadata_dirty_index_dec(req->core, line);
+			ocf_user_part_dirty_dec(cache, part_id);
 			ocf_lru_clean_cline(cache, part, line);
 			ocf_purge_cleaning_policy(cache, line);
 		}
@@ -161,6 +164,8 @@ void set_cache_line_dirty(struct ocf_cache *cache, uint8_t start_bit,
 			 */
 			env_atomic_inc(&req->core->runtime_meta->
 					part_counters[part_id].dirty_clines);
+			ocf_metadata_dirty_index_inc(req->core, line);
+			ocf_user_part_dirty_inc(cache, part_id);
 			ocf_lru_dirty_cline(cache, part, line);
 		}
 	}
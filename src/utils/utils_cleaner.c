@@ -42,7 +42,6 @@ static struct ocf_request *_ocf_cleaner_alloc_req(struct ocf_cache *cache,
 {
 	struct ocf_request *req = ocf_req_new_extended(attribs->io_queue, NULL,
 			0, count * ocf_line_size(cache), OCF_READ);
-	int ret;
 
 	if (!req)
 		return NULL;
@@ -50,22 +49,31 @@ static struct ocf_request *_ocf_cleaner_alloc_req(struct ocf_cache *cache,
 	req->info.internal = true;
 	req->info.cleaner_cache_line_lock = attribs->lock_cacheline;
 
-	/* Allocate pages for cleaning IO */
+	return req;
+}
+
+/*
+ * Allocate pages for cleaning IO. This is deferred until request is admitted
+ * to the pipeline, so that memory of requests in flight is limited.
+ */
+static int _ocf_cleaner_alloc_data(struct ocf_request *req)
+{
+	struct ocf_cache *cache = req->cache;
+	int ret;
+
 	req->data = ctx_data_alloc(cache->owner,
-			OCF_DIV_ROUND_UP((uint64_t)count * ocf_line_size(cache), PAGE_SIZE));
-	if (!req->data) {
-		ocf_req_put(req);
-		return NULL;
-	}
+			OCF_DIV_ROUND_UP(req->byte_length, PAGE_SIZE));
+	if (!req->data)
+		return -OCF_ERR_NO_MEM;
 
 	ret = ctx_data_mlock(cache->owner, req->data);
 	if (ret) {
 		ctx_data_free(cache->owner, req->data);
-		ocf_req_put(req);
-		return NULL;
+		req->data = NULL;
+		return -OCF_ERR_NO_MEM;
 	}
 
-	return req;
+	return 0;
 }
 
 enum {
@@ -126,6 +134,107 @@ static struct ocf_request *_ocf_cleaner_alloc_slave_req(
 	return req;
 }
 
+static inline void _ocf_cleaner_phase_start(struct ocf_request *req)
+{
+	req->timestamp = env_get_tick_count();
+}
+
+/* Account time elapsed since start of current cleaning phase */
+static inline void _ocf_cleaner_phase_end(struct ocf_request *req,
+		env_atomic64 *phase_ns)
+{
+	env_atomic64_add(env_ticks_to_nsecs(env_get_tick_count() -
+			req->timestamp), phase_ns);
+}
+
+static int _ocf_cleaner_fire_cache(struct ocf_request *req);
+
+static inline bool _ocf_cleaner_pipeline_fits(
+		struct ocf_cleaner_pipeline *pipeline, uint32_t bytes)
+{
+	/* Always let at least one request in, regardless of its size */
+	return !pipeline->in_flight_bytes ||
+		pipeline->in_flight_bytes + bytes <= pipeline->budget;
+}
+
+/*
+ * cleaner - Admit request to the pipeline, if its data fits in memory budget,
+ * otherwise queue it until requests in flight release enough of the budget.
+ * This way cache reads of subsequent requests overlap with core writes of
+ * previous ones, while memory used for cleaning stays bounded.
+ */
+static int _ocf_cleaner_pipeline_admit(struct ocf_request *req)
+{
+	struct ocf_cache *cache = req->cache;
+	struct ocf_cleaner_pipeline *pipeline = &cache->cleaner.pipeline;
+	bool admitted;
+
+	_ocf_cleaner_phase_start(req);
+
+	env_spinlock_lock(&pipeline->lock);
+	admitted = list_empty(&pipeline->waiting) &&
+			_ocf_cleaner_pipeline_fits(pipeline, req->byte_length);
+	if (admitted) {
+		pipeline->in_flight_bytes += req->byte_length;
+		req->info.cleaner_pipeline = true;
+	} else {
+		list_add_tail(&req->list, &pipeline->waiting);
+	}
+	env_spinlock_unlock(&pipeline->lock);
+
+	if (!admitted) {
+		OCF_DEBUG_MSG(cache, "Waiting for memory budget");
+		env_atomic64_inc(&cache->cleaner.stats.pipeline_waits);
+		return 0;
+	}
+
+	return _ocf_cleaner_fire_cache(req);
+}
+
+/*
+ * cleaner - Release memory budget of request and admit waiting requests,
+ * which fit in the budget
+ */
+static void _ocf_cleaner_pipeline_release(struct ocf_request *req)
+{
+	struct ocf_cache *cache = req->cache;
+	struct ocf_cleaner_pipeline *pipeline = &cache->cleaner.pipeline;
+	struct ocf_request *waiting;
+	struct list_head admitted;
+
+	if (!req->info.cleaner_pipeline)
+		return;
+
+	INIT_LIST_HEAD(&admitted);
+
+	env_spinlock_lock(&pipeline->lock);
+	pipeline->in_flight_bytes -= req->byte_length;
+	while (!list_empty(&pipeline->waiting)) {
+		waiting = list_first_entry(&pipeline->waiting,
+				struct ocf_request, list);
+		if (!_ocf_cleaner_pipeline_fits(pipeline,
+				waiting->byte_length)) {
+			break;
+		}
+
+		pipeline->in_flight_bytes += waiting->byte_length;
+		waiting->info.cleaner_pipeline = true;
+		list_move_tail(&waiting->list, &admitted);
+	}
+	env_spinlock_unlock(&pipeline->lock);
+
+	while (!list_empty(&admitted)) {
+		waiting = list_first_entry(&admitted, struct ocf_request, list);
+		list_del(&waiting->list);
+
+		_ocf_cleaner_phase_end(waiting,
+				&cache->cleaner.stats.pipeline_wait_ns);
+
+		waiting->engine_handler = _ocf_cleaner_fire_cache;
+		ocf_engine_push_req_front(waiting, true);
+	}
+}
+
 static void _ocf_cleaner_dealloc_req(struct ocf_request *req)
 {
 	if (ocf_cleaner_req_type_slave == req->master_io_req_type) {
@@ -144,9 +253,14 @@ static void _ocf_cleaner_dealloc_req(struct ocf_request *req)
 		ENV_BUG();
 	}
 
-	ctx_data_secure_erase(req->cache->owner, req->data);
-	ctx_data_munlock(req->cache->owner, req->data);
-	ctx_data_free(req->cache->owner, req->data);
+	if (req->data) {
+		ctx_data_secure_erase(req->cache->owner, req->data);
+		ctx_data_munlock(req->cache->owner, req->data);
+		ctx_data_free(req->cache->owner, req->data);
+	}
+
+	_ocf_cleaner_pipeline_release(req);
+
 	ocf_req_put(req);
 }
 
@@ -280,6 +394,8 @@ static void _ocf_cleaner_flush_cache_io_end(struct ocf_io *io, int error)
 {
 	struct ocf_request *req = io->priv1;
 
+	_ocf_cleaner_phase_end(req, &req->cache->cleaner.stats.cache_flush_ns);
+
 	if (error) {
 		ocf_metadata_error(req->cache);
 		req->error = error;
@@ -298,6 +414,8 @@ static int _ocf_cleaner_fire_flush_cache(struct ocf_request *req)
 
 	OCF_DEBUG_TRACE(req->cache);
 
+	_ocf_cleaner_phase_start(req);
+
 	io = ocf_new_cache_io(req->cache, req->io_queue, 0, 0, OCF_WRITE, 0, 0);
 	if (!io) {
 		ocf_metadata_error(req->cache);
@@ -314,6 +432,8 @@ static int _ocf_cleaner_fire_flush_cache(struct ocf_request *req)
 
 static void _ocf_cleaner_metadata_io_end(struct ocf_request *req, int error)
 {
+	_ocf_cleaner_phase_end(req, &req->cache->cleaner.stats.metadata_ns);
+
 	if (error) {
 		ocf_metadata_error(req->cache);
 		req->error = error;
@@ -337,6 +457,8 @@ static int _ocf_cleaner_update_metadata(struct ocf_request *req)
 
 	OCF_DEBUG_TRACE(req->cache);
 
+	_ocf_cleaner_phase_start(req);
+
 	/* Update metadata */
 	for (i = 0; i < req->core_line_count; i++, iter++) {
 		if (iter->status == LOOKUP_MISS)
@@ -399,6 +521,8 @@ static void _ocf_cleaner_flush_cores_io_end(struct ocf_map_info *map,
 
 	OCF_DEBUG_MSG(req->cache, "Core flush finished");
 
+	_ocf_cleaner_phase_end(req, &req->cache->cleaner.stats.core_flush_ns);
+
 	/*
 	 * All core writes done, switch to post cleaning activities
 	 */
@@ -424,6 +548,8 @@ static int _ocf_cleaner_fire_flush_cores(struct ocf_request *req)
 
 	OCF_DEBUG_TRACE(req->cache);
 
+	_ocf_cleaner_phase_start(req);
+
 	/* Protect IO completion race */
 	env_atomic_set(&req->req_remaining, 1);
 
@@ -470,6 +596,8 @@ static void _ocf_cleaner_core_io_end(struct ocf_request *req)
 
 	OCF_DEBUG_MSG(req->cache, "Core writes finished");
 
+	_ocf_cleaner_phase_end(req, &req->cache->cleaner.stats.core_write_ns);
+
 	/*
 	 * All cache read requests done, now we can submit writes to cores,
 	 * Move processing to thread, where IO will be (and can be) submitted
@@ -478,6 +606,22 @@ static void _ocf_cleaner_core_io_end(struct ocf_request *req)
 	ocf_engine_push_req_front(req, true);
 }
 
+/* Mark map entries covered by failed core write, starting from @map */
+static void _ocf_cleaner_core_write_error(struct ocf_request *req,
+		struct ocf_map_info *map, uint64_t addr, uint64_t bytes)
+{
+	struct ocf_map_info *end = &req->map[req->core_line_count];
+	ocf_core_id_t core_id = map->core_id;
+
+	for (; map < end && map->core_id == core_id &&
+			map->core_line * ocf_line_size(req->cache) <
+			addr + bytes; map++) {
+		map->invalid = true;
+	}
+
+	_ocf_cleaner_set_error(req);
+}
+
 static void _ocf_cleaner_core_io_cmpl(struct ocf_io *io, int error)
 {
 	struct ocf_map_info *map = io->priv1;
@@ -485,8 +629,7 @@ static void _ocf_cleaner_core_io_cmpl(struct ocf_io *io, int error)
 	ocf_core_t core = ocf_cache_get_core(req->cache, map->core_id);
 
 	if (error) {
-		map->invalid |= 1;
-		_ocf_cleaner_set_error(req);
+		_ocf_cleaner_core_write_error(req, map, io->addr, io->bytes);
 		ocf_core_stats_core_error_update(core, OCF_WRITE);
 	}
 
@@ -495,28 +638,41 @@ static void _ocf_cleaner_core_io_cmpl(struct ocf_io *io, int error)
 	ocf_io_put(io);
 }
 
-static void _ocf_cleaner_core_io_for_dirty_range(struct ocf_request *req,
-		struct ocf_map_info *iter, uint64_t begin, uint64_t end)
+/*
+ * Core write accumulating dirty sector ranges which are adjacent both on
+ * core volume and in cleaning request data
+ */
+struct ocf_cleaner_core_write {
+	struct ocf_map_info *first;
+		/*!< First map entry covered by the write */
+	uint64_t addr;
+	uint64_t offset;
+	uint64_t bytes;
+	ocf_part_id_t part_id;
+	uint32_t max_bytes;
+		/*!< Maximum I/O size of core volume */
+};
+
+static void _ocf_cleaner_core_write_submit(struct ocf_request *req,
+		struct ocf_cleaner_core_write *write)
 {
-	uint64_t addr, offset;
-	int err;
 	ocf_cache_t cache = req->cache;
+	struct ocf_map_info *iter = write->first;
+	ocf_core_t core;
 	struct ocf_io *io;
-	ocf_core_t core = ocf_cache_get_core(cache, iter->core_id);
-	ocf_part_id_t part_id = ocf_metadata_get_partition_id(cache,
-			iter->coll_idx);
+	int err;
 
-	addr = (ocf_line_size(cache) * iter->core_line)
-			+ SECTORS_TO_BYTES(begin);
-	offset = (ocf_line_size(cache) * iter->hash)
-			+ SECTORS_TO_BYTES(begin);
+	if (!write->bytes)
+		return;
+
+	core = ocf_cache_get_core(cache, iter->core_id);
 
-	io = ocf_new_core_io(core, req->io_queue, addr,
-			SECTORS_TO_BYTES(end - begin), OCF_WRITE, part_id, 0);
+	io = ocf_new_core_io(core, req->io_queue, write->addr, write->bytes,
+			OCF_WRITE, write->part_id, 0);
 	if (!io)
 		goto error;
 
-	err = ocf_io_set_data(io, req->data, offset);
+	err = ocf_io_set_data(io, req->data, write->offset);
 	if (err) {
 		ocf_io_put(io);
 		goto error;
@@ -524,12 +680,12 @@ static void _ocf_cleaner_core_io_for_dirty_range(struct ocf_request *req,
 
 	ocf_io_set_cmpl(io, iter, req, _ocf_cleaner_core_io_cmpl);
 
-	ocf_core_stats_core_block_update(core, part_id, OCF_WRITE,
-			SECTORS_TO_BYTES(end - begin));
+	env_atomic64_inc(&cache->cleaner.stats.core_writes);
+	env_atomic64_add(write->bytes, &cache->cleaner.stats.core_write_bytes);
 
 	OCF_DEBUG_PARAM(req->cache, "Core write, line = %llu, "
-			"sector = %llu, count = %llu", iter->core_line, begin,
-			end - begin);
+			"addr = %llu, bytes = %llu", iter->core_line,
+			write->addr, write->bytes);
 
 	/* Increase IO counter to be processed */
 	env_atomic_inc(&req->req_remaining);
@@ -537,14 +693,53 @@ static void _ocf_cleaner_core_io_for_dirty_range(struct ocf_request *req,
 	/* Send IO */
 	ocf_volume_submit_io(io);
 
+	write->bytes = 0;
 	return;
+
 error:
-	iter->invalid = true;
-	_ocf_cleaner_set_error(req);
+	_ocf_cleaner_core_write_error(req, iter, write->addr, write->bytes);
+	write->bytes = 0;
+}
+
+static void _ocf_cleaner_core_io_for_dirty_range(struct ocf_request *req,
+		struct ocf_map_info *iter, uint64_t begin, uint64_t end,
+		struct ocf_cleaner_core_write *write)
+{
+	ocf_cache_t cache = req->cache;
+	ocf_core_t core = ocf_cache_get_core(cache, iter->core_id);
+	ocf_part_id_t part_id = ocf_metadata_get_partition_id(cache,
+			iter->coll_idx);
+	uint64_t addr, offset, bytes = SECTORS_TO_BYTES(end - begin);
+
+	addr = (ocf_line_size(cache) * iter->core_line)
+			+ SECTORS_TO_BYTES(begin);
+	offset = (ocf_line_size(cache) * iter->hash)
+			+ SECTORS_TO_BYTES(begin);
+
+	ocf_core_stats_core_block_update(core, part_id, OCF_WRITE, bytes);
+
+	/* Append range to pending write if it continues it */
+	if (write->bytes && write->first->core_id == iter->core_id &&
+			write->part_id == part_id &&
+			write->addr + write->bytes == addr &&
+			write->offset + write->bytes == offset &&
+			write->bytes + bytes <= write->max_bytes) {
+		write->bytes += bytes;
+		return;
+	}
+
+	_ocf_cleaner_core_write_submit(req, write);
+
+	write->first = iter;
+	write->addr = addr;
+	write->offset = offset;
+	write->bytes = bytes;
+	write->part_id = part_id;
+	write->max_bytes = ocf_volume_get_max_io_size(&core->volume);
 }
 
 static void _ocf_cleaner_core_submit_io(struct ocf_request *req,
-		struct ocf_map_info *iter)
+		struct ocf_map_info *iter, struct ocf_cleaner_core_write *write)
 {
 	uint64_t i, dirty_start = 0;
 	struct ocf_cache *cache = req->cache;
@@ -555,7 +750,7 @@ static void _ocf_cleaner_core_submit_io(struct ocf_request *req,
 		&& metadata_test_dirty(cache, iter->coll_idx)) {
 
 		_ocf_cleaner_core_io_for_dirty_range(req, iter, 0,
-				ocf_line_sectors(cache));
+				ocf_line_sectors(cache), write);
 
 		return;
 	}
@@ -566,7 +761,7 @@ static void _ocf_cleaner_core_submit_io(struct ocf_request *req,
 			if (counting_dirty) {
 				counting_dirty = false;
 				_ocf_cleaner_core_io_for_dirty_range(req, iter,
-						dirty_start, i);
+						dirty_start, i, write);
 			}
 
 			continue;
@@ -579,8 +774,10 @@ static void _ocf_cleaner_core_submit_io(struct ocf_request *req,
 
 	}
 
-	if (counting_dirty)
-		_ocf_cleaner_core_io_for_dirty_range(req, iter, dirty_start, i);
+	if (counting_dirty) {
+		_ocf_cleaner_core_io_for_dirty_range(req, iter, dirty_start, i,
+				write);
+	}
 }
 
 static int _ocf_cleaner_fire_core(struct ocf_request *req)
@@ -588,13 +785,19 @@ static int _ocf_cleaner_fire_core(struct ocf_request *req)
 	uint32_t i;
 	struct ocf_map_info *iter;
 	ocf_cache_t cache = req->cache;
+	struct ocf_cleaner_core_write write = { .bytes = 0 };
 
 	OCF_DEBUG_TRACE(req->cache);
 
+	_ocf_cleaner_phase_start(req);
+
 	/* Protect IO completion race */
 	env_atomic_set(&req->req_remaining, 1);
 
-	/* Submits writes to the core */
+	env_atomic64_inc(&cache->cleaner.stats.requests);
+
+	/* Submits writes to the core, merging dirty ranges of consecutive
+	 * core lines into single I/O */
 	for (i = 0; i < req->core_line_count; i++) {
 		iter = &(req->map[i]);
 
@@ -610,13 +813,15 @@ static int _ocf_cleaner_fire_core(struct ocf_request *req)
 				req->lock_idx, req->map[i].core_id,
 				req->map[i].core_line);
 
-		_ocf_cleaner_core_submit_io(req, iter);
+		_ocf_cleaner_core_submit_io(req, iter, &write);
 
 		ocf_hb_cline_prot_unlock_rd(&cache->metadata.lock,
 				req->lock_idx, req->map[i].core_id,
 				req->map[i].core_line);
 	}
 
+	_ocf_cleaner_core_write_submit(req, &write);
+
 	/* Protect IO completion race */
 	_ocf_cleaner_core_io_end(req);
 
@@ -628,6 +833,8 @@ static void _ocf_cleaner_cache_io_end(struct ocf_request *req)
 	if (env_atomic_dec_return(&req->req_remaining))
 		return;
 
+	_ocf_cleaner_phase_end(req, &req->cache->cleaner.stats.cache_read_ns);
+
 	/*
 	 * All cache read requests done, now we can submit writes to cores,
 	 * Move processing to thread, where IO will be (and can be) submitted
@@ -670,6 +877,15 @@ static int _ocf_cleaner_fire_cache(struct ocf_request *req)
 	struct ocf_io *io;
 	int err;
 
+	if (_ocf_cleaner_alloc_data(req)) {
+		OCF_DEBUG_MSG(cache, "Data allocation error");
+		_ocf_cleaner_set_error(req);
+		_ocf_cleaner_finish_req(req);
+		return 0;
+	}
+
+	_ocf_cleaner_phase_start(req);
+
 	/* Protect IO completion race */
 	env_atomic_inc(&req->req_remaining);
 
@@ -726,7 +942,7 @@ static int _ocf_cleaner_fire(struct ocf_request *req)
 {
 	int result;
 
-	req->engine_handler = _ocf_cleaner_fire_cache;
+	req->engine_handler = _ocf_cleaner_pipeline_admit;
 
 	/* Handle cache lines locks */
 	result = _ocf_cleaner_cache_line_lock(req);
@@ -734,7 +950,7 @@ static int _ocf_cleaner_fire(struct ocf_request *req)
 	if (result >= 0) {
 		if (result == OCF_LOCK_ACQUIRED) {
 			OCF_DEBUG_MSG(req->cache, "Lock acquired");
-			_ocf_cleaner_fire_cache(req);
+			_ocf_cleaner_pipeline_admit(req);
 		} else {
 			OCF_DEBUG_MSG(req->cache, "NO Lock");
 		}
@@ -1028,18 +1244,6 @@ void ocf_cleaner_sort_sectors(struct flush_data *tbl, uint32_t num)
 	env_sort(tbl, num, sizeof(*tbl), _ocf_cleaner_cmp, _ocf_cleaner_swap);
 }
 
-void ocf_cleaner_sort_flush_containers(struct flush_container *fctbl,
-		uint32_t num)
-{
-	int i;
-
-	for (i = 0; i < num; i++) {
-		env_sort(fctbl[i].flush_data, fctbl[i].count,
-				sizeof(*fctbl[i].flush_data), _ocf_cleaner_cmp,
-				_ocf_cleaner_swap);
-	}
-}
-
 void ocf_cleaner_refcnt_freeze(ocf_cache_t cache)
 {
 	struct ocf_user_part *curr_part;
@@ -62,6 +62,19 @@ struct flush_data {
 
 typedef void (*ocf_flush_containter_coplete_t)(void *ctx);
 
+struct flush_container;
+
+/**
+ * @brief Single flush portion in flight
+ */
+struct flush_container_portion {
+	struct flush_container *fc;
+	uint64_t ticks;		/*!< Submission time */
+	uint64_t latency;	/*!< Duration of last completed portion */
+	uint32_t count;		/*!< Number of cache lines in portion */
+	env_atomic busy;
+};
+
 /**
  * @brief Flush table container
  */
@@ -77,8 +90,16 @@ struct flush_container {
 	struct ocf_request *req;
 
 	uint64_t flush_portion;
-	uint64_t ticks1;
-	uint64_t ticks2;
+
+	/* Portion slots, one per allowed portion in flight */
+	struct flush_container_portion *portions;
+	uint32_t queue_depth;
+
+	/* Portions in flight, plus one while container step is running */
+	env_atomic in_flight;
+
+	/* Container step is queued for execution */
+	env_atomic step_pending;
 
 	ocf_flush_containter_coplete_t end;
 	struct ocf_mngt_cache_flush_context *context;
@@ -127,15 +148,6 @@ int ocf_cleaner_do_flush_data_async(struct ocf_cache *cache,
  */
 void ocf_cleaner_sort_sectors(struct flush_data *tbl, uint32_t num);
 
-/**
- * @brief Sort flush data in all flush containters
- *
- * @param tbl Flush containers to sort
- * @param num Number of entries in fctbl
- */
-void ocf_cleaner_sort_flush_containers(struct flush_container *fctbl,
-		uint32_t num);
-
 /**
  * @brief Disable incrementing of cleaner reference counters
  *
@@ -0,0 +1,84 @@
+/*
+ * Copyright(c) 2024 Huawei Technologies
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "utils_mpsc.h"
+
+static inline struct ocf_mpsc_node *_ocf_mpsc_next(struct ocf_mpsc_node *node)
+{
+	return (struct ocf_mpsc_node *)env_atomic64_read(&node->next);
+}
+
+/* Swap head with compare-and-exchange, which already is part of env API */
+static inline long _ocf_mpsc_xchg_head(struct ocf_mpsc *mpsc, long new_head)
+{
+	long old, cur = env_atomic64_read(&mpsc->head);
+
+	do {
+		old = cur;
+		cur = env_atomic64_cmpxchg(&mpsc->head, old, new_head);
+	} while (cur != old);
+
+	return old;
+}
+
+void ocf_mpsc_init(struct ocf_mpsc *mpsc)
+{
+	env_atomic64_set(&mpsc->stub.next, 0);
+	env_atomic64_set(&mpsc->head, (long)&mpsc->stub);
+	mpsc->tail = &mpsc->stub;
+}
+
+void ocf_mpsc_push_chain(struct ocf_mpsc *mpsc, struct ocf_mpsc_node *first,
+		struct ocf_mpsc_node *last)
+{
+	struct ocf_mpsc_node *prev;
+
+	env_atomic64_set(&last->next, 0);
+
+	/* Full barrier - nodes content is visible before they are linked */
+	prev = (struct ocf_mpsc_node *)_ocf_mpsc_xchg_head(mpsc, (long)last);
+
+	/* Until this store the chain is not reachable by the consumer */
+	ocf_mpsc_link(prev, first);
+}
+
+struct ocf_mpsc_node *ocf_mpsc_pop(struct ocf_mpsc *mpsc)
+{
+	struct ocf_mpsc_node *tail = mpsc->tail;
+	struct ocf_mpsc_node *next = _ocf_mpsc_next(tail);
+	struct ocf_mpsc_node *head;
+
+	if (tail == &mpsc->stub) {
+		if (!next)
+			return NULL;
+
+		mpsc->tail = next;
+		tail = next;
+		next = _ocf_mpsc_next(next);
+	}
+
+	if (next) {
+		mpsc->tail = next;
+		return tail;
+	}
+
+	head = (struct ocf_mpsc_node *)env_atomic64_read(&mpsc->head);
+	if (tail != head) {
+		/* Producer didn't link its node yet */
+		return NULL;
+	}
+
+	/* Tail is the last node - push stub behind it, so that tail can
+	 * be detached without losing track of the list end */
+	ocf_mpsc_push(mpsc, &mpsc->stub);
+
+	next = _ocf_mpsc_next(tail);
+	if (next) {
+		mpsc->tail = next;
+		return tail;
+	}
+
+	return NULL;
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright(c) 2024 Huawei Technologies
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __UTILS_MPSC_H__
+#define __UTILS_MPSC_H__
+
+#include "ocf_env.h"
+
+/*
+ * Intrusive lock-free multi-producer single-consumer FIFO list.
+ *
+ * Any number of contexts may push concurrently without taking a lock.
+ * Pop must be serialized by the caller. Pop may transiently return NULL
+ * while a producer is in the middle of push, even though the list is not
+ * empty, so the consumer needs to track number of elements on its own.
+ */
+
+struct ocf_mpsc_node {
+	env_atomic64 next;
+};
+
+struct ocf_mpsc {
+	env_atomic64 head __attribute__((__aligned__(64)));
+	/*!< Most recently pushed node, updated by producers */
+
+	struct ocf_mpsc_node *tail __attribute__((__aligned__(64)));
+	/*!< Oldest node, owned by consumer */
+
+	struct ocf_mpsc_node stub;
+};
+
+void ocf_mpsc_init(struct ocf_mpsc *mpsc);
+
+/* Push chain of nodes already linked from first to last */
+void ocf_mpsc_push_chain(struct ocf_mpsc *mpsc, struct ocf_mpsc_node *first,
+		struct ocf_mpsc_node *last);
+
+static inline void ocf_mpsc_push(struct ocf_mpsc *mpsc,
+		struct ocf_mpsc_node *node)
+{
+	ocf_mpsc_push_chain(mpsc, node, node);
+}
+
+static inline void ocf_mpsc_link(struct ocf_mpsc_node *prev,
+		struct ocf_mpsc_node *node)
+{
+	env_atomic64_set(&prev->next, (long)node);
+}
+
+struct ocf_mpsc_node *ocf_mpsc_pop(struct ocf_mpsc *mpsc);
+
+#endif /* __UTILS_MPSC_H__ */
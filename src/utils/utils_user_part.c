@@ -9,6 +9,7 @@
 #include "../metadata/metadata.h"
 #include "../engine/cache_engine.h"
 #include "../ocf_lru.h"
+#include "../cleaning/cleaning.h"
 #include "utils_user_part.h"
 
 static struct ocf_lst_entry *ocf_user_part_lst_getter_valid(
@@ -156,6 +157,8 @@ void ocf_user_part_move(struct ocf_request *req)
 					part_counters[id_new].dirty_clines);
 			env_atomic_dec(&req->core->runtime_meta->
 					part_counters[id_old].dirty_clines);
+			ocf_user_part_dirty_inc(cache, id_new);
+			ocf_user_part_dirty_dec(cache, id_old);
 		}
 
 		env_atomic_inc(&req->core->runtime_meta->
@@ -182,9 +185,75 @@ void ocf_user_part_set_valid(struct ocf_cache *cache, ocf_part_id_t id,
 			user_part->config->priority = OCF_IO_CLASS_PRIO_LOWEST;
 			user_part->config->min_size = 0;
 			user_part->config->max_size = PARTITION_SIZE_MAX;
+			user_part->config->dirty_high =
+					OCF_IO_CLASS_DIRTY_HIGH_DEFAULT;
+			user_part->config->dirty_low =
+					OCF_IO_CLASS_DIRTY_LOW_DEFAULT;
 			ENV_BUG_ON(env_strncpy(user_part->config->name,
 					sizeof(user_part->config->name),
 					"Inactive", 9));
 		}
 	}
 }
+
+void ocf_user_part_dirty_urgent_start(struct ocf_cache *cache,
+		struct ocf_user_part *user_part)
+{
+	if (env_atomic_cmpxchg(&user_part->watermark.urgent, 0, 1))
+		return;
+
+	env_atomic64_inc(&cache->cleaner.stats.watermark_triggers);
+	ocf_kick_cleaner(cache);
+}
+
+void ocf_user_part_dirty_urgent_stop(struct ocf_cache *cache,
+		struct ocf_user_part *user_part)
+{
+	env_atomic_set(&user_part->watermark.urgent, 0);
+}
+
+void ocf_user_part_dirty_update(struct ocf_cache *cache,
+		struct ocf_user_part *user_part)
+{
+	if (ocf_user_part_dirty_high_reached(cache, user_part)) {
+		ocf_user_part_dirty_urgent_start(cache, user_part);
+	} else if (ocf_user_part_dirty_low_reached(cache, user_part) ||
+			user_part->config->dirty_high >=
+			OCF_IO_CLASS_DIRTY_WATERMARK_DISABLED) {
+		ocf_user_part_dirty_urgent_stop(cache, user_part);
+	}
+}
+
+void ocf_user_part_dirty_init(struct ocf_cache *cache)
+{
+	struct ocf_user_part *user_part;
+	ocf_core_t core;
+	ocf_core_id_t core_id;
+	ocf_part_id_t part_id;
+	uint32_t dirty;
+
+	for (part_id = 0; part_id < OCF_USER_IO_CLASS_MAX; part_id++) {
+		dirty = 0;
+		for_each_core(cache, core, core_id) {
+			dirty += env_atomic_read(&core->runtime_meta->
+					part_counters[part_id].dirty_clines);
+		}
+
+		user_part = &cache->user_parts[part_id];
+
+		/* Watermarks loaded from cache device may be out of range */
+		if (user_part->config->dirty_high >
+				OCF_IO_CLASS_DIRTY_WATERMARK_DISABLED ||
+				user_part->config->dirty_high <=
+				user_part->config->dirty_low) {
+			user_part->config->dirty_high =
+					OCF_IO_CLASS_DIRTY_WATERMARK_DISABLED;
+			user_part->config->dirty_low =
+					OCF_IO_CLASS_DIRTY_LOW_DEFAULT;
+		}
+
+		env_atomic_set(&user_part->watermark.dirty, dirty);
+		env_atomic_set(&user_part->watermark.urgent,
+				ocf_user_part_dirty_high_reached(cache, user_part));
+	}
+}
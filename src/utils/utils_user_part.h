@@ -125,6 +125,90 @@ static inline bool ocf_user_part_has_space(struct ocf_request *req)
 	return (part_occupancy + needed_cache_lines <= part_occupancy_limit);
 }
 
+static inline bool ocf_user_part_is_dirty_urgent(
+		struct ocf_user_part *user_part)
+{
+	return !!env_atomic_read(&user_part->watermark.urgent);
+}
+
+static inline bool ocf_user_part_has_dirty(struct ocf_user_part *user_part)
+{
+	return env_atomic_read(&user_part->watermark.dirty) > 0;
+}
+
+static inline bool ocf_user_part_dirty_high_reached(ocf_cache_t cache,
+		struct ocf_user_part *user_part)
+{
+	uint64_t dirty = env_atomic_read(&user_part->watermark.dirty);
+	uint8_t high = user_part->config->dirty_high;
+
+	if (high >= OCF_IO_CLASS_DIRTY_WATERMARK_DISABLED)
+		return false;
+
+	return dirty * 100 >= (uint64_t)high *
+			ocf_user_part_get_max_size(cache, user_part);
+}
+
+static inline bool ocf_user_part_dirty_low_reached(ocf_cache_t cache,
+		struct ocf_user_part *user_part)
+{
+	uint64_t dirty = env_atomic_read(&user_part->watermark.dirty);
+
+	return dirty * 100 <= (uint64_t)user_part->config->dirty_low *
+			ocf_user_part_get_max_size(cache, user_part);
+}
+
+void ocf_user_part_dirty_urgent_start(struct ocf_cache *cache,
+		struct ocf_user_part *user_part);
+
+void ocf_user_part_dirty_urgent_stop(struct ocf_cache *cache,
+		struct ocf_user_part *user_part);
+
+static inline void ocf_user_part_dirty_inc(struct ocf_cache *cache,
+		ocf_part_id_t part_id)
+{
+	struct ocf_user_part *user_part = &cache->user_parts[part_id];
+
+	env_atomic_inc(&user_part->watermark.dirty);
+
+	if (!ocf_user_part_is_dirty_urgent(user_part) &&
+			ocf_user_part_dirty_high_reached(cache, user_part)) {
+		ocf_user_part_dirty_urgent_start(cache, user_part);
+	}
+}
+
+static inline void ocf_user_part_dirty_dec(struct ocf_cache *cache,
+		ocf_part_id_t part_id)
+{
+	struct ocf_user_part *user_part = &cache->user_parts[part_id];
+
+	env_atomic_dec(&user_part->watermark.dirty);
+
+	if (ocf_user_part_is_dirty_urgent(user_part) &&
+			ocf_user_part_dirty_low_reached(cache, user_part)) {
+		ocf_user_part_dirty_urgent_stop(cache, user_part);
+	}
+}
+
+/**
+ * @brief Recalculate dirty cache lines of all partitions from core counters
+ *	and initialize urgent cleaning state of partitions. Invalid dirty
+ *	watermarks (e.g. loaded from cache device) are reset to disabled.
+ *
+ * @param cache - Cache instance
+ */
+void ocf_user_part_dirty_init(struct ocf_cache *cache);
+
+/**
+ * @brief Update urgent cleaning state of partition after change of its
+ *	dirty watermarks, maximum size or dirty cache lines counter
+ *
+ * @param cache - Cache instance
+ * @param user_part - Partition
+ */
+void ocf_user_part_dirty_update(struct ocf_cache *cache,
+		struct ocf_user_part *user_part);
+
 static inline ocf_cache_mode_t ocf_user_part_get_cache_mode(ocf_cache_t cache,
 		ocf_part_id_t part_id)
 {
@@ -0,0 +1 @@
+/root/repo/inc/cleaning/acp.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/inc/ocf.h
\ No newline at end of file
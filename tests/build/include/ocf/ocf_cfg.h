@@ -0,0 +1 @@
+/root/repo/inc/ocf_cfg.h
\ No newline at end of file
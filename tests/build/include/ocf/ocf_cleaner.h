@@ -0,0 +1 @@
+/root/repo/inc/ocf_cleaner.h
\ No newline at end of file
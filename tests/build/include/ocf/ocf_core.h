@@ -0,0 +1 @@
+/root/repo/inc/ocf_core.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/inc/ocf_debug.h
\ No newline at end of file
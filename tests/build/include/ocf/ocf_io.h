@@ -0,0 +1 @@
+/root/repo/inc/ocf_io.h
\ No newline at end of file
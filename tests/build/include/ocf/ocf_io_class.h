@@ -0,0 +1 @@
+/root/repo/inc/ocf_io_class.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/inc/ocf_metadata.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/inc/ocf_mngt.h
\ No newline at end of file
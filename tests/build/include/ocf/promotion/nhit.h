@@ -0,0 +1 @@
+/root/repo/inc/promotion/nhit.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/cleaning/acp.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/cleaning/alru_structs.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/cleaning/cleaning.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/cleaning/cleaning.h
\ No newline at end of file
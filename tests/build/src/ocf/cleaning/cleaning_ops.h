@@ -0,0 +1 @@
+/root/repo/src/cleaning/cleaning_ops.h
\ No newline at end of file
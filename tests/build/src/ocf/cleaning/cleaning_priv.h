@@ -0,0 +1 @@
+/root/repo/src/cleaning/cleaning_priv.h
\ No newline at end of file
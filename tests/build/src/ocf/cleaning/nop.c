@@ -0,0 +1 @@
+/root/repo/src/cleaning/nop.c
\ No newline at end of file
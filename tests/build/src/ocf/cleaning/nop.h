@@ -0,0 +1 @@
+/root/repo/src/cleaning/nop.h
\ No newline at end of file
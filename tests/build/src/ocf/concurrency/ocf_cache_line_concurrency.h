@@ -0,0 +1 @@
+/root/repo/src/concurrency/ocf_cache_line_concurrency.h
\ No newline at end of file
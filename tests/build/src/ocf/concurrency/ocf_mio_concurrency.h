@@ -0,0 +1 @@
+/root/repo/src/concurrency/ocf_mio_concurrency.h
\ No newline at end of file
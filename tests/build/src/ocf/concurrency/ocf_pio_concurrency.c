@@ -0,0 +1 @@
+/root/repo/src/concurrency/ocf_pio_concurrency.c
\ No newline at end of file
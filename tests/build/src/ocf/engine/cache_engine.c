@@ -0,0 +1 @@
+/root/repo/src/engine/cache_engine.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/engine/engine_d2c.c
\ No newline at end of file
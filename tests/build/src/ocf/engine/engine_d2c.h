@@ -0,0 +1 @@
+/root/repo/src/engine/engine_d2c.h
\ No newline at end of file
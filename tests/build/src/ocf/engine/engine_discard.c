@@ -0,0 +1 @@
+/root/repo/src/engine/engine_discard.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/engine/engine_wa.h
\ No newline at end of file
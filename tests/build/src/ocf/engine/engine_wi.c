@@ -0,0 +1 @@
+/root/repo/src/engine/engine_wi.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/env/posix//ocf_env.c
\ No newline at end of file
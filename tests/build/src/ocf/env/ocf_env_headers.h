@@ -0,0 +1 @@
+/root/repo/env/posix//ocf_env_headers.h
\ No newline at end of file
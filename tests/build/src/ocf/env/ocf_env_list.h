@@ -0,0 +1 @@
+/root/repo/env/posix//ocf_env_list.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/env/posix//utils_mpool.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/env/posix//utils_mpool.h
\ No newline at end of file
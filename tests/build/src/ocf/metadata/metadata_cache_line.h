@@ -0,0 +1 @@
+/root/repo/src/metadata/metadata_cache_line.h
\ No newline at end of file
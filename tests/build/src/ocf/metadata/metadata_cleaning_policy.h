@@ -0,0 +1 @@
+/root/repo/src/metadata/metadata_cleaning_policy.h
\ No newline at end of file
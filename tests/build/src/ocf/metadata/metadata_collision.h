@@ -0,0 +1 @@
+/root/repo/src/metadata/metadata_collision.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/metadata/metadata_core.c
\ No newline at end of file
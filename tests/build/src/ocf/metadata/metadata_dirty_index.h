@@ -0,0 +1 @@
+/root/repo/src/metadata/metadata_dirty_index.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/metadata/metadata_io.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/metadata/metadata_lazy_load.h
\ No newline at end of file
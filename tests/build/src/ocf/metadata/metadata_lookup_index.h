@@ -0,0 +1 @@
+/root/repo/src/metadata/metadata_lookup_index.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/metadata/metadata_partition.c
\ No newline at end of file
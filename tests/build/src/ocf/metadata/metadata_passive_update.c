@@ -0,0 +1 @@
+/root/repo/src/metadata/metadata_passive_update.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/metadata/metadata_passive_update.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/metadata/metadata_raw.h
\ No newline at end of file
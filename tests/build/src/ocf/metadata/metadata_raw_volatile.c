@@ -0,0 +1 @@
+/root/repo/src/metadata/metadata_raw_volatile.c
\ No newline at end of file
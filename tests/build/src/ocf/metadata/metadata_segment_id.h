@@ -0,0 +1 @@
+/root/repo/src/metadata/metadata_segment_id.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/mngt/ocf_mngt_misc.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/ocf_composite_volume.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/ocf_core.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/ocf_ctx.c
\ No newline at end of file
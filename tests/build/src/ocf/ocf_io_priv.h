@@ -0,0 +1 @@
+/root/repo/src/ocf_io_priv.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/ocf_lru.c
\ No newline at end of file
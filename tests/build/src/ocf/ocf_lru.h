@@ -0,0 +1 @@
+/root/repo/src/ocf_lru.h
\ No newline at end of file
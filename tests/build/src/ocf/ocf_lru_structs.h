@@ -0,0 +1 @@
+/root/repo/src/ocf_lru_structs.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/ocf_queue.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/ocf_request.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/ocf_space.c
\ No newline at end of file
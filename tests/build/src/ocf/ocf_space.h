@@ -0,0 +1 @@
+/root/repo/src/ocf_space.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/ocf_stats_priv.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/utils/utils_alock.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/utils/utils_alock.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/utils/utils_cache_line.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/utils/utils_cache_line.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/utils/utils_generator.c
\ No newline at end of file
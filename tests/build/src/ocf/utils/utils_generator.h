@@ -0,0 +1 @@
+/root/repo/src/utils/utils_generator.h
\ No newline at end of file
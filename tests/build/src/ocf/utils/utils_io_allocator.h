@@ -0,0 +1 @@
+/root/repo/src/utils/utils_io_allocator.h
\ No newline at end of file
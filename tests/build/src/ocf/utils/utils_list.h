@@ -0,0 +1 @@
+/root/repo/src/utils/utils_list.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/src/utils/utils_request.h
\ No newline at end of file
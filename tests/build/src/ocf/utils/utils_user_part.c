@@ -0,0 +1 @@
+/root/repo/src/utils/utils_user_part.c
\ No newline at end of file
@@ -0,0 +1,13 @@
+/*
+ * Copyright(c) 2024 Huawei Technologies
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "ocf/ocf.h"
+#include "../src/ocf/ocf_cache_priv.h"
+
+/* Get cleaner of cache to drive it from test instead of adapter thread */
+ocf_cleaner_t ocf_cache_get_cleaner_helper(ocf_cache_t cache)
+{
+	return &cache->cleaner;
+}
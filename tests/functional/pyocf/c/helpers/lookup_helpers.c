@@ -0,0 +1,224 @@
+/*
+ * Copyright(c) 2024 Huawei Technologies
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "ocf/ocf.h"
+#include "../src/ocf/ocf_cache_priv.h"
+#include "../src/ocf/metadata/metadata.h"
+#include "../src/ocf/engine/engine_common.h"
+
+#define LOOKUP_BENCH_CORE_ID 0
+
+/* Core line address space of benchmark, big enough to avoid duplicates */
+#define LOOKUP_BENCH_CORE_LINE_MASK ((1ULL << 40) - 1)
+
+static inline uint64_t lookup_bench_rand(uint64_t *state)
+{
+	/* xorshift64 */
+	*state ^= *state << 13;
+	*state ^= *state >> 7;
+	*state ^= *state << 17;
+
+	return *state;
+}
+
+static uint64_t lookup_bench_run(ocf_cache_t cache, uint64_t *queries,
+		uint32_t queries_cnt, uint32_t *hits)
+{
+	struct ocf_map_info entry;
+	uint64_t start;
+	uint32_t i;
+
+	*hits = 0;
+
+	start = env_get_tick_count();
+
+	for (i = 0; i < queries_cnt; i++) {
+		ocf_engine_lookup_map_entry(cache, &entry,
+				LOOKUP_BENCH_CORE_ID, queries[i]);
+		if (entry.status == LOOKUP_HIT)
+			(*hits)++;
+	}
+
+	return env_ticks_to_nsecs(env_get_tick_count() - start);
+}
+
+/*
+ * Map @load_pct percent of cache lines to random core lines of core 0 and
+ * measure time of @queries_cnt lookups (half hits, half misses) walking
+ * collision lists and using lookup index. Cache must be started with lookup
+ * index enabled and must have no cores.
+ */
+int ocf_lookup_bench_helper(ocf_cache_t cache, unsigned load_pct,
+		uint32_t queries_cnt, uint64_t *chain_ns, uint64_t *index_ns)
+{
+	ocf_cache_line_t lines = cache->device->collision_table_entries;
+	ocf_cache_line_t mapped = (uint64_t)lines * load_pct / 100;
+	struct ocf_lookup_index *lookup_index = cache->metadata.lookup_index;
+	uint64_t seed = 0x2545f4914f6cdd1dULL;
+	uint64_t *keys, *queries, core_line;
+	uint32_t chain_hits, index_hits;
+	ocf_cache_line_t line;
+	uint32_t i;
+	int result = 0;
+
+	if (!lookup_index || !mapped || load_pct > 100)
+		return -OCF_ERR_INVAL;
+
+	keys = env_vmalloc(mapped * sizeof(*keys));
+	if (!keys)
+		return -OCF_ERR_NO_MEM;
+
+	queries = env_vmalloc(queries_cnt * sizeof(*queries));
+	if (!queries) {
+		env_vfree(keys);
+		return -OCF_ERR_NO_MEM;
+	}
+
+	ocf_metadata_start_exclusive_access(&cache->metadata.lock);
+
+	for (line = 0; line < mapped; line++) {
+		core_line = lookup_bench_rand(&seed) &
+				LOOKUP_BENCH_CORE_LINE_MASK;
+		keys[line] = core_line;
+		ocf_metadata_add_to_collision(cache, LOOKUP_BENCH_CORE_ID,
+				core_line, ocf_metadata_hash_func(cache,
+				core_line, LOOKUP_BENCH_CORE_ID), line);
+	}
+
+	for (i = 0; i < queries_cnt; i++) {
+		if (i % 2) {
+			queries[i] = keys[lookup_bench_rand(&seed) % mapped];
+		} else {
+			queries[i] = lookup_bench_rand(&seed) &
+					LOOKUP_BENCH_CORE_LINE_MASK;
+		}
+	}
+
+	cache->metadata.lookup_index = NULL;
+	*chain_ns = lookup_bench_run(cache, queries, queries_cnt, &chain_hits);
+	cache->metadata.lookup_index = lookup_index;
+	*index_ns = lookup_bench_run(cache, queries, queries_cnt, &index_hits);
+
+	if (chain_hits != index_hits || chain_hits < queries_cnt / 2)
+		result = -OCF_ERR_INVAL;
+
+	for (line = 0; line < mapped; line++)
+		ocf_metadata_remove_from_collision(cache, line, PARTITION_DEFAULT);
+
+	ocf_metadata_end_exclusive_access(&cache->metadata.lock);
+
+	env_vfree(queries);
+	env_vfree(keys);
+
+	return result;
+}
+
+static uint64_t lookup_req_bench_run(ocf_cache_t cache, bool batched,
+		uint64_t *starts, uint32_t reqs_cnt, struct ocf_map_info *map,
+		uint32_t req_lines, uint32_t *hits)
+{
+	uint64_t start;
+	uint32_t i, j;
+
+	*hits = 0;
+
+	start = env_get_tick_count();
+
+	for (i = 0; i < reqs_cnt; i++) {
+		if (batched) {
+			ocf_engine_lookup_map_entries(cache, map,
+					LOOKUP_BENCH_CORE_ID, starts[i],
+					req_lines);
+		} else {
+			for (j = 0; j < req_lines; j++) {
+				ocf_engine_lookup_map_entry(cache, &map[j],
+						LOOKUP_BENCH_CORE_ID,
+						starts[i] + j);
+			}
+		}
+
+		for (j = 0; j < req_lines; j++)
+			*hits += (map[j].status == LOOKUP_HIT);
+	}
+
+	return env_ticks_to_nsecs(env_get_tick_count() - start);
+}
+
+/*
+ * Map all cache lines to consecutive core lines of core 0 in random order
+ * and measure time of looking up @reqs_cnt requests of @req_lines lines one
+ * by one and with ocf_engine_lookup_map_entries(). Cache must be started
+ * with lookup index enabled and must have no cores.
+ */
+int ocf_lookup_req_bench_helper(ocf_cache_t cache, bool use_index,
+		uint32_t req_lines, uint32_t reqs_cnt, uint64_t *single_ns,
+		uint64_t *batch_ns)
+{
+	ocf_cache_line_t lines = cache->device->collision_table_entries;
+	struct ocf_lookup_index *lookup_index = cache->metadata.lookup_index;
+	uint64_t seed = 0x2545f4914f6cdd1dULL;
+	uint32_t single_hits, batch_hits;
+	struct ocf_map_info *map;
+	ocf_cache_line_t *perm, tmp, line;
+	uint64_t *starts;
+	uint32_t i, j;
+	int result = 0;
+
+	if (!lookup_index || !req_lines || req_lines > lines)
+		return -OCF_ERR_INVAL;
+
+	perm = env_vmalloc(lines * sizeof(*perm));
+	starts = env_vmalloc(reqs_cnt * sizeof(*starts));
+	map = env_vzalloc(req_lines * sizeof(*map));
+	if (!perm || !starts || !map) {
+		result = -OCF_ERR_NO_MEM;
+		goto out;
+	}
+
+	for (line = 0; line < lines; line++)
+		perm[line] = line;
+	for (line = lines - 1; line > 0; line--) {
+		j = lookup_bench_rand(&seed) % (line + 1);
+		tmp = perm[line];
+		perm[line] = perm[j];
+		perm[j] = tmp;
+	}
+
+	for (i = 0; i < reqs_cnt; i++)
+		starts[i] = lookup_bench_rand(&seed) % (lines - req_lines + 1);
+
+	ocf_metadata_start_exclusive_access(&cache->metadata.lock);
+
+	for (line = 0; line < lines; line++) {
+		ocf_metadata_add_to_collision(cache, LOOKUP_BENCH_CORE_ID,
+				line, ocf_metadata_hash_func(cache, line,
+				LOOKUP_BENCH_CORE_ID), perm[line]);
+	}
+
+	if (!use_index)
+		cache->metadata.lookup_index = NULL;
+
+	*single_ns = lookup_req_bench_run(cache, false, starts, reqs_cnt, map,
+			req_lines, &single_hits);
+	*batch_ns = lookup_req_bench_run(cache, true, starts, reqs_cnt, map,
+			req_lines, &batch_hits);
+
+	cache->metadata.lookup_index = lookup_index;
+
+	if (single_hits != batch_hits || batch_hits != reqs_cnt * req_lines)
+		result = -OCF_ERR_INVAL;
+
+	for (line = 0; line < lines; line++)
+		ocf_metadata_remove_from_collision(cache, line, PARTITION_DEFAULT);
+
+	ocf_metadata_end_exclusive_access(&cache->metadata.lock);
+
+out:
+	env_vfree(map);
+	env_vfree(starts);
+	env_vfree(perm);
+
+	return result;
+}
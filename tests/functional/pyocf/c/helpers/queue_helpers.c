@@ -0,0 +1,159 @@
+/*
+ * Copyright(c) 2024 Huawei Technologies
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <pthread.h>
+#include "ocf/ocf.h"
+#include "../src/ocf/ocf_cache_priv.h"
+#include "../src/ocf/ocf_queue_priv.h"
+#include "../src/ocf/ocf_request.h"
+#include "../src/ocf/engine/engine_common.h"
+
+/* Every n-th request of each producer is pushed to the queue front */
+#define QUEUE_STRESS_FRONT_INTERVAL 7
+
+struct queue_stress;
+
+struct queue_stress_producer {
+	struct queue_stress *stress;
+	pthread_t thread;
+	uint64_t next_seq;
+};
+
+struct queue_stress {
+	ocf_queue_t queue;
+	struct queue_stress_producer *producers;
+	unsigned producers_cnt;
+	unsigned reqs_cnt;
+	env_atomic handled;
+	env_atomic reordered;
+	env_atomic alloc_errors;
+};
+
+static void queue_stress_kick(ocf_queue_t q)
+{
+}
+
+static void queue_stress_stop(ocf_queue_t q)
+{
+}
+
+static const struct ocf_queue_ops queue_stress_ops = {
+	.kick = queue_stress_kick,
+	.stop = queue_stress_stop,
+};
+
+static int queue_stress_handle(struct ocf_request *req)
+{
+	struct queue_stress_producer *producer = req->priv;
+	struct queue_stress *stress = producer->stress;
+
+	/* Requests pushed to back must be handled in FIFO order */
+	if (!req->rw) {
+		if (req->byte_position != producer->next_seq)
+			env_atomic_inc(&stress->reordered);
+		producer->next_seq = req->byte_position + 1;
+	}
+
+	env_atomic_inc(&stress->handled);
+	ocf_req_put(req);
+
+	return 0;
+}
+
+static void *queue_stress_produce(void *ctx)
+{
+	struct queue_stress_producer *producer = ctx;
+	struct queue_stress *stress = producer->stress;
+	struct ocf_request *req;
+	uint64_t seq = 0;
+	unsigned i;
+
+	for (i = 0; i < stress->reqs_cnt; i++) {
+		req = ocf_req_new(stress->queue, NULL, 0, 0, 0);
+		if (!req) {
+			env_atomic_inc(&stress->alloc_errors);
+			continue;
+		}
+
+		req->info.internal = true;
+		req->engine_handler = queue_stress_handle;
+		req->priv = producer;
+
+		if (i % QUEUE_STRESS_FRONT_INTERVAL == 0) {
+			req->rw = 1;
+			ocf_engine_push_req_front(req, false);
+		} else {
+			req->byte_position = seq++;
+			ocf_engine_push_req_back(req, false);
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * Push requests to single queue from multiple threads while it is being
+ * processed by one consumer and check that no request was lost and that
+ * each producer's requests pushed to back were handled in order.
+ */
+int ocf_queue_stress_helper(ocf_cache_t cache, bool lockless,
+		unsigned producers_cnt, unsigned reqs_cnt, uint64_t *time_ns)
+{
+	struct queue_stress stress = {
+		.producers_cnt = producers_cnt,
+		.reqs_cnt = reqs_cnt,
+	};
+	unsigned total = producers_cnt * reqs_cnt;
+	uint64_t start;
+	unsigned i;
+	int result;
+
+	if (lockless) {
+		result = ocf_queue_create_lockless(cache, &stress.queue,
+				&queue_stress_ops);
+	} else {
+		result = ocf_queue_create(cache, &stress.queue,
+				&queue_stress_ops);
+	}
+	if (result)
+		return result;
+
+	stress.producers = env_zalloc(producers_cnt *
+			sizeof(*stress.producers), ENV_MEM_NORMAL);
+	if (!stress.producers) {
+		ocf_queue_put(stress.queue);
+		return -OCF_ERR_NO_MEM;
+	}
+
+	start = env_get_tick_count();
+
+	for (i = 0; i < producers_cnt; i++) {
+		stress.producers[i].stress = &stress;
+		pthread_create(&stress.producers[i].thread, NULL,
+				queue_stress_produce, &stress.producers[i]);
+	}
+
+	while (env_atomic_read(&stress.handled) +
+			env_atomic_read(&stress.alloc_errors) < total) {
+		ocf_queue_run(stress.queue);
+	}
+
+	*time_ns = env_ticks_to_nsecs(env_get_tick_count() - start);
+
+	for (i = 0; i < producers_cnt; i++)
+		pthread_join(stress.producers[i].thread, NULL);
+
+	if (ocf_queue_pending_io(stress.queue) ||
+			env_atomic_read(&stress.handled) != total) {
+		result = -OCF_ERR_INVAL;
+	} else if (env_atomic_read(&stress.reordered)) {
+		result = -OCF_ERR_INVAL;
+	}
+
+	env_free(stress.producers);
+	ocf_queue_put(stress.queue);
+
+	return result;
+}
@@ -3,7 +3,18 @@
 # SPDX-License-Identifier: BSD-3-Clause
 #
 #
+from ctypes import c_bool, c_int, c_uint, c_uint32, c_uint64, c_void_p, byref
 from .ocf import OcfLib
+from .types.cache import Cache, CacheMode
+from .types.core import Core
+from .types.data import Data
+from .types.io import IoDir
+from .types.shared import OcfCompletion, SeqCutOffPolicy
+from .types.volume import RamVolume
+from .types.volume_core import CoreVolume
+from .utils import Size as S
+
+BLOCK = 4096
 
 
 def get_metadata_segment_page_location(cache, segment):
@@ -39,3 +50,101 @@ def get_metadata_segment_is_flapped(cache, segment):
 def get_composite_volume_type_id():
     lib = OcfLib.getInstance()
     return int(lib.ocf_get_composite_volume_type_id_helper())
+
+
+def queue_stress(cache, lockless, producers, requests):
+    lib = OcfLib.getInstance()
+    time_ns = c_uint64()
+    result = lib.ocf_queue_stress_helper(
+        cache, c_bool(lockless), c_uint(producers), c_uint(requests), byref(time_ns)
+    )
+    return int(result), time_ns.value
+
+
+def lookup_bench(cache, load_pct, queries):
+    lib = OcfLib.getInstance()
+    chain_ns = c_uint64()
+    index_ns = c_uint64()
+    result = lib.ocf_lookup_bench_helper(
+        cache, c_uint(load_pct), c_uint(queries), byref(chain_ns), byref(index_ns)
+    )
+    return int(result), chain_ns.value, index_ns.value
+
+
+def lookup_req_bench(cache, use_index, req_lines, requests):
+    lib = OcfLib.getInstance()
+    single_ns = c_uint64()
+    batch_ns = c_uint64()
+    result = lib.ocf_lookup_req_bench_helper(
+        cache,
+        c_bool(use_index),
+        c_uint(req_lines),
+        c_uint(requests),
+        byref(single_ns),
+        byref(batch_ns),
+    )
+    return int(result), single_ns.value, batch_ns.value
+
+
+def run_cleaner(cache, queue):
+    """Run single cleaner iteration and return requested sleep interval"""
+    lib = OcfLib.getInstance()
+    lib.ocf_cache_get_cleaner_helper.restype = c_void_p
+    cleaner = c_void_p(lib.ocf_cache_get_cleaner_helper(cache))
+    comp = OcfCompletion([("cleaner", c_void_p), ("interval", c_uint32)])
+    lib.ocf_cleaner_set_cmpl(cleaner, comp)
+    lib.ocf_cleaner_run(cleaner, queue)
+    comp.wait()
+    return comp.results["interval"]
+
+
+def report_cleaner_idle(cache):
+    """Report to cleaner that there is no foreground I/O to the cache"""
+    lib = OcfLib.getInstance()
+    lib.ocf_cache_get_cleaner_helper.restype = c_void_p
+    cleaner = c_void_p(lib.ocf_cache_get_cleaner_helper(cache))
+    lib.ocf_cleaner_report_idle(cleaner)
+
+
+def io_to_exp_obj(vol, queue, address, data, direction):
+    vol.open()
+    io = vol.new_io(queue, address, data.size, direction, 0, 0)
+    io.set_data(data)
+    comp = OcfCompletion([("err", c_int)])
+    io.callback = comp.callback
+    io.submit()
+    comp.wait()
+    vol.close()
+
+    return comp.results["err"]
+
+
+def block_data(block, core_id=0):
+    """Content of BLOCK sized block, unique for each block number and core"""
+    return ((core_id << 24) + block + 1).to_bytes(4, "little") * (BLOCK // 4)
+
+
+def write_blocks(cache, core, blocks, data_fcn=block_data):
+    """Write BLOCK sized blocks of given numbers to core through cache"""
+    vol = CoreVolume(core)
+    queue = cache.get_default_queue()
+
+    for block in blocks:
+        data = Data.from_bytes(data_fcn(block))
+        assert io_to_exp_obj(vol, queue, block * BLOCK, data, IoDir.WRITE) == 0
+
+
+def start_cache_with_core(core_device, cache_device=None, cache_mode=CacheMode.WB, **kwargs):
+    """
+    Start cache with single core and sequential cutoff disabled, so that
+    every write to core is inserted into cache (as dirty data in WB mode)
+    """
+    if cache_device is None:
+        cache_device = RamVolume(S.from_MiB(50))
+
+    cache = Cache.start_on_device(cache_device, cache_mode=cache_mode, **kwargs)
+    core = Core.using_device(core_device)
+    cache.add_core(core)
+    cache.set_seq_cut_off_policy(SeqCutOffPolicy.NEVER)
+
+    return cache, core
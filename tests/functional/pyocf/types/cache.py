@@ -39,7 +39,16 @@ from .queue import Queue
 from .stats.cache import CacheInfo
 from .io import IoDir
 from .ioclass import IoClassesInfo, IoClassInfo
-from .stats.shared import UsageStats, RequestsStats, BlocksStats, ErrorsStats
+from .stats.shared import (
+    UsageStats,
+    RequestsStats,
+    BlocksStats,
+    ErrorsStats,
+    ReplacementStats,
+    MetadataLocksStats,
+    CleanerStats,
+    AlruStats,
+)
 from .ctx import OcfCtx
 from .volume import RamVolume, Volume
 
@@ -96,11 +105,19 @@ class CacheConfig(Structure):
         ("_name", c_char * MAX_CACHE_NAME_SIZE),
         ("_cache_mode", c_uint32),
         ("_promotion_policy", c_uint32),
+        ("_replacement_policy", c_uint32),
+        ("_lru_lists", c_uint32),
+        ("_lru_queue_affinity", c_bool),
         ("_cache_line_size", c_uint64),
         ("_metadata_volatile", c_bool),
         ("_locked", c_bool),
         ("_pt_unaligned_io", c_bool),
         ("_use_submit_io_fast", c_bool),
+        ("_use_lookup_index", c_bool),
+        ("_metadata_global_locks", c_uint32),
+        ("_hash_buckets_per_lock", c_uint32),
+        ("_metadata_lock_stats", c_bool),
+        ("_metadata_io_depth", c_uint32),
         ("_backfill", Backfill),
     ]
 
@@ -121,6 +138,8 @@ class CacheAttachConfig(Structure):
         ("_force", c_bool),
         ("_discard_on_start", c_bool),
         ("_disable_cleaner", c_bool),
+        ("_lazy_load", c_bool),
+        ("_compact_metadata", c_bool),
     ]
 
 
@@ -139,9 +158,13 @@ class ConfValidValues:
     cleaning_alru_staleness_time_range = range(1, 3600)
     cleaning_alru_flush_max_buffers_range = range(1, 10000)
     cleaning_alru_activity_threshold_range = range(0, 1000000)
+    cleaning_alru_max_dirty_ratio_range = range(0, 101)
+    cleaning_alru_adaptive_range = range(0, 2)
+    cleaning_alru_elevator_range = range(0, 2)
 
     cleaning_acp_wake_up_time_range = range(0, 10000)
     cleaning_acp_flush_max_buffers_range = range(1, 10000)
+    cleaning_acp_chunk_size_range = range(1, 10240)
 
     seq_cutoff_threshold_rage = range(1, 4294841344)
     seq_cutoff_promotion_range = range(1, 65535)
@@ -180,6 +203,13 @@ class PromotionPolicy(IntEnum):
     DEFAULT = ALWAYS
 
 
+class ReplacementPolicy(IntEnum):
+    LRU = 0
+    CLOCK = 1
+    TWO_Q = 2
+    DEFAULT = LRU
+
+
 class NhitParams(IntEnum):
     INSERTION_THRESHOLD = 0
     TRIGGER_THRESHOLD = 1
@@ -197,11 +227,15 @@ class AlruParams(IntEnum):
     STALE_BUFFER_TIME = 1
     FLUSH_MAX_BUFFERS = 2
     ACTIVITY_THRESHOLD = 3
+    MAX_DIRTY_RATIO = 4
+    ADAPTIVE = 5
+    ELEVATOR = 6
 
 
 class AcpParams(IntEnum):
     WAKE_UP_TIME = 0
     FLUSH_MAX_BUFFERS = 1
+    CHUNK_SIZE = 2
 
 
 class MetadataLayout(IntEnum):
@@ -215,6 +249,9 @@ class Cache:
     DEFAULT_BACKFILL_UNBLOCK = 60000
     DEFAULT_PT_UNALIGNED_IO = False
     DEFAULT_USE_SUBMIT_FAST = False
+    DEFAULT_LRU_LISTS = 32
+    DEFAULT_METADATA_GLOBAL_LOCKS = 4
+    DEFAULT_METADATA_IO_DEPTH = 128
 
     def __init__(
         self,
@@ -222,12 +259,20 @@ class Cache:
         name: str = "cache",
         cache_mode: CacheMode = CacheMode.DEFAULT,
         promotion_policy: PromotionPolicy = PromotionPolicy.DEFAULT,
+        replacement_policy: ReplacementPolicy = ReplacementPolicy.DEFAULT,
         cache_line_size: CacheLineSize = CacheLineSize.DEFAULT,
         metadata_volatile: bool = False,
         max_queue_size: int = DEFAULT_BACKFILL_QUEUE_SIZE,
         queue_unblock_size: int = DEFAULT_BACKFILL_UNBLOCK,
         pt_unaligned_io: bool = DEFAULT_PT_UNALIGNED_IO,
         use_submit_fast: bool = DEFAULT_USE_SUBMIT_FAST,
+        use_lookup_index: bool = False,
+        lru_lists: int = DEFAULT_LRU_LISTS,
+        lru_queue_affinity: bool = False,
+        metadata_global_locks: int = DEFAULT_METADATA_GLOBAL_LOCKS,
+        hash_buckets_per_lock: int = 1,
+        metadata_lock_stats: bool = False,
+        metadata_io_depth: int = DEFAULT_METADATA_IO_DEPTH,
     ):
         self.device = None
         self.started = False
@@ -236,12 +281,20 @@ class Cache:
         self.name = name
         self.cache_mode = cache_mode
         self.promotion_policy = promotion_policy
+        self.replacement_policy = replacement_policy
         self.cache_line_size = cache_line_size
         self.metadata_volatile = metadata_volatile
         self.max_queue_size = max_queue_size
         self.queue_unblock_size = queue_unblock_size
         self.pt_unaligned_io = pt_unaligned_io
         self.use_submit_fast = use_submit_fast
+        self.use_lookup_index = use_lookup_index
+        self.lru_lists = lru_lists
+        self.lru_queue_affinity = lru_queue_affinity
+        self.metadata_global_locks = metadata_global_locks
+        self.hash_buckets_per_lock = hash_buckets_per_lock
+        self.metadata_lock_stats = metadata_lock_stats
+        self.metadata_io_depth = metadata_io_depth
 
         self.cache_handle = c_void_p()
         self._as_parameter_ = self.cache_handle
@@ -258,6 +311,9 @@ class Cache:
             _name=self.name.encode("ascii"),
             _cache_mode=self.cache_mode,
             _promotion_policy=self.promotion_policy,
+            _replacement_policy=self.replacement_policy,
+            _lru_lists=self.lru_lists,
+            _lru_queue_affinity=self.lru_queue_affinity,
             _cache_line_size=self.cache_line_size,
             _metadata_volatile=self.metadata_volatile,
             _backfill=Backfill(
@@ -267,6 +323,11 @@ class Cache:
             _locked=locked,
             _pt_unaligned_io=self.pt_unaligned_io,
             _use_submit_fast=self.use_submit_fast,
+            _use_lookup_index=self.use_lookup_index,
+            _metadata_global_locks=self.metadata_global_locks,
+            _hash_buckets_per_lock=self.hash_buckets_per_lock,
+            _metadata_lock_stats=self.metadata_lock_stats,
+            _metadata_io_depth=self.metadata_io_depth,
         )
 
         status = self.owner.lib.ocf_mngt_cache_start(
@@ -450,6 +511,72 @@ class Cache:
         if status:
             raise OcfError("Error setting cache seq cut off policy promotion count", status)
 
+    def set_flush_queue_depth(self, queue_depth: int):
+        self.write_lock()
+
+        status = self.owner.lib.ocf_mngt_core_set_flush_queue_depth_all(
+            self.cache_handle, queue_depth
+        )
+
+        self.write_unlock()
+
+        if status:
+            raise OcfError("Error setting cache flush queue depth", status)
+
+    def set_cleaner_memory_budget(self, budget: int):
+        self.write_lock()
+
+        status = self.owner.lib.ocf_mngt_cache_set_cleaner_memory_budget(
+            self.cache_handle, budget
+        )
+
+        self.write_unlock()
+
+        if status:
+            raise OcfError("Error setting cleaner memory budget", status)
+
+    def get_cleaner_memory_budget(self):
+        budget = c_uint32()
+
+        self.read_lock()
+
+        status = self.owner.lib.ocf_mngt_cache_get_cleaner_memory_budget(
+            self.cache_handle, byref(budget)
+        )
+
+        self.read_unlock()
+
+        if status:
+            raise OcfError("Error getting cleaner memory budget", status)
+
+        return budget.value
+
+    def set_cleaner_idle_time(self, time_ms: int):
+        self.write_lock()
+
+        status = self.owner.lib.ocf_mngt_cache_set_cleaner_idle_time(self.cache_handle, time_ms)
+
+        self.write_unlock()
+
+        if status:
+            raise OcfError("Error setting cleaner idle time", status)
+
+    def get_cleaner_idle_time(self):
+        time_ms = c_uint32()
+
+        self.read_lock()
+
+        status = self.owner.lib.ocf_mngt_cache_get_cleaner_idle_time(
+            self.cache_handle, byref(time_ms)
+        )
+
+        self.read_unlock()
+
+        if status:
+            raise OcfError("Error getting cleaner idle time", status)
+
+        return time_ms.value
+
     def get_partition_info(self, part_id: int):
         ioclass_info = IoClassInfo()
         self.read_lock()
@@ -471,6 +598,10 @@ class Cache:
             "_min_size": int(ioclass_info._min_size),
             "_max_size": int(ioclass_info._max_size),
             "_cleaning_policy_type": int(ioclass_info._cleaning_policy_type),
+            "_dirty": int(ioclass_info._dirty),
+            "_dirty_high": int(ioclass_info._dirty_high),
+            "_dirty_low": int(ioclass_info._dirty_low),
+            "_dirty_urgent": bool(ioclass_info._dirty_urgent),
         }
 
     def add_partition(
@@ -540,6 +671,18 @@ class Cache:
         if status:
             raise OcfError("Error adding partition to cache", status)
 
+    def set_partition_dirty_watermarks(self, part_id: int, high: int, low: int):
+        self.write_lock()
+
+        status = self.owner.lib.ocf_mngt_cache_io_class_set_dirty_watermarks(
+            self.cache_handle, part_id, high, low
+        )
+
+        self.write_unlock()
+
+        if status:
+            raise OcfError("Error setting ioclass dirty watermarks", status)
+
     def alloc_device_config(self, device, perform_test=True):
         if not device.handle:
             uuid = Uuid(
@@ -577,6 +720,7 @@ class Cache:
         cache_line_size=None,
         open_cores=False,
         disable_cleaner=False,
+        compact_metadata=False,
     ):
         self.device = device
 
@@ -589,6 +733,7 @@ class Cache:
             _force=force,
             _discard_on_start=False,
             _disable_cleaner=disable_cleaner,
+            _compact_metadata=compact_metadata,
         )
 
         self.write_lock()
@@ -608,7 +753,9 @@ class Cache:
                 c.results["error"],
             )
 
-    def standby_attach(self, device, force=False, disable_cleaner=False):
+    def standby_attach(
+        self, device, force=False, disable_cleaner=False, compact_metadata=False
+    ):
         self.device = device
 
         device_config = self.alloc_device_config(device, perform_test=False)
@@ -620,6 +767,7 @@ class Cache:
             _force=force,
             _discard_on_start=False,
             _disable_cleaner=disable_cleaner,
+            _compact_metadata=compact_metadata,
         )
 
         self.write_lock()
@@ -639,7 +787,9 @@ class Cache:
                 c.results["error"],
             )
 
-    def standby_load(self, device, perform_test=True, disable_cleaner=False):
+    def standby_load(
+        self, device, perform_test=True, disable_cleaner=False, compact_metadata=False
+    ):
         self.device = device
 
         device_config = self.alloc_device_config(device, perform_test=perform_test)
@@ -651,6 +801,7 @@ class Cache:
             _force=False,
             _discard_on_start=False,
             _disable_cleaner=disable_cleaner,
+            _compact_metadata=compact_metadata,
         )
 
         self.write_lock()
@@ -679,7 +830,7 @@ class Cache:
         if c.results["error"]:
             raise OcfError("Attaching cache device failed", c.results["error"])
 
-    def load_cache(self, device, open_cores=True, disable_cleaner=False):
+    def load_cache(self, device, open_cores=True, disable_cleaner=False, lazy_load=False):
         self.device = device
 
         device_config = self.alloc_device_config(device)
@@ -691,6 +842,7 @@ class Cache:
             _force=False,
             _discard_on_start=False,
             _disable_cleaner=disable_cleaner,
+            _lazy_load=lazy_load,
         )
 
         self.write_lock()
@@ -723,16 +875,28 @@ class Cache:
 
     @classmethod
     def load_from_device(
-        cls, device, owner=None, name="cache", open_cores=True, disable_cleaner=False
+        cls,
+        device,
+        owner=None,
+        name="cache",
+        open_cores=True,
+        disable_cleaner=False,
+        lazy_load=False,
+        **kwargs,
     ):
         if owner is None:
             owner = OcfCtx.get_default()
 
-        c = cls(name=name, owner=owner)
+        c = cls(name=name, owner=owner, **kwargs)
 
         c.start_cache()
         try:
-            c.load_cache(device, open_cores=open_cores, disable_cleaner=disable_cleaner)
+            c.load_cache(
+                device,
+                open_cores=open_cores,
+                disable_cleaner=disable_cleaner,
+                lazy_load=lazy_load,
+            )
         except:  # noqa E722
             c.stop()
             raise
@@ -740,7 +904,9 @@ class Cache:
         return c
 
     @classmethod
-    def start_on_device(cls, device, owner=None, disable_cleaner=False, **kwargs):
+    def start_on_device(
+        cls, device, owner=None, disable_cleaner=False, compact_metadata=False, **kwargs
+    ):
         if owner is None:
             owner = OcfCtx.get_default()
 
@@ -748,7 +914,12 @@ class Cache:
 
         c.start_cache()
         try:
-            c.attach_device(device, force=True, disable_cleaner=disable_cleaner)
+            c.attach_device(
+                device,
+                force=True,
+                disable_cleaner=disable_cleaner,
+                compact_metadata=compact_metadata,
+            )
         except:  # noqa E722
             c.stop()
             raise
@@ -896,11 +1067,14 @@ class Cache:
             "state": cache_info.state,
             "cleaning_policy": CleaningPolicy(cache_info.cleaning_policy),
             "promotion_policy": PromotionPolicy(cache_info.promotion_policy),
+            "replacement_policy": ReplacementPolicy(cache_info.replacement_policy),
+            "lru_lists": cache_info.lru_lists,
             "cache_line_size": line_size,
             "flushed": CacheLines(cache_info.flushed, line_size),
             "core_count": cache_info.core_count,
             "metadata_footprint": Size(cache_info.metadata_footprint),
             "metadata_end_offset": Size(cache_info.metadata_end_offset),
+            "lazy_load_pending": cache_info.lazy_load_pending,
             "cache_name": cache_name,
         }
 
@@ -931,6 +1105,76 @@ class Cache:
             "errors": struct_to_dict(errors),
         }
 
+    def get_replacement_stats(self, part_id: int = 0):
+        stats = ReplacementStats()
+
+        self.read_lock()
+
+        status = self.owner.lib.ocf_stats_collect_part_replacement(
+            self.cache_handle, part_id, byref(stats)
+        )
+
+        self.read_unlock()
+
+        if status:
+            raise OcfError("Failed getting replacement stats", status)
+
+        return struct_to_dict(stats)
+
+    def get_cleaner_stats(self):
+        stats = CleanerStats()
+
+        self.read_lock()
+
+        status = self.owner.lib.ocf_stats_collect_cleaner(self.cache_handle, byref(stats))
+
+        self.read_unlock()
+
+        if status:
+            raise OcfError("Failed getting cleaner stats", status)
+
+        return struct_to_dict(stats)
+
+    def get_cleaning_alru_stats(self):
+        stats = AlruStats()
+
+        self.read_lock()
+
+        status = self.owner.lib.ocf_stats_collect_cleaning_alru(self.cache_handle, byref(stats))
+
+        self.read_unlock()
+
+        if status:
+            raise OcfError("Failed getting ALRU cleaning stats", status)
+
+        return struct_to_dict(stats)
+
+    def get_metadata_lock_stats(self):
+        stats = MetadataLocksStats()
+
+        self.read_lock()
+
+        status = self.owner.lib.ocf_stats_collect_metadata_locks(
+            self.cache_handle, byref(stats)
+        )
+
+        self.read_unlock()
+
+        if status:
+            raise OcfError("Failed getting metadata lock stats", status)
+
+        shards = stats.global_locks
+
+        return {
+            "global_locks": shards,
+            "hash_locks": stats.hash_locks,
+            "hash_buckets_per_lock": stats.hash_buckets_per_lock,
+            "global": [struct_to_dict(s) for s in stats.global_[:shards]],
+            "hash": [struct_to_dict(s) for s in stats.hash[:shards]],
+            "optimistic_reads": stats.optimistic_reads,
+            "optimistic_retries": stats.optimistic_retries,
+        }
+
     def reset_stats(self):
         self.owner.lib.ocf_core_stats_initialize_all(self.cache_handle)
 
@@ -1047,6 +1291,16 @@ lib.ocf_mngt_core_set_seq_cutoff_threshold_all.argtypes = [c_void_p, c_uint32]
 lib.ocf_mngt_core_set_seq_cutoff_threshold_all.restype = c_int
 lib.ocf_mngt_core_set_seq_cutoff_promotion_count_all.argtypes = [c_void_p, c_uint32]
 lib.ocf_mngt_core_set_seq_cutoff_promotion_count_all.restype = c_int
+lib.ocf_mngt_core_set_flush_queue_depth_all.argtypes = [c_void_p, c_uint32]
+lib.ocf_mngt_core_set_flush_queue_depth_all.restype = c_int
+lib.ocf_mngt_cache_set_cleaner_memory_budget.argtypes = [c_void_p, c_uint32]
+lib.ocf_mngt_cache_set_cleaner_memory_budget.restype = c_int
+lib.ocf_mngt_cache_get_cleaner_memory_budget.argtypes = [c_void_p, c_void_p]
+lib.ocf_mngt_cache_get_cleaner_memory_budget.restype = c_int
+lib.ocf_mngt_cache_set_cleaner_idle_time.argtypes = [c_void_p, c_uint32]
+lib.ocf_mngt_cache_set_cleaner_idle_time.restype = c_int
+lib.ocf_mngt_cache_get_cleaner_idle_time.argtypes = [c_void_p, c_void_p]
+lib.ocf_mngt_cache_get_cleaner_idle_time.restype = c_int
 lib.ocf_stats_collect_cache.argtypes = [
     c_void_p,
     c_void_p,
@@ -1055,6 +1309,14 @@ lib.ocf_stats_collect_cache.argtypes = [
     c_void_p,
 ]
 lib.ocf_stats_collect_cache.restype = c_int
+lib.ocf_stats_collect_part_replacement.argtypes = [c_void_p, c_uint16, c_void_p]
+lib.ocf_stats_collect_part_replacement.restype = c_int
+lib.ocf_stats_collect_cleaner.argtypes = [c_void_p, c_void_p]
+lib.ocf_stats_collect_cleaner.restype = c_int
+lib.ocf_stats_collect_cleaning_alru.argtypes = [c_void_p, c_void_p]
+lib.ocf_stats_collect_cleaning_alru.restype = c_int
+lib.ocf_stats_collect_metadata_locks.argtypes = [c_void_p, c_void_p]
+lib.ocf_stats_collect_metadata_locks.restype = c_int
 lib.ocf_cache_get_info.argtypes = [c_void_p, c_void_p]
 lib.ocf_cache_get_info.restype = c_int
 lib.ocf_mngt_cache_cleaning_set_param.argtypes = [
@@ -1078,6 +1340,13 @@ lib.ocf_mngt_add_partition_to_cache.argtypes = [
 ]
 lib.ocf_mngt_cache_io_classes_configure.restype = c_int
 lib.ocf_mngt_cache_io_classes_configure.argtypes = [c_void_p, c_void_p]
+lib.ocf_mngt_cache_io_class_set_dirty_watermarks.restype = c_int
+lib.ocf_mngt_cache_io_class_set_dirty_watermarks.argtypes = [
+    c_void_p,
+    c_uint32,
+    c_uint8,
+    c_uint8,
+]
 lib.ocf_volume_create.restype = c_int
 lib.ocf_volume_create.argtypes = [c_void_p, c_void_p, c_void_p]
 lib.ocf_volume_destroy.argtypes = [c_void_p]
@@ -38,6 +38,18 @@ class UserMetadata(Structure):
     _fields_ = [("data", c_void_p), ("size", c_size_t)]
 
 
+class FlushProgress(Structure):
+    _fields_ = [
+        ("active", c_bool),
+        ("total", c_uint32),
+        ("flushed", c_uint32),
+        ("in_flight", c_uint32),
+        ("portion", c_uint32),
+        ("elapsed_ms", c_uint64),
+        ("throughput", c_uint64),
+    ]
+
+
 class CoreConfig(Structure):
     MAX_CORE_NAME_SIZE = 32
     _fields_ = [
@@ -169,6 +181,40 @@ class Core:
         if status:
             raise OcfError("Error setting core seq cut off policy promotion count", status)
 
+    def flush(self):
+        self.cache.write_lock()
+
+        c = OcfCompletion([("core", c_void_p), ("priv", c_void_p), ("error", c_int)])
+        self.cache.owner.lib.ocf_mngt_core_flush(self.handle, c, None)
+        c.wait()
+        self.cache.write_unlock()
+
+        if c.results["error"]:
+            raise OcfError("Couldn't flush core", c.results["error"])
+
+    def set_flush_queue_depth(self, queue_depth):
+        self.cache.write_lock()
+
+        status = self.cache.owner.lib.ocf_mngt_core_set_flush_queue_depth(
+            self.handle, queue_depth
+        )
+        self.cache.write_unlock()
+        if status:
+            raise OcfError("Error setting core flush queue depth", status)
+
+    def get_flush_progress(self):
+        progress = FlushProgress()
+
+        self.cache.read_lock()
+        status = self.cache.owner.lib.ocf_mngt_core_get_flush_progress(
+            self.handle, byref(progress)
+        )
+        self.cache.read_unlock()
+        if status:
+            raise OcfError("Failed getting core flush progress", status)
+
+        return struct_to_dict(progress)
+
     def reset_stats(self):
         self.cache.owner.lib.ocf_core_stats_initialize(self.handle)
 
@@ -186,6 +232,11 @@ lib.ocf_mngt_core_set_seq_cutoff_threshold.argtypes = [c_void_p, c_uint32]
 lib.ocf_mngt_core_set_seq_cutoff_threshold.restype = c_int
 lib.ocf_mngt_core_set_seq_cutoff_promotion_count.argtypes = [c_void_p, c_uint32]
 lib.ocf_mngt_core_set_seq_cutoff_promotion_count.restype = c_int
+lib.ocf_mngt_core_flush.argtypes = [c_void_p, c_void_p, c_void_p]
+lib.ocf_mngt_core_set_flush_queue_depth.argtypes = [c_void_p, c_uint32]
+lib.ocf_mngt_core_set_flush_queue_depth.restype = c_int
+lib.ocf_mngt_core_get_flush_progress.argtypes = [c_void_p, c_void_p]
+lib.ocf_mngt_core_get_flush_progress.restype = c_int
 lib.ocf_stats_collect_core.argtypes = [c_void_p, c_void_p, c_void_p, c_void_p, c_void_p]
 lib.ocf_stats_collect_core.restype = c_int
 lib.ocf_core_get_info.argtypes = [c_void_p, c_void_p]
@@ -3,7 +3,7 @@
 # SPDX-License-Identifier: BSD-3-Clause
 #
 
-from ctypes import c_uint8, c_uint32, c_int, c_int16, c_uint16, c_char, c_char_p, Structure
+from ctypes import c_bool, c_uint8, c_uint32, c_int, c_int16, c_uint16, c_char, c_char_p, Structure
 
 
 class IoClassInfo(Structure):
@@ -16,6 +16,10 @@ class IoClassInfo(Structure):
         ("_min_size", c_uint32),
         ("_max_size", c_uint32),
         ("_cleaning_policy_type", c_int),
+        ("_dirty", c_uint32),
+        ("_dirty_high", c_uint8),
+        ("_dirty_low", c_uint8),
+        ("_dirty_urgent", c_bool),
     ]
 
 
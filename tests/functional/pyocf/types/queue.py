@@ -3,7 +3,7 @@
 # SPDX-License-Identifier: BSD-3-Clause
 #
 
-from ctypes import c_void_p, CFUNCTYPE, Structure, byref
+from ctypes import c_void_p, c_uint32, c_uint64, CFUNCTYPE, Structure, byref
 from threading import Thread, Condition, Event, Semaphore
 import weakref
 
@@ -19,6 +19,15 @@ class QueueOps(Structure):
     _fields_ = [("kick", KICK), ("kick_sync", KICK_SYNC), ("stop", STOP)]
 
 
+class QueueReqCacheStats(Structure):
+    _fields_ = [
+        ("alloc_hits", c_uint64),
+        ("alloc_misses", c_uint64),
+        ("free_hits", c_uint64),
+        ("free_misses", c_uint64),
+    ]
+
+
 class Queue:
     pass
 
@@ -42,15 +51,18 @@ def io_queue_run(*, queue: Queue, kick: Condition, stop: Event, sem: Semaphore):
 class Queue:
     _instances_ = weakref.WeakValueDictionary()
 
-    def __init__(self, cache, name):
+    def __init__(self, cache, name, lockless=False):
 
         self.ops = QueueOps(kick=type(self)._kick, stop=type(self)._stop)
         self.name = name
 
         self.handle = c_void_p()
-        status = OcfLib.getInstance().ocf_queue_create(
-            cache.cache_handle, byref(self.handle), byref(self.ops)
+        create = (
+            OcfLib.getInstance().ocf_queue_create_lockless
+            if lockless
+            else OcfLib.getInstance().ocf_queue_create
         )
+        status = create(cache.cache_handle, byref(self.handle), byref(self.ops))
         if status:
             raise OcfError("Couldn't create queue object", status)
 
@@ -99,6 +111,11 @@ class Queue:
         with self.kick_condition:
             self.kick_condition.notify_all()
 
+    def get_req_cache_stats(self):
+        stats = QueueReqCacheStats()
+        OcfLib.getInstance().ocf_queue_get_req_cache_stats(self.handle, byref(stats))
+        return {name: getattr(stats, name) for name, _ in stats._fields_}
+
     def put(self):
         OcfLib.getInstance().ocf_queue_put(self)
 
@@ -142,3 +159,10 @@ class Queue:
         status = [True]
         while any(status):
             status = [q.settle() for q in qlist]
+
+
+lib = OcfLib.getInstance()
+lib.ocf_queue_run_batch.argtypes = [c_void_p, c_uint32]
+lib.ocf_queue_run_batch.restype = c_uint32
+lib.ocf_queue_pending_io.argtypes = [c_void_p]
+lib.ocf_queue_pending_io.restype = c_uint32
@@ -3,7 +3,7 @@
 # SPDX-License-Identifier: BSD-3-Clause
 #
 
-from ctypes import c_uint64, c_uint32, Structure
+from ctypes import c_bool, c_uint64, c_uint32, Structure
 
 
 class _Stat(Structure):
@@ -86,3 +86,69 @@ class ErrorsStats(Structure):
         ("cache_volume_total", _Stat),
         ("total", _Stat),
     ]
+
+
+class ReplacementStats(Structure):
+    _fields_ = [
+        ("insertions", c_uint64),
+        ("ghost_hits", c_uint64),
+        ("ghost_insertions", c_uint64),
+        ("promotions", c_uint64),
+    ]
+
+
+class CleanerStats(Structure):
+    _fields_ = [
+        ("requests", c_uint64),
+        ("core_writes", c_uint64),
+        ("core_write_bytes", c_uint64),
+        ("watermark_triggers", c_uint64),
+        ("watermark_lines", c_uint64),
+        ("pipeline_waits", c_uint64),
+        ("pipeline_wait_ns", c_uint64),
+        ("cache_read_ns", c_uint64),
+        ("core_write_ns", c_uint64),
+        ("core_flush_ns", c_uint64),
+        ("metadata_ns", c_uint64),
+        ("cache_flush_ns", c_uint64),
+        ("idle_runs", c_uint64),
+        ("idle_lines", c_uint64),
+    ]
+
+
+class AlruStats(Structure):
+    _fields_ = [
+        ("adaptive", c_bool),
+        ("batch", c_uint32),
+        ("interval_ms", c_uint32),
+        ("aggressiveness", c_uint32),
+        ("dirty_ratio", c_uint32),
+        ("io_rate", c_uint32),
+        ("latency_us", c_uint32),
+        ("latency_base_us", c_uint32),
+        ("rounds", c_uint64),
+        ("idle_rounds", c_uint64),
+        ("backoffs", c_uint64),
+        ("lines", c_uint64),
+    ]
+
+
+class LockStats(Structure):
+    _fields_ = [
+        ("acquisitions", c_uint64),
+        ("contended", c_uint64),
+        ("wait_ns", c_uint64),
+    ]
+
+
+class MetadataLocksStats(Structure):
+    MAX_GLOBAL_LOCKS = 64
+    _fields_ = [
+        ("global_locks", c_uint32),
+        ("hash_locks", c_uint32),
+        ("hash_buckets_per_lock", c_uint32),
+        ("global_", LockStats * MAX_GLOBAL_LOCKS),
+        ("hash", LockStats * MAX_GLOBAL_LOCKS),
+        ("optimistic_reads", c_uint64),
+        ("optimistic_retries", c_uint64),
+    ]
@@ -0,0 +1,140 @@
+#
+# Copyright(c) 2024 Huawei Technologies
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+from ctypes import c_int
+
+from pyocf.ocf import OcfLib
+from pyocf.types.cache import Cache, CacheMode
+from pyocf.types.core import Core
+from pyocf.types.data import Data
+from pyocf.types.io import IoDir
+from pyocf.types.queue import Queue
+from pyocf.types.shared import OcfCompletion, SeqCutOffPolicy
+from pyocf.types.volume import RamVolume
+from pyocf.types.volume_core import CoreVolume
+from pyocf.utils import Size as S
+
+IO_COUNT = 512
+BATCH_SIZE = 32
+
+
+class ManualQueue(Queue):
+    """I/O queue without worker thread - the test runs it explicitly"""
+
+    def __init__(self, *args, **kwargs):
+        super().__init__(*args, **kwargs)
+        with self.kick_condition:
+            self.stop_event.set()
+            self.kick_condition.notify_all()
+        self.thread.join()
+
+    def kick(self):
+        pass
+
+
+def prepare():
+    cache = Cache.start_on_device(RamVolume(S.from_MiB(50)), cache_mode=CacheMode.WT)
+    core_device = RamVolume(S.from_MiB(50))
+    core = Core.using_device(core_device)
+    cache.add_core(core)
+    cache.set_seq_cut_off_policy(SeqCutOffPolicy.NEVER)
+
+    # Exported object volume submits I/O to the default (first) queue
+    queue = ManualQueue(cache, "manual-io")
+    cache.io_queues.insert(0, queue)
+
+    vol = CoreVolume(core)
+    vol.open()
+
+    return cache, core_device, vol, queue
+
+
+def submit_writes(vol, queue, count):
+    lib = OcfLib.getInstance()
+    completions = []
+
+    for i in range(count):
+        data = Data.from_bytes(bytes([i % 256]) * 4096)
+        comp = OcfCompletion([("err", c_int)])
+        io = vol.new_io(queue, i * 4096, 4096, IoDir.WRITE, 0, 0)
+        io.set_data(data)
+        io.callback = comp.callback
+        io.submit()
+        completions += [(comp, io, data)]
+
+    assert lib.ocf_queue_pending_io(queue) == count
+
+    return completions
+
+
+def drain(queue, run):
+    lib = OcfLib.getInstance()
+    calls = 0
+
+    while lib.ocf_queue_pending_io(queue):
+        run()
+        calls += 1
+
+    return calls
+
+
+def complete(queue, completions):
+    lib = OcfLib.getInstance()
+
+    for comp, _, _ in completions:
+        while not comp.e.is_set():
+            lib.ocf_queue_run(queue)
+        assert comp.results["err"] == 0
+
+
+def test_queue_run_batch(pyocf_ctx):
+    """
+    Check that ocf_queue_run_batch() processes at most requested number of
+    requests per call and that requests processed in batches complete
+    correctly.
+    """
+    lib = OcfLib.getInstance()
+    cache, core_device, vol, queue = prepare()
+
+    completions = submit_writes(vol, queue, IO_COUNT)
+
+    assert lib.ocf_queue_run_batch(queue, BATCH_SIZE) == BATCH_SIZE
+    assert lib.ocf_queue_pending_io(queue) >= IO_COUNT - BATCH_SIZE
+
+    drain(queue, lambda: lib.ocf_queue_run_batch(queue, BATCH_SIZE))
+    assert lib.ocf_queue_run_batch(queue, BATCH_SIZE) == 0
+
+    complete(queue, completions)
+
+    vol.close()
+    cache.io_queues.remove(queue)
+    cache.io_queues += [queue]
+    assert vol.md5() == core_device.md5()
+    cache.stop()
+
+
+def test_queue_run_batch_vs_single(pyocf_ctx):
+    """
+    Compare draining the queue one request at a time against batched
+    dequeue. Each ocf_queue_run_single()/ocf_queue_run_batch() call takes
+    the queue lock exactly once, so number of calls needed to drain the
+    queue equals number of lock acquisitions.
+    """
+    lib = OcfLib.getInstance()
+    cache, core_device, vol, queue = prepare()
+
+    completions = submit_writes(vol, queue, IO_COUNT)
+    single_calls = drain(queue, lambda: lib.ocf_queue_run_single(queue))
+    complete(queue, completions)
+
+    completions = submit_writes(vol, queue, IO_COUNT)
+    batch_calls = drain(queue, lambda: lib.ocf_queue_run_batch(queue, BATCH_SIZE))
+    complete(queue, completions)
+
+    assert single_calls >= IO_COUNT
+    assert batch_calls < single_calls
+
+    vol.close()
+    cache.stop()
@@ -0,0 +1,83 @@
+#
+# Copyright(c) 2024 Huawei Technologies
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+from ctypes import c_int
+
+import pytest
+
+from pyocf.helpers import queue_stress
+from pyocf.types.cache import Cache, CacheMode
+from pyocf.types.core import Core
+from pyocf.types.data import Data
+from pyocf.types.io import IoDir
+from pyocf.types.queue import Queue
+from pyocf.types.shared import OcfCompletion
+from pyocf.types.volume import RamVolume
+from pyocf.types.volume_core import CoreVolume
+from pyocf.utils import Size as S
+
+
+@pytest.mark.parametrize("producers", [1, 4, 16])
+def test_queue_lockless_stress(pyocf_ctx, producers):
+    """
+    Push requests to single queue from many threads while it is being
+    processed and check that no request is lost and that requests are
+    handled in order they were pushed by each producer. Compare
+    throughput with spinlock protected queue.
+    """
+    requests = 20000
+    cache = Cache.start_on_device(RamVolume(S.from_MiB(50)))
+
+    result, locked_ns = queue_stress(cache, False, producers, requests)
+    assert result == 0
+
+    result, lockless_ns = queue_stress(cache, True, producers, requests)
+    assert result == 0
+
+    total = producers * requests
+    print(
+        f"\n{producers} producers: locked {total * 1e9 / locked_ns:.0f} req/s, "
+        f"lockless {total * 1e9 / lockless_ns:.0f} req/s"
+    )
+
+    cache.stop()
+
+
+@pytest.mark.parametrize("cache_mode", [CacheMode.WT, CacheMode.WB])
+def test_queue_lockless_io(pyocf_ctx, cache_mode):
+    """Run I/O through lockless queue and check data integrity"""
+    cache_device = RamVolume(S.from_MiB(50))
+    core_device = RamVolume(S.from_MiB(50))
+
+    cache = Cache.start_on_device(cache_device, cache_mode=cache_mode)
+    core = Core.using_device(core_device)
+    cache.add_core(core)
+
+    # Exported object volume submits I/O to the default (first) queue
+    cache.io_queues.insert(0, Queue(cache, "lockless-io", lockless=True))
+    queue = cache.get_default_queue()
+
+    vol = CoreVolume(core)
+    vol.open()
+
+    completions = []
+    for i in range(1024):
+        data = Data.from_bytes(bytes([i % 256]) * 4096)
+        comp = OcfCompletion([("err", c_int)])
+        io = vol.new_io(queue, (i * 4096 * 7) % S.from_MiB(20).B, 4096, IoDir.WRITE, 0, 0)
+        io.set_data(data)
+        io.callback = comp.callback
+        io.submit()
+        completions += [(comp, io, data)]
+
+    for comp, _, _ in completions:
+        comp.wait()
+        assert comp.results["err"] == 0
+
+    vol.close()
+    cache.flush()
+    assert vol.md5() == core_device.md5()
+
+    cache.stop()
@@ -0,0 +1,61 @@
+#
+# Copyright(c) 2024 Huawei Technologies
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+from ctypes import c_int
+
+from pyocf.types.cache import Cache
+from pyocf.types.core import Core
+from pyocf.types.data import Data
+from pyocf.types.io import IoDir
+from pyocf.types.shared import OcfCompletion
+from pyocf.types.volume import RamVolume
+from pyocf.types.volume_core import CoreVolume
+from pyocf.utils import Size as S
+
+
+def test_queue_req_cache_hit_rate(pyocf_ctx):
+    """
+    Run sequence of 4k I/Os and check that after the first ones requests
+    are allocated from and returned to the I/O queue's cache of free
+    requests rather than the shared request allocator.
+    """
+    io_count = 1000
+
+    cache = Cache.start_on_device(RamVolume(S.from_MiB(50)))
+    core = Core.using_device(RamVolume(S.from_MiB(50)))
+    cache.add_core(core)
+    queue = cache.get_default_queue()
+
+    vol = CoreVolume(core)
+    vol.open()
+
+    before = queue.get_req_cache_stats()
+
+    for i in range(io_count):
+        comp = OcfCompletion([("err", c_int)])
+        io = vol.new_io(queue, (i % 256) * 4096, 4096, IoDir.WRITE, 0, 0)
+        io.set_data(Data(4096))
+        io.callback = comp.callback
+        io.submit()
+        comp.wait()
+        assert comp.results["err"] == 0
+
+    vol.close()
+    cache.settle()
+
+    after = queue.get_req_cache_stats()
+    stats = {name: after[name] - before[name] for name in after}
+
+    allocs = stats["alloc_hits"] + stats["alloc_misses"]
+    frees = stats["free_hits"] + stats["free_misses"]
+
+    print(f"\nalloc hit rate {stats['alloc_hits'] / allocs:.3f}, {stats}")
+
+    assert allocs >= io_count
+    assert frees >= io_count
+    assert stats["alloc_hits"] >= io_count - 10
+    assert stats["free_misses"] == 0
+
+    cache.stop()
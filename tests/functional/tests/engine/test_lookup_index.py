@@ -0,0 +1,185 @@
+#
+# Copyright(c) 2024 Huawei Technologies
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+import random
+import pytest
+
+from pyocf.types.cache import Cache, CacheMode
+from pyocf.types.data import Data
+from pyocf.types.io import IoDir
+from pyocf.types.shared import SeqCutOffPolicy
+from pyocf.types.volume import RamVolume, Volume
+from pyocf.types.volume_core import CoreVolume
+from pyocf.helpers import (
+    BLOCK,
+    io_to_exp_obj,
+    lookup_bench,
+    lookup_req_bench,
+    start_cache_with_core,
+    write_blocks,
+)
+from pyocf.utils import Size as S
+
+
+def block_data(block, generation):
+    return bytes([(block + generation) % 251]) * BLOCK
+
+
+def check_blocks(vol, queue, expected):
+    for block, generation in expected.items():
+        data = Data(BLOCK)
+        assert io_to_exp_obj(vol, queue, block * BLOCK, data, IoDir.READ) == 0
+        assert data.get_bytes() == block_data(block, generation), (
+            f"Data mismatch in block {block}"
+        )
+
+
+@pytest.mark.parametrize("cache_mode", [CacheMode.WT, CacheMode.WB])
+def test_lookup_index_io(pyocf_ctx, cache_mode):
+    """
+    Overwrite random blocks of core bigger than cache, so that cache lines
+    are repeatedly evicted and remapped, and check that data read through
+    cache with lookup index enabled is consistent and read hits are served.
+    """
+    core_blocks = int(S.from_MiB(120)) // BLOCK
+
+    cache, core = start_cache_with_core(
+        RamVolume(S.from_MiB(120)), cache_mode=cache_mode, use_lookup_index=True
+    )
+
+    random.seed(1)
+    expected = {}
+    for generation in range(2):
+        blocks = random.sample(range(core_blocks), core_blocks // 4)
+        write_blocks(cache, core, blocks, lambda block: block_data(block, generation))
+        expected.update((block, generation) for block in blocks)
+
+    check_blocks(CoreVolume(core), cache.get_default_queue(), expected)
+
+    stats = cache.get_stats()
+    assert stats["req"]["rd_hits"]["value"] > 0
+    assert stats["req"]["wr_hits"]["value"] > 0
+
+    cache.stop()
+
+
+def test_lookup_index_load(pyocf_ctx):
+    """
+    Check that lookup index is populated from collision table loaded from
+    cache device after clean shutdown.
+    """
+    cache_device = RamVolume(S.from_MiB(50))
+    core_device = RamVolume(S.from_MiB(10))
+    blocks = 1000
+
+    cache, core = start_cache_with_core(core_device, cache_device, use_lookup_index=True)
+    write_blocks(cache, core, range(blocks), lambda block: block_data(block, 0))
+    expected = {block: 0 for block in range(blocks)}
+
+    cache.stop()
+
+    cache = Cache.load_from_device(cache_device, use_lookup_index=True)
+    core = cache.get_core_by_name("core")
+    cache.set_seq_cut_off_policy(SeqCutOffPolicy.NEVER)
+    queue = cache.get_default_queue()
+    vol = CoreVolume(core)
+
+    check_blocks(vol, queue, expected)
+
+    stats = cache.get_stats()
+    assert stats["req"]["rd_hits"]["value"] == blocks
+    assert stats["usage"]["dirty"]["value"] == blocks
+
+    cache.stop()
+
+
+class NullVolume(Volume):
+    """Volume of arbitrary size discarding all I/O, for metadata benchmarks"""
+
+    size = S.from_GiB(1)
+
+    def get_length(self):
+        return self.size
+
+    def get_max_io_size(self):
+        return S.from_KiB(128)
+
+    def do_submit_io(self, io):
+        io.contents._end(io, 0)
+
+    def do_submit_flush(self, flush):
+        flush.contents._end(flush, 0)
+
+    def do_submit_discard(self, discard):
+        discard.contents._end(discard, 0)
+
+
+@pytest.mark.parametrize(
+    "lines",
+    [
+        S.from_MiB(4).B,
+        pytest.param(S.from_MiB(100).B, marks=pytest.mark.long),
+    ],
+)
+def test_lookup_index_bench(pyocf_ctx, lines):
+    """
+    Compare lookup time of collision list walk and lookup index at different
+    load factors of the collision table.
+    """
+    queries = 2000000
+
+    NullVolume.size = S(lines * BLOCK)
+    pyocf_ctx.register_volume_type(NullVolume)
+
+    cache = Cache.start_on_device(NullVolume(), metadata_volatile=True, use_lookup_index=True)
+
+    print()
+    for load_pct in [25, 50, 75, 100]:
+        result, chain_ns, index_ns = lookup_bench(cache, load_pct, queries)
+        assert result == 0
+
+        print(
+            f"{lines} lines, load {load_pct}%: "
+            f"collision list {chain_ns / queries:.1f} ns/lookup, "
+            f"lookup index {index_ns / queries:.1f} ns/lookup"
+        )
+
+    cache.stop()
+
+
+@pytest.mark.parametrize(
+    "lines",
+    [
+        S.from_MiB(4).B,
+        pytest.param(S.from_MiB(100).B, marks=pytest.mark.long),
+    ],
+)
+def test_lookup_prefetch_bench(pyocf_ctx, lines):
+    """
+    Compare time of looking up multi-line requests hitting fully populated
+    cache line by line and with metadata prefetching.
+    """
+    lookups = 2000000
+
+    NullVolume.size = S(lines * BLOCK)
+    pyocf_ctx.register_volume_type(NullVolume)
+
+    cache = Cache.start_on_device(NullVolume(), metadata_volatile=True, use_lookup_index=True)
+
+    print()
+    for use_index in [False, True]:
+        for req_size in [S.from_KiB(4), S.from_KiB(128), S.from_KiB(256), S.from_MiB(1)]:
+            req_lines = req_size.B // BLOCK
+            requests = lookups // req_lines
+            result, single_ns, batch_ns = lookup_req_bench(cache, use_index, req_lines, requests)
+            assert result == 0
+
+            print(
+                f"{'lookup index' if use_index else 'collision list'}, {req_size}: "
+                f"{single_ns / requests / 1000:.2f} us/req before, "
+                f"{batch_ns / requests / 1000:.2f} us/req with prefetch"
+            )
+
+    cache.stop()
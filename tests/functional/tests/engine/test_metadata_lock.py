@@ -0,0 +1,162 @@
+#
+# Copyright(c) 2024 Huawei Technologies
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+import random
+import pytest
+
+from pyocf.types.cache import Cache, CacheMode
+from pyocf.types.data import Data
+from pyocf.types.io import IoDir
+from pyocf.types.shared import OcfError
+from pyocf.types.volume import RamVolume
+from pyocf.types.volume_core import CoreVolume
+from pyocf.helpers import BLOCK, io_to_exp_obj, start_cache_with_core
+from pyocf.utils import Size as S
+
+
+def block_data(block, generation, size=BLOCK):
+    return Data.from_bytes(bytes([(block + generation) % 251]) * size)
+
+
+@pytest.mark.parametrize("global_locks", [1, 3, 64])
+@pytest.mark.parametrize("buckets_per_lock", [1, 16, 1024])
+def test_metadata_lock_sharding(pyocf_ctx, global_locks, buckets_per_lock):
+    """
+    Overwrite random ranges of core bigger than cache with different numbers
+    of global metadata lock shards and hash buckets per lock, check that data
+    is consistent and that lock stats account acquisitions of all shards.
+    """
+    core_blocks = int(S.from_MiB(120)) // BLOCK
+    max_blocks = 8
+
+    cache, core = start_cache_with_core(
+        RamVolume(S.from_MiB(120)),
+        metadata_global_locks=global_locks,
+        hash_buckets_per_lock=buckets_per_lock,
+        metadata_lock_stats=True,
+    )
+    queue = cache.get_default_queue()
+    vol = CoreVolume(core)
+
+    random.seed(1)
+    expected = {}
+    for generation in range(2):
+        for _ in range(core_blocks // 16):
+            start = random.randrange(core_blocks - max_blocks)
+            count = random.randint(1, max_blocks)
+            data = Data.from_bytes(
+                b"".join(
+                    block_data(start + i, generation).get_bytes() for i in range(count)
+                )
+            )
+            assert io_to_exp_obj(vol, queue, start * BLOCK, data, IoDir.WRITE) == 0
+            for i in range(count):
+                expected[start + i] = generation
+
+    for block, generation in expected.items():
+        data = Data(BLOCK)
+        assert io_to_exp_obj(vol, queue, block * BLOCK, data, IoDir.READ) == 0
+        assert data.get_bytes() == block_data(block, generation).get_bytes(), (
+            f"Data mismatch in block {block}"
+        )
+
+    stats = cache.get_metadata_lock_stats()
+    assert stats["global_locks"] == global_locks
+    assert stats["hash_buckets_per_lock"] == buckets_per_lock
+    assert len(stats["global"]) == global_locks
+    assert all(s["acquisitions"] > 0 for s in stats["global"])
+    assert sum(s["acquisitions"] for s in stats["hash"]) > 0
+    for s in stats["global"] + stats["hash"]:
+        assert s["contended"] <= s["acquisitions"]
+
+    cache.reset_stats()
+    stats = cache.get_metadata_lock_stats()
+    assert all(s["acquisitions"] == 0 for s in stats["global"] + stats["hash"])
+
+    cache.stop()
+
+
+@pytest.mark.parametrize("use_lookup_index", [False, True])
+def test_metadata_lock_optimistic_read(pyocf_ctx, use_lookup_index):
+    """
+    Check that read hits are looked up without taking hash bucket locks
+    when lookup index is enabled, and that data read this way is correct.
+    """
+    blocks = 256
+
+    cache, core = start_cache_with_core(
+        RamVolume(S.from_MiB(10)),
+        cache_mode=CacheMode.WT,
+        use_lookup_index=use_lookup_index,
+        metadata_lock_stats=True,
+    )
+    queue = cache.get_default_queue()
+    vol = CoreVolume(core)
+
+    for block in range(0, blocks, 4):
+        data = Data.from_bytes(
+            b"".join(block_data(block + i, 0).get_bytes() for i in range(4))
+        )
+        assert io_to_exp_obj(vol, queue, block * BLOCK, data, IoDir.WRITE) == 0
+
+    cache.reset_stats()
+
+    for block in range(blocks):
+        data = Data(BLOCK)
+        assert io_to_exp_obj(vol, queue, block * BLOCK, data, IoDir.READ) == 0
+        assert data.get_bytes() == block_data(block, 0).get_bytes()
+
+    stats = cache.get_metadata_lock_stats()
+    assert stats["optimistic_retries"] == 0
+    if use_lookup_index:
+        assert stats["optimistic_reads"] == blocks
+        assert sum(s["acquisitions"] for s in stats["hash"]) == 0
+    else:
+        assert stats["optimistic_reads"] == 0
+        assert sum(s["acquisitions"] for s in stats["hash"]) >= blocks
+
+    cache.stop()
+
+
+def test_metadata_lock_hash_locks_count(pyocf_ctx):
+    """
+    Check that number of hash bucket locks shrinks proportionally to number
+    of hash buckets per lock.
+    """
+    hash_locks = []
+    for buckets_per_lock in [1, 4]:
+        cache = Cache.start_on_device(
+            RamVolume(S.from_MiB(50)),
+            hash_buckets_per_lock=buckets_per_lock,
+            metadata_lock_stats=True,
+        )
+        hash_locks.append(cache.get_metadata_lock_stats()["hash_locks"])
+        cache.stop()
+
+    assert hash_locks[1] == (hash_locks[0] + 3) // 4
+
+
+def test_metadata_lock_stats_disabled(pyocf_ctx):
+    cache = Cache.start_on_device(RamVolume(S.from_MiB(50)))
+
+    with pytest.raises(OcfError):
+        cache.get_metadata_lock_stats()
+
+    cache.stop()
+
+
+@pytest.mark.parametrize(
+    "cfg",
+    [
+        {"metadata_global_locks": 0},
+        {"metadata_global_locks": 65},
+        {"hash_buckets_per_lock": 0},
+        {"hash_buckets_per_lock": 3},
+        {"hash_buckets_per_lock": 2048},
+    ],
+)
+def test_metadata_lock_invalid_config(pyocf_ctx, cfg):
+    with pytest.raises(OcfError):
+        Cache.start_on_device(RamVolume(S.from_MiB(50)), **cfg)
@@ -6,14 +6,21 @@
 import logging
 from math import ceil, isclose
 from ctypes import c_int
+from time import sleep
 
 import pytest
 
-from pyocf.types.cache import Cache, CacheMode
+from pyocf.types.cache import Cache, CacheMode, ReplacementPolicy
 from pyocf.types.core import Core
 from pyocf.types.data import Data
 from pyocf.types.io import IoDir
-from pyocf.types.shared import OcfCompletion, CacheLineSize, SeqCutOffPolicy, CacheLines
+from pyocf.types.shared import (
+    OcfCompletion,
+    OcfError,
+    CacheLineSize,
+    SeqCutOffPolicy,
+    CacheLines,
+)
 from pyocf.types.volume import RamVolume
 from pyocf.types.volume_core import CoreVolume
 from pyocf.utils import Size
@@ -172,6 +179,192 @@ def test_evict_overflown_pinned(pyocf_ctx, cls: CacheLineSize):
     ), "Overflown part has not been evicted"
 
 
+@pytest.mark.parametrize("policy", ReplacementPolicy)
+def test_eviction_keeps_referenced(pyocf_ctx, policy: ReplacementPolicy):
+    """
+    Fill the cache, hit its first half and then overwrite a quarter of the
+    cache with new data. Check that the cache lines hit before were not evicted.
+    """
+    cache_device = RamVolume(Size.from_MiB(50))
+    core_device = RamVolume(Size.from_MiB(100))
+    cache = Cache.start_on_device(
+        cache_device, cache_mode=CacheMode.WT, replacement_policy=policy
+    )
+    core = Core.using_device(core_device)
+    cache.add_core(core)
+    cache.set_seq_cut_off_policy(SeqCutOffPolicy.NEVER)
+    vol = CoreVolume(core)
+
+    assert cache.get_stats()["conf"]["replacement_policy"] == policy
+
+    cache_size = cache.get_stats()["conf"]["size"]
+    chunk = Size.from_KiB(128)
+    chunks = cache_size.B // chunk.B
+    data = Data(chunk)
+
+    for i in range(chunks):
+        send_io(vol, data, i * chunk.B)
+
+    for i in range(chunks // 2):
+        send_io(vol, data, i * chunk.B)
+
+    for i in range(chunks, chunks + chunks // 4):
+        send_io(vol, data, i * chunk.B)
+
+    for i in range(chunks // 2):
+        send_io(vol, data, i * chunk.B)
+
+    stats = wait_for_requests(cache, chunks + chunks // 2 + chunks // 4 + chunks // 2)
+
+    # Only first fill and new data should miss
+    assert stats["req"]["wr_full_misses"]["value"] == chunks + chunks // 4
+    assert stats["req"]["wr_partial_misses"]["value"] == 0
+
+
+def test_replacement_policy_load(pyocf_ctx):
+    """Check that replacement policy is preserved across cache stop and load."""
+    cache_device = RamVolume(Size.from_MiB(50))
+    cache = Cache.start_on_device(cache_device, replacement_policy=ReplacementPolicy.CLOCK)
+    cache.stop()
+
+    cache = Cache.load_from_device(cache_device)
+    assert cache.get_stats()["conf"]["replacement_policy"] == ReplacementPolicy.CLOCK
+    cache.stop()
+
+
+@pytest.mark.parametrize("lru_queue_affinity", [False, True])
+@pytest.mark.parametrize("lru_lists", [1, 7, 64])
+def test_eviction_lru_lists(pyocf_ctx, lru_lists: int, lru_queue_affinity: bool):
+    """
+    Write twice the cache size with custom number of LRU lists and check
+    that whole cache gets used, the most recent data stays in cache and
+    the number of lists is preserved across cache stop and load.
+    """
+    cache_device = RamVolume(Size.from_MiB(50))
+    core_device = RamVolume(Size.from_MiB(100))
+    cache = Cache.start_on_device(
+        cache_device,
+        cache_mode=CacheMode.WT,
+        lru_lists=lru_lists,
+        lru_queue_affinity=lru_queue_affinity,
+    )
+    core = Core.using_device(core_device)
+    cache.add_core(core)
+    cache.set_seq_cut_off_policy(SeqCutOffPolicy.NEVER)
+    vol = CoreVolume(core)
+
+    cache_size = cache.get_stats()["conf"]["size"]
+    chunk = Size.from_KiB(128)
+    chunks = cache_size.B // chunk.B
+    data = Data(chunk)
+
+    for i in range(chunks * 2):
+        send_io(vol, data, i * chunk.B)
+
+    stats = wait_for_requests(cache, chunks * 2)
+    assert stats["conf"]["lru_lists"] == lru_lists
+    assert stats["usage"]["occupancy"]["value"] == cache_size.blocks_4k
+
+    cache.stop()
+
+    cache = Cache.load_from_device(cache_device)
+    assert cache.get_stats()["conf"]["lru_lists"] == lru_lists
+    core = cache.get_core_by_name("core")
+    cache.set_seq_cut_off_policy(SeqCutOffPolicy.NEVER)
+    vol = CoreVolume(core)
+
+    send_io(vol, data, (chunks * 2 - 1) * chunk.B)
+    stats = wait_for_requests(cache, 1)
+    assert stats["req"]["wr_hits"]["value"] == 1
+
+    cache.stop()
+
+
+@pytest.mark.parametrize("lru_lists", [0, 65])
+def test_eviction_lru_lists_invalid(pyocf_ctx, lru_lists: int):
+    """Check that cache cannot be started with invalid number of LRU lists."""
+    with pytest.raises(OcfError):
+        Cache.start_on_device(RamVolume(Size.from_MiB(50)), lru_lists=lru_lists)
+
+
+@pytest.mark.parametrize("policy", [ReplacementPolicy.LRU, ReplacementPolicy.TWO_Q])
+def test_eviction_scan_resistance(pyocf_ctx, policy: ReplacementPolicy):
+    """
+    Hit a working set of a quarter of the cache and then write sequential
+    data twice the size of the cache. Check that with 2Q the working set
+    survives the scan and that the ghost list recognizes core lines which
+    were recently evicted by the scan.
+    """
+    cache_device = RamVolume(Size.from_MiB(50))
+    core_device = RamVolume(Size.from_MiB(100))
+    cache = Cache.start_on_device(
+        cache_device, cache_mode=CacheMode.WT, replacement_policy=policy
+    )
+    core = Core.using_device(core_device)
+    cache.add_core(core)
+    cache.set_seq_cut_off_policy(SeqCutOffPolicy.NEVER)
+    vol = CoreVolume(core)
+
+    cache_size = cache.get_stats()["conf"]["size"]
+    chunk = Size.from_KiB(128)
+    chunks = cache_size.B // chunk.B
+    hot_chunks = chunks // 4
+    scan_chunks = chunks * 2
+    data = Data(chunk)
+
+    for _ in range(2):
+        for i in range(hot_chunks):
+            send_io(vol, data, i * chunk.B)
+
+    for i in range(hot_chunks, hot_chunks + scan_chunks):
+        send_io(vol, data, i * chunk.B)
+
+    stats = wait_for_requests(cache, hot_chunks * 2 + scan_chunks)
+    misses = stats["req"]["wr_full_misses"]["value"] + stats["req"]["wr_partial_misses"]["value"]
+
+    for i in range(hot_chunks):
+        send_io(vol, data, i * chunk.B)
+
+    stats = wait_for_requests(cache, hot_chunks * 3 + scan_chunks)
+    hot_misses = (
+        stats["req"]["wr_full_misses"]["value"]
+        + stats["req"]["wr_partial_misses"]["value"]
+        - misses
+    )
+
+    if policy == ReplacementPolicy.LRU:
+        assert hot_misses == hot_chunks
+        return
+
+    assert hot_misses == 0
+
+    # Scan evicted from probation the scan data itself
+    replacement = cache.get_replacement_stats()
+    assert replacement["promotions"] > 0
+    assert replacement["ghost_insertions"] >= (scan_chunks - chunks) * chunk.blocks_4k
+    assert replacement["ghost_hits"] == 0
+
+    for i in range(hot_chunks, hot_chunks + scan_chunks):
+        send_io(vol, data, i * chunk.B)
+
+    replacement = cache.get_replacement_stats()
+    assert replacement["ghost_hits"] > 0
+    assert replacement["insertions"] > replacement["ghost_hits"]
+
+
+def wait_for_requests(cache, count):
+    # Request stats are updated after completion, wait until all are accounted
+    for _ in range(100):
+        stats = cache.get_stats()
+        if stats["req"]["wr_total"]["value"] == count:
+            break
+        sleep(0.01)
+
+    assert stats["req"]["wr_total"]["value"] == count
+
+    return stats
+
+
 def send_io(vol: CoreVolume, data: Data, addr: int = 0, target_ioclass: int = 0):
     vol.open()
     io = vol.new_io(
@@ -0,0 +1,82 @@
+#
+# Copyright(c) 2024 Huawei Technologies
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+import pytest
+
+from pyocf.types.cache import Cache, CleaningPolicy, AcpParams
+from pyocf.types.core import Core
+from pyocf.types.shared import OcfError
+from pyocf.types.volume import RamVolume
+from pyocf.helpers import BLOCK, block_data, run_cleaner, start_cache_with_core, write_blocks
+from pyocf.utils import Size as S
+
+CHUNK_BLOCKS = int(S.from_MiB(1)) // BLOCK
+
+
+def test_acp_chunk_size(pyocf_ctx):
+    """
+    Configure 1 MiB ACP chunks, dirty several chunks with different amount
+    of data and check that cleaner picks them in order of dirtiness, cleaning
+    exactly one chunk per iteration.
+    """
+    core_device = RamVolume(S.from_MiB(20))
+    cache, core = start_cache_with_core(core_device)
+    cache.set_cleaning_policy_param(CleaningPolicy.ACP, AcpParams.CHUNK_SIZE, 1)
+    cache.set_cleaning_policy_param(CleaningPolicy.ACP, AcpParams.FLUSH_MAX_BUFFERS, 1000)
+    cache.set_cleaning_policy(CleaningPolicy.ACP)
+    queue = cache.get_default_queue()
+    initial_data = core_device.get_bytes()
+
+    # chunk id -> number of dirty blocks, in expected cleaning order
+    chunks = {3: 200, 7: 50, 12: 10}
+    for chunk, count in chunks.items():
+        write_blocks(cache, core, range(chunk * CHUNK_BLOCKS, chunk * CHUNK_BLOCKS + count))
+
+    dirty = sum(chunks.values())
+    assert core.get_stats()["usage"]["dirty"]["value"] == dirty
+
+    for chunk, count in chunks.items():
+        run_cleaner(cache, queue)
+        dirty -= count
+        assert core.get_stats()["usage"]["dirty"]["value"] == dirty
+
+        core_data = core_device.get_bytes()
+        for block in range(chunk * CHUNK_BLOCKS, (chunk + 1) * CHUNK_BLOCKS):
+            expected = (
+                block_data(block)
+                if block < chunk * CHUNK_BLOCKS + count
+                else initial_data[block * BLOCK : (block + 1) * BLOCK]
+            )
+            assert core_data[block * BLOCK : (block + 1) * BLOCK] == expected
+
+    cache.stop()
+
+
+def test_acp_chunk_size_change(pyocf_ctx):
+    cache_device = RamVolume(S.from_MiB(50))
+    cache = Cache.start_on_device(cache_device)
+    cache.add_core(Core.using_device(RamVolume(S.from_MiB(10))))
+
+    for value in [0, 10241]:
+        with pytest.raises(OcfError):
+            cache.set_cleaning_policy_param(CleaningPolicy.ACP, AcpParams.CHUNK_SIZE, value)
+
+    cache.set_cleaning_policy_param(CleaningPolicy.ACP, AcpParams.CHUNK_SIZE, 4)
+    cache.set_cleaning_policy(CleaningPolicy.ACP)
+
+    with pytest.raises(OcfError):
+        cache.set_cleaning_policy_param(CleaningPolicy.ACP, AcpParams.CHUNK_SIZE, 8)
+    cache.set_cleaning_policy_param(CleaningPolicy.ACP, AcpParams.CHUNK_SIZE, 4)
+
+    cache.stop()
+    cache = Cache.load_from_device(cache_device)
+
+    with pytest.raises(OcfError):
+        cache.set_cleaning_policy_param(CleaningPolicy.ACP, AcpParams.CHUNK_SIZE, 8)
+
+    cache.set_cleaning_policy(CleaningPolicy.NOP)
+    cache.set_cleaning_policy_param(CleaningPolicy.ACP, AcpParams.CHUNK_SIZE, 8)
+
+    cache.stop()
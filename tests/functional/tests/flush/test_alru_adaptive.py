@@ -0,0 +1,103 @@
+#
+# Copyright(c) 2024 Huawei Technologies
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+import time
+import pytest
+
+from pyocf.types.cache import Cache, CleaningPolicy, AlruParams
+from pyocf.types.shared import OcfError
+from pyocf.types.volume import RamVolume
+from pyocf.helpers import BLOCK, block_data, run_cleaner, start_cache_with_core, write_blocks
+from pyocf.utils import Size as S
+
+MAX_BATCH = 10000
+
+
+def prepare(blocks):
+    core_device = RamVolume(S.from_MiB(20))
+    cache, core = start_cache_with_core(core_device)
+    cache.set_cleaning_policy_param(CleaningPolicy.ALRU, AlruParams.WAKE_UP_TIME, 0)
+    cache.set_cleaning_policy_param(CleaningPolicy.ALRU, AlruParams.ADAPTIVE, 1)
+    write_blocks(cache, core, range(blocks))
+
+    return cache, core, core_device
+
+
+def test_alru_adaptive_idle(pyocf_ctx):
+    """
+    Check that adaptive ALRU cleans with maximum batch and without delay
+    between rounds when cache is idle, regardless of dirty data age.
+    """
+    blocks = 3000
+
+    cache, core, core_device = prepare(blocks)
+    cache.set_cleaning_policy_param(CleaningPolicy.ALRU, AlruParams.ACTIVITY_THRESHOLD, 0)
+
+    interval = run_cleaner(cache, cache.get_default_queue())
+
+    stats = cache.get_cleaning_alru_stats()
+    assert stats["adaptive"]
+    assert stats["aggressiveness"] == 1000
+    assert stats["batch"] == MAX_BATCH
+    assert stats["rounds"] == 1
+    assert stats["idle_rounds"] == 1
+    assert stats["lines"] == blocks
+    assert interval == stats["interval_ms"] == 0
+
+    assert core.get_stats()["usage"]["dirty"]["value"] == 0
+
+    core_data = core_device.get_bytes()
+    for block in range(blocks):
+        assert core_data[block * BLOCK : (block + 1) * BLOCK] == block_data(block)
+
+    cache.stop()
+
+
+def test_alru_adaptive_load(pyocf_ctx):
+    """
+    Check that adaptive ALRU measures foreground I/O rate and backs off
+    cleaning of stale data while cache is busy.
+    """
+    blocks = 3000
+
+    cache, core, core_device = prepare(blocks)
+    cache.set_cleaning_policy_param(CleaningPolicy.ALRU, AlruParams.STALE_BUFFER_TIME, 1)
+    time.sleep(2.1)
+
+    interval = run_cleaner(cache, cache.get_default_queue())
+
+    stats = cache.get_cleaning_alru_stats()
+    assert stats["io_rate"] > 0
+    assert stats["dirty_ratio"] > 0
+    assert 0 < stats["aggressiveness"] < 1000
+    assert 0 < stats["batch"] < MAX_BATCH
+    assert stats["rounds"] == 1
+    assert stats["idle_rounds"] == 0
+    assert stats["lines"] == min(blocks, stats["batch"])
+    assert interval == stats["interval_ms"] > 0
+    assert stats["latency_us"] >= stats["latency_base_us"]
+
+    assert core.get_stats()["usage"]["dirty"]["value"] == blocks - stats["lines"]
+
+    cache.stop()
+
+
+def test_alru_adaptive_stats(pyocf_ctx):
+    cache = Cache.start_on_device(RamVolume(S.from_MiB(50)))
+
+    stats = cache.get_cleaning_alru_stats()
+    assert not stats["adaptive"]
+    assert stats["batch"] == 100
+    assert stats["rounds"] == 0
+
+    for value in [2, 100]:
+        with pytest.raises(OcfError):
+            cache.set_cleaning_policy_param(CleaningPolicy.ALRU, AlruParams.ADAPTIVE, value)
+
+    cache.set_cleaning_policy(CleaningPolicy.NOP)
+    with pytest.raises(OcfError):
+        cache.get_cleaning_alru_stats()
+
+    cache.stop()
@@ -0,0 +1,81 @@
+#
+# Copyright(c) 2024 Huawei Technologies
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+import random
+import time
+import pytest
+
+from pyocf.types.cache import Cache, CleaningPolicy, AlruParams
+from pyocf.types.io import IoDir
+from pyocf.types.shared import OcfError
+from pyocf.types.volume import RamVolume, TraceDevice
+from pyocf.helpers import BLOCK, block_data, run_cleaner, start_cache_with_core, write_blocks
+from pyocf.utils import Size as S
+
+
+def clean_in_rounds(blocks, elevator):
+    writes = []
+
+    def trace_write(vol, io, io_type):
+        if io_type == TraceDevice.IoType.Data and io.contents._dir == IoDir.WRITE:
+            writes.append(io.contents._addr)
+        return True
+
+    core_device = RamVolume(S.from_MiB(20))
+    cache, core = start_cache_with_core(TraceDevice(core_device, trace_fcn=trace_write))
+    cache.set_cleaning_policy_param(CleaningPolicy.ALRU, AlruParams.WAKE_UP_TIME, 0)
+    cache.set_cleaning_policy_param(CleaningPolicy.ALRU, AlruParams.STALE_BUFFER_TIME, 1)
+    cache.set_cleaning_policy_param(CleaningPolicy.ALRU, AlruParams.ACTIVITY_THRESHOLD, 0)
+    cache.set_cleaning_policy_param(CleaningPolicy.ALRU, AlruParams.FLUSH_MAX_BUFFERS, 32)
+    cache.set_cleaning_policy_param(CleaningPolicy.ALRU, AlruParams.ELEVATOR, elevator)
+    queue = cache.get_default_queue()
+
+    random.seed(1)
+    write_blocks(cache, core, random.sample(range(blocks), blocks))
+
+    time.sleep(2.1)
+
+    writes.clear()
+    runs = 0
+    while core.get_stats()["usage"]["dirty"]["value"] > 0:
+        run_cleaner(cache, queue)
+        runs += 1
+        assert runs <= blocks
+
+    core_data = core_device.get_bytes()
+    for block in range(blocks):
+        assert core_data[block * BLOCK : (block + 1) * BLOCK] == block_data(block)
+
+    cache.stop()
+
+    return sum(1 for prev, addr in zip(writes, writes[1:]) if addr < prev)
+
+
+def test_alru_elevator(pyocf_ctx):
+    """
+    Dirty cache lines in random order and let ALRU clean them in small rounds.
+    With elevator enabled core writes should sweep core in ascending LBA order
+    across rounds, so there should be only a few jumps back.
+    """
+    blocks = 2048
+
+    pyocf_ctx.register_volume_type(TraceDevice)
+
+    backward_seeks = clean_in_rounds(blocks, 0)
+    elevator_backward_seeks = clean_in_rounds(blocks, 1)
+
+    assert elevator_backward_seeks * 2 < backward_seeks
+
+
+def test_alru_elevator_param(pyocf_ctx):
+    cache = Cache.start_on_device(RamVolume(S.from_MiB(50)))
+
+    with pytest.raises(OcfError):
+        cache.set_cleaning_policy_param(CleaningPolicy.ALRU, AlruParams.ELEVATOR, 2)
+
+    cache.set_cleaning_policy_param(CleaningPolicy.ALRU, AlruParams.ELEVATOR, 1)
+    cache.set_cleaning_policy_param(CleaningPolicy.ALRU, AlruParams.ELEVATOR, 0)
+
+    cache.stop()
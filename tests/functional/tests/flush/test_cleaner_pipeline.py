@@ -0,0 +1,60 @@
+#
+# Copyright(c) 2024 Huawei Technologies
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+import pytest
+
+from pyocf.types.cache import Cache
+from pyocf.types.shared import OcfError
+from pyocf.types.volume import RamVolume
+from pyocf.helpers import BLOCK, block_data, start_cache_with_core, write_blocks
+from pyocf.utils import Size as S
+
+
+@pytest.mark.parametrize("budget", [1, 4096])
+def test_cleaner_pipeline(pyocf_ctx, budget):
+    """
+    Flush cache with given cleaner memory budget and check that all data
+    reaches core, requests wait for budget only when it is exceeded and time
+    of cleaning phases is reported.
+    """
+    blocks = 6000
+
+    core_device = RamVolume(S.from_MiB(50))
+    cache, core = start_cache_with_core(core_device)
+    cache.set_cleaner_memory_budget(budget)
+    write_blocks(cache, core, range(blocks))
+
+    cache.flush()
+
+    assert core.get_stats()["usage"]["dirty"]["value"] == 0
+
+    stats = cache.get_cleaner_stats()
+    if budget == 1:
+        assert stats["pipeline_waits"] > 0
+    else:
+        assert stats["pipeline_waits"] == 0
+        assert stats["pipeline_wait_ns"] == 0
+    assert stats["cache_read_ns"] + stats["core_write_ns"] > 0
+
+    core_data = core_device.get_bytes()
+    for block in range(blocks):
+        assert core_data[block * BLOCK : (block + 1) * BLOCK] == block_data(block)
+
+    cache.stop()
+
+
+def test_cleaner_memory_budget_config(pyocf_ctx):
+    cache = Cache.start_on_device(RamVolume(S.from_MiB(50)))
+
+    assert cache.get_cleaner_memory_budget() == 64
+
+    for budget in [0, 4097]:
+        with pytest.raises(OcfError):
+            cache.set_cleaner_memory_budget(budget)
+
+    cache.set_cleaner_memory_budget(16)
+    assert cache.get_cleaner_memory_budget() == 16
+
+    cache.stop()
@@ -0,0 +1,91 @@
+#
+# Copyright(c) 2024 Huawei Technologies
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+import pytest
+
+from pyocf.types.cache import Cache, CleaningPolicy
+from pyocf.types.shared import OcfError
+from pyocf.types.volume import RamVolume
+from pyocf.helpers import BLOCK, block_data, run_cleaner, start_cache_with_core, write_blocks
+from pyocf.utils import Size as S
+
+
+@pytest.mark.parametrize("cleaning_policy", [CleaningPolicy.NOP, CleaningPolicy.ACP])
+def test_dirty_watermarks(pyocf_ctx, cleaning_policy):
+    """
+    Fill IO class with dirty data above its high watermark and check that
+    cleaner, regardless of cleaning policy, keeps cleaning it until dirty
+    data drops to low watermark.
+    """
+    high, low = 50, 20
+
+    core_device = RamVolume(S.from_MiB(50))
+    cache, core = start_cache_with_core(core_device)
+    cache.set_cleaning_policy(cleaning_policy)
+    cache.set_partition_dirty_watermarks(0, high, low)
+    queue = cache.get_default_queue()
+
+    lines = int(cache.get_stats()["conf"]["size"])
+    blocks = lines * (high + 10) // 100
+    initial_data = core_device.get_bytes()
+
+    write_blocks(cache, core, range(blocks))
+
+    info = cache.get_partition_info(0)
+    assert info["_dirty"] == blocks
+    assert info["_dirty_urgent"]
+    assert cache.get_cleaner_stats()["watermark_triggers"] == 1
+
+    runs = 0
+    while cache.get_partition_info(0)["_dirty_urgent"]:
+        assert run_cleaner(cache, queue) == 0
+        runs += 1
+        assert runs < blocks
+
+    dirty = core.get_stats()["usage"]["dirty"]["value"]
+    assert dirty * 100 <= low * lines
+    assert dirty * 100 > (low - 5) * lines
+    assert cache.get_partition_info(0)["_dirty"] == dirty
+    assert cache.get_cleaner_stats()["watermark_lines"] == blocks - dirty
+
+    core_data = core_device.get_bytes()
+    cleaned = 0
+    for block in range(blocks):
+        data = core_data[block * BLOCK : (block + 1) * BLOCK]
+        if data != initial_data[block * BLOCK : (block + 1) * BLOCK]:
+            assert data == block_data(block)
+            cleaned += 1
+    assert cleaned == blocks - dirty
+
+    cache.stop()
+
+
+def test_dirty_watermarks_config(pyocf_ctx):
+    cache_device = RamVolume(S.from_MiB(50))
+    cache = Cache.start_on_device(cache_device)
+    cache.configure_partition(part_id=1, name="class1", max_size=50, priority=1)
+
+    info = cache.get_partition_info(1)
+    assert info["_dirty_high"] == 100
+    assert info["_dirty_low"] == 80
+    assert not info["_dirty_urgent"]
+
+    for high, low in [(101, 50), (50, 50), (40, 50)]:
+        with pytest.raises(OcfError):
+            cache.set_partition_dirty_watermarks(1, high, low)
+
+    with pytest.raises(OcfError):
+        cache.set_partition_dirty_watermarks(2, 50, 20)
+
+    cache.set_partition_dirty_watermarks(1, 60, 30)
+
+    cache.stop()
+    cache = Cache.load_from_device(cache_device)
+
+    info = cache.get_partition_info(1)
+    assert info["_dirty_high"] == 60
+    assert info["_dirty_low"] == 30
+
+    cache.stop()
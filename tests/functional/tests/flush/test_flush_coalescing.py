@@ -0,0 +1,96 @@
+#
+# Copyright(c) 2024 Huawei Technologies
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+import random
+import pytest
+
+from pyocf.types.data import Data
+from pyocf.types.io import IoDir
+from pyocf.types.volume import RamVolume, TraceDevice
+from pyocf.types.volume_core import CoreVolume
+from pyocf.helpers import BLOCK, block_data, io_to_exp_obj, start_cache_with_core, write_blocks
+from pyocf.utils import Size as S
+
+
+class SmallIoRamVolume(RamVolume):
+    max_io_size = S.from_KiB(16)
+
+    def get_max_io_size(self):
+        return self.max_io_size
+
+
+def prepare(pyocf_ctx, core_backend):
+    writes = []
+
+    def trace_write(vol, io, io_type):
+        if io_type == TraceDevice.IoType.Data and io.contents._dir == IoDir.WRITE:
+            writes.append((io.contents._addr, io.contents._bytes))
+        return True
+
+    pyocf_ctx.register_volume_type(TraceDevice)
+
+    cache, core = start_cache_with_core(TraceDevice(core_backend, trace_fcn=trace_write))
+
+    return cache, core, writes
+
+
+@pytest.mark.parametrize("backend", [RamVolume, SmallIoRamVolume])
+def test_flush_coalescing(pyocf_ctx, backend):
+    """
+    Dirty cache lines written in random order, so that they are not adjacent
+    in cache, are flushed to core with writes merged up to maximum I/O size
+    of core volume.
+    """
+    blocks = 256
+    core_backend = backend(S.from_MiB(10))
+    cache, core, writes = prepare(pyocf_ctx, core_backend)
+
+    random.seed(1)
+    write_blocks(cache, core, random.sample(range(blocks), blocks))
+
+    writes.clear()
+    cache.reset_stats()
+    cache.flush()
+
+    max_io_size = int(core_backend.get_max_io_size())
+    assert all(size <= max_io_size for _, size in writes)
+    assert sum(size for _, size in writes) == blocks * BLOCK
+    assert len(writes) == blocks * BLOCK // max_io_size
+
+    stats = cache.get_cleaner_stats()
+    assert stats["core_writes"] == len(writes)
+    assert stats["core_write_bytes"] == blocks * BLOCK
+    assert stats["requests"] > 0
+
+    core_data = core_backend.get_bytes()
+    for block in range(blocks):
+        assert core_data[block * BLOCK : (block + 1) * BLOCK] == block_data(block)
+
+    cache.stop()
+
+
+def test_flush_coalescing_sectors(pyocf_ctx):
+    """
+    Dirty sector ranges of adjacent cache lines are merged if they meet at
+    cache line boundary and written separately otherwise.
+    """
+    core_backend = RamVolume(S.from_MiB(10))
+    cache, core, writes = prepare(pyocf_ctx, core_backend)
+    vol = CoreVolume(core)
+    queue = cache.get_default_queue()
+
+    # Ranges crossing boundary of lines 0/1 and 4/5, and two separate ranges
+    # within line 8
+    ranges = [(2048, 4096), (4 * BLOCK + 512, 6144), (8 * BLOCK, 1024), (8 * BLOCK + 2048, 512)]
+    for addr, size in ranges:
+        data = Data.from_bytes(bytes([0xAA]) * size)
+        assert io_to_exp_obj(vol, queue, addr, data, IoDir.WRITE) == 0
+
+    writes.clear()
+    cache.flush()
+
+    assert sorted(writes) == sorted(ranges)
+
+    cache.stop()
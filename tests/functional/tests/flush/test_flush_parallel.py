@@ -0,0 +1,219 @@
+#
+# Copyright(c) 2024 Huawei Technologies
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+from ctypes import byref
+import threading
+import pytest
+
+from pyocf.types.cache import Cache, CacheMode
+from pyocf.types.core import Core, FlushProgress
+from pyocf.types.data import Data
+from pyocf.types.io import IoDir
+from pyocf.types.shared import OcfError, SeqCutOffPolicy
+from pyocf.types.volume import RamVolume, TraceDevice
+from pyocf.types.volume_core import CoreVolume
+from pyocf.helpers import BLOCK, block_data, io_to_exp_obj, start_cache_with_core, write_blocks
+from pyocf.utils import Size as S
+
+CORES = 4
+# OCF_CONFIG_FLUSH_WINDOW of pyocf build
+FLUSH_WINDOW = 8192
+
+
+@pytest.mark.parametrize("queue_depth", [1, 4, 64])
+def test_flush_parallel(pyocf_ctx, queue_depth):
+    """
+    Flush dirty data of several cores with given number of flush portions
+    in flight per core and check that all data reaches core volumes, writes
+    are spread across I/O queues and flush progress is reported per core.
+    """
+    blocks = 3000
+    threads = set()
+
+    def trace_write(vol, io, io_type):
+        if io_type == TraceDevice.IoType.Data and io.contents._dir == IoDir.WRITE:
+            threads.add(threading.current_thread().name)
+        return True
+
+    pyocf_ctx.register_volume_type(TraceDevice)
+
+    cache = Cache.start_on_device(RamVolume(S.from_MiB(100)), cache_mode=CacheMode.WB)
+    for i in range(3):
+        cache.add_io_queue(f"io-queue-{i}")
+
+    backends = []
+    cores = []
+    for i in range(CORES):
+        backends.append(RamVolume(S.from_MiB(20)))
+        core = Core.using_device(
+            TraceDevice(backends[i], trace_fcn=trace_write), name=f"core{i}"
+        )
+        cache.add_core(core)
+        cores.append(core)
+    cache.set_seq_cut_off_policy(SeqCutOffPolicy.NEVER)
+    cache.set_flush_queue_depth(queue_depth)
+
+    for i, core in enumerate(cores):
+        write_blocks(cache, core, range(blocks), lambda block: block_data(block, i))
+
+    for core in cores:
+        assert core.get_flush_progress()["total"] == 0
+
+    threads.clear()
+    cache.flush()
+
+    assert cache.get_stats()["usage"]["dirty"]["value"] == 0
+    assert len(threads) > 1
+
+    for i, core in enumerate(cores):
+        progress = core.get_flush_progress()
+        assert not progress["active"]
+        assert progress["total"] == blocks
+        assert progress["flushed"] == blocks
+        assert progress["in_flight"] == 0
+        assert progress["portion"] > 0
+        assert progress["throughput"] > 0
+
+        core_data = backends[i].get_bytes()
+        for block in range(blocks):
+            assert core_data[block * BLOCK : (block + 1) * BLOCK] == block_data(block, i)
+
+    cache.stop()
+
+
+def test_flush_core_windowed(pyocf_ctx):
+    """
+    Flush single core, whose dirty cache lines are interleaved in cache with
+    dirty lines of other cores, and check that only this core is flushed.
+    """
+    blocks = 1000
+
+    cache = Cache.start_on_device(RamVolume(S.from_MiB(50)), cache_mode=CacheMode.WB)
+    backends = [RamVolume(S.from_MiB(10)) for _ in range(2)]
+    cores = [Core.using_device(backends[i], name=f"core{i}") for i in range(2)]
+    for core in cores:
+        cache.add_core(core)
+    cache.set_seq_cut_off_policy(SeqCutOffPolicy.NEVER)
+
+    for block in range(blocks):
+        for i, core in enumerate(cores):
+            write_blocks(cache, core, [block], lambda block: block_data(block, i))
+
+    cores[1].flush()
+
+    assert cores[0].get_stats()["usage"]["dirty"]["value"] == blocks
+    assert cores[1].get_stats()["usage"]["dirty"]["value"] == 0
+    assert cores[0].get_flush_progress()["total"] == 0
+    assert cores[1].get_flush_progress()["flushed"] == blocks
+
+    core_data = backends[1].get_bytes()
+    for block in range(blocks):
+        assert core_data[block * BLOCK : (block + 1) * BLOCK] == block_data(block, 1)
+
+    cache.stop()
+
+
+@pytest.mark.parametrize("reload", [False, True])
+def test_flush_core_sparse(pyocf_ctx, reload):
+    """
+    Flush single core, whose few dirty cache lines are spread far apart in
+    big cache, optionally after loading cache, and check that all of them
+    are flushed while dirty data of other core is left intact.
+    """
+    cache_device = RamVolume(S.from_MiB(200))
+    backends = [RamVolume(S.from_MiB(200)) for _ in range(2)]
+    blocks = int(S.from_MiB(150)) // BLOCK
+    sparse = range(0, blocks, 997)
+
+    cache = Cache.start_on_device(cache_device, cache_mode=CacheMode.WB)
+    cores = [Core.using_device(backends[i], name=f"core{i}") for i in range(2)]
+    for core in cores:
+        cache.add_core(core)
+    cache.set_seq_cut_off_policy(SeqCutOffPolicy.NEVER)
+
+    for block in range(blocks):
+        write_blocks(cache, cores[1] if block in sparse else cores[0], [block])
+
+    if reload:
+        cache.stop()
+        cache = Cache.load_from_device(cache_device)
+        cores = [cache.get_core_by_name(f"core{i}") for i in range(2)]
+
+    cores[1].flush()
+
+    assert cores[0].get_stats()["usage"]["dirty"]["value"] == blocks - len(sparse)
+    assert cores[1].get_stats()["usage"]["dirty"]["value"] == 0
+    assert cores[1].get_flush_progress()["flushed"] == len(sparse)
+
+    core_data = backends[1].get_bytes()
+    for block in sparse:
+        assert core_data[block * BLOCK : (block + 1) * BLOCK] == block_data(block)
+
+    cache.stop()
+
+
+def test_flush_progress_windows(pyocf_ctx):
+    """
+    Flush core with dirty data spanning several flush windows and check that
+    progress sampled on every write to core is reported as active until the
+    last window is flushed.
+    """
+    io_size = S.from_MiB(1)
+    blocks = 3 * FLUSH_WINDOW
+    samples = []
+    flushing = False
+
+    def trace_write(vol, io, io_type):
+        if flushing and io_type == TraceDevice.IoType.Data:
+            if io.contents._dir == IoDir.WRITE:
+                progress = FlushProgress()
+                core.cache.owner.lib.ocf_mngt_core_get_flush_progress(
+                    core.handle, byref(progress)
+                )
+                samples.append((progress.active, progress.flushed))
+        return True
+
+    pyocf_ctx.register_volume_type(TraceDevice)
+
+    cache, core = start_cache_with_core(
+        TraceDevice(RamVolume(S.from_MiB(120)), trace_fcn=trace_write),
+        RamVolume(S.from_MiB(150)),
+    )
+    queue = cache.get_default_queue()
+
+    vol = CoreVolume(core)
+    for offset in range(0, blocks * BLOCK, io_size.B):
+        data = Data.from_bytes(bytes([offset // io_size.B % 251]) * io_size.B)
+        assert io_to_exp_obj(vol, queue, offset, data, IoDir.WRITE) == 0
+
+    flushing = True
+    core.flush()
+    flushing = False
+
+    assert all(active for active, _ in samples)
+    assert max(flushed for _, flushed in samples) >= 2 * FLUSH_WINDOW
+
+    progress = core.get_flush_progress()
+    assert not progress["active"]
+    assert progress["total"] == blocks
+    assert progress["flushed"] == blocks
+
+    cache.stop()
+
+
+def test_flush_queue_depth_invalid(pyocf_ctx):
+    cache = Cache.start_on_device(RamVolume(S.from_MiB(50)))
+    core = Core.using_device(RamVolume(S.from_MiB(10)))
+    cache.add_core(core)
+
+    for queue_depth in [0, 65]:
+        with pytest.raises(OcfError):
+            core.set_flush_queue_depth(queue_depth)
+        with pytest.raises(OcfError):
+            cache.set_flush_queue_depth(queue_depth)
+
+    core.set_flush_queue_depth(64)
+
+    cache.stop()
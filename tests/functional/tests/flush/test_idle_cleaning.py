@@ -0,0 +1,114 @@
+#
+# Copyright(c) 2024 Huawei Technologies
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+import time
+import pytest
+
+from pyocf.types.cache import CleaningPolicy
+from pyocf.types.shared import OcfError
+from pyocf.types.volume import RamVolume
+from pyocf.helpers import (
+    BLOCK,
+    block_data,
+    report_cleaner_idle,
+    run_cleaner,
+    start_cache_with_core,
+    write_blocks,
+)
+from pyocf.utils import Size as S
+
+
+def prepare(blocks, idle_time):
+    core_device = RamVolume(S.from_MiB(20))
+    cache, core = start_cache_with_core(core_device)
+    cache.set_cleaning_policy(CleaningPolicy.NOP)
+    cache.set_cleaner_idle_time(idle_time)
+    write_blocks(cache, core, range(blocks))
+
+    return cache, core, core_device
+
+
+def drain(cache, blocks):
+    queue = cache.get_default_queue()
+    runs = 0
+    while run_cleaner(cache, queue) == 0:
+        runs += 1
+        assert runs < blocks
+
+
+def test_idle_cleaning(pyocf_ctx):
+    """
+    Check that cleaner drains dirty data, regardless of cleaning policy, once
+    there was no foreground I/O for configured idle time.
+    """
+    blocks = 3000
+
+    cache, core, core_device = prepare(blocks, 200)
+
+    assert run_cleaner(cache, cache.get_default_queue()) > 0
+    assert core.get_stats()["usage"]["dirty"]["value"] == blocks
+
+    time.sleep(0.3)
+    drain(cache, blocks)
+
+    assert core.get_stats()["usage"]["dirty"]["value"] == 0
+    stats = cache.get_cleaner_stats()
+    assert stats["idle_runs"] > 0
+    assert stats["idle_lines"] == blocks
+
+    core_data = core_device.get_bytes()
+    for block in range(blocks):
+        assert core_data[block * BLOCK : (block + 1) * BLOCK] == block_data(block)
+
+    cache.stop()
+
+
+def test_idle_cleaning_reported(pyocf_ctx):
+    """
+    Check that idleness reported by adapter starts cleaning immediately and
+    lasts until next foreground request.
+    """
+    blocks = 2000
+
+    cache, core, _ = prepare(blocks, 3600000)
+    queue = cache.get_default_queue()
+
+    report_cleaner_idle(cache)
+    assert run_cleaner(cache, queue) == 0
+    dirty = core.get_stats()["usage"]["dirty"]["value"]
+    assert dirty < blocks
+
+    time.sleep(0.01)
+    write_blocks(cache, core, [blocks])
+
+    assert run_cleaner(cache, queue) > 0
+    assert core.get_stats()["usage"]["dirty"]["value"] == dirty + 1
+
+    time.sleep(0.01)
+    report_cleaner_idle(cache)
+    drain(cache, blocks)
+    assert core.get_stats()["usage"]["dirty"]["value"] == 0
+
+    cache.stop()
+
+
+def test_idle_cleaning_disabled(pyocf_ctx):
+    blocks = 100
+
+    cache, core, _ = prepare(blocks, 0)
+
+    report_cleaner_idle(cache)
+    assert run_cleaner(cache, cache.get_default_queue()) > 0
+    assert core.get_stats()["usage"]["dirty"]["value"] == blocks
+    assert cache.get_cleaner_stats()["idle_runs"] == 0
+
+    with pytest.raises(OcfError):
+        cache.set_cleaner_idle_time(3600001)
+
+    assert cache.get_cleaner_idle_time() == 0
+    cache.set_cleaner_idle_time(1000)
+    assert cache.get_cleaner_idle_time() == 1000
+
+    cache.stop()
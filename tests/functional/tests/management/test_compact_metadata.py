@@ -0,0 +1,135 @@
+#
+# Copyright(c) 2024 Huawei Technologies
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+import random
+import pytest
+
+from pyocf.types.cache import Cache, CacheMetadataSegment, CacheMode
+from pyocf.types.core import Core
+from pyocf.types.data import Data
+from pyocf.types.io import IoDir
+from pyocf.types.shared import OcfError, CacheLineSize, SeqCutOffPolicy
+from pyocf.types.volume import RamVolume
+from pyocf.types.volume_core import CoreVolume
+from pyocf.utils import Size as S
+from pyocf.helpers import (
+    get_metadata_segment_size,
+    get_metadata_segment_elem_size,
+    io_to_exp_obj,
+)
+
+SECTOR = 512
+
+
+def collision_size(cache_device, cls, compact):
+    cache = Cache.start_on_device(
+        cache_device, cache_line_size=cls, compact_metadata=compact
+    )
+    segment = CacheMetadataSegment.COLLISION
+    sizes = (
+        get_metadata_segment_elem_size(cache, segment),
+        get_metadata_segment_size(cache, segment),
+    )
+    cache.stop()
+
+    return sizes
+
+
+@pytest.mark.parametrize("cls", CacheLineSize)
+def test_compact_metadata_size(pyocf_ctx, cls):
+    """
+    Check that compact layout shrinks per cache line metadata by four bytes
+    and collision section on cache device accordingly.
+    """
+    cache_device = RamVolume(S.from_MiB(200))
+
+    elem_size, pages = collision_size(cache_device, cls, compact=False)
+    compact_elem_size, compact_pages = collision_size(cache_device, cls, compact=True)
+
+    assert compact_elem_size == elem_size - 4
+    assert compact_pages < pages
+
+
+@pytest.mark.parametrize("compact", [False, True])
+def test_compact_metadata_core_too_big(pyocf_ctx, compact):
+    """
+    Check that core which doesn't fit into core line field of compact layout
+    is rejected, while the same core can be added with regular layout.
+    """
+    cache_device = RamVolume(S.from_MiB(50))
+    core_device = RamVolume(S.from_MiB(1))
+    # Only reported length matters for adding core
+    core_device.size = S.from_B((1 << 35) * int(CacheLineSize.LINE_4KiB))
+
+    cache = Cache.start_on_device(
+        cache_device, cache_line_size=CacheLineSize.LINE_4KiB, compact_metadata=compact
+    )
+    core = Core.using_device(core_device)
+
+    if compact:
+        with pytest.raises(OcfError, match="OCF_ERR_CORE_TOO_BIG"):
+            cache.add_core(core)
+    else:
+        cache.add_core(core)
+
+    cache.stop()
+
+
+@pytest.mark.parametrize("cls", [CacheLineSize.LINE_4KiB, CacheLineSize.LINE_64KiB])
+def test_compact_metadata_io(pyocf_ctx, cls):
+    """
+    Write sectors scattered over two cores to cache with compact layout, and
+    check that data, dirty status and layout survive stop and load.
+    """
+    cache_device = RamVolume(S.from_MiB(100))
+    core_devices = [RamVolume(S.from_MiB(200)) for _ in range(2)]
+
+    cache = Cache.start_on_device(
+        cache_device, cache_mode=CacheMode.WB, cache_line_size=cls, compact_metadata=True
+    )
+    cache.set_seq_cut_off_policy(SeqCutOffPolicy.NEVER)
+    segment = CacheMetadataSegment.COLLISION
+    elem_size = get_metadata_segment_elem_size(cache, segment)
+
+    rand = random.Random(1)
+    written = {}
+    for core_id, core_device in enumerate(core_devices):
+        core = Core.using_device(core_device, name=f"core{core_id}")
+        cache.add_core(core)
+
+        vol = CoreVolume(core)
+        queue = cache.get_default_queue()
+        sectors = int(core_device.size) // SECTOR
+        # Last sector of core is mapped to the highest core line
+        for sector in rand.sample(range(sectors - 1), 200) + [sectors - 1]:
+            content = rand.randbytes(SECTOR)
+            data = Data.from_bytes(content)
+            assert io_to_exp_obj(vol, queue, sector * SECTOR, data, IoDir.WRITE) == 0
+            written[(core_id, sector)] = content
+
+    cache.stop()
+
+    cache = Cache.load_from_device(cache_device)
+    assert get_metadata_segment_elem_size(cache, segment) == elem_size
+
+    cores = [cache.get_core_by_name(f"core{core_id}") for core_id in range(2)]
+    queue = cache.get_default_queue()
+    for (core_id, sector), content in written.items():
+        vol = CoreVolume(cores[core_id])
+        data = Data(SECTOR)
+        assert io_to_exp_obj(vol, queue, sector * SECTOR, data, IoDir.READ) == 0
+        assert bytes(data.buffer[:SECTOR]) == content
+
+    assert cache.get_stats()["usage"]["dirty"]["value"] > 0
+
+    cache.flush()
+    assert cache.get_stats()["usage"]["dirty"]["value"] == 0
+
+    core_data = [core_device.get_bytes() for core_device in core_devices]
+    for (core_id, sector), content in written.items():
+        data = core_data[core_id][sector * SECTOR : (sector + 1) * SECTOR]
+        assert bytes(data) == content
+
+    cache.stop()
@@ -0,0 +1,104 @@
+#
+# Copyright(c) 2024 Huawei Technologies
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+import time
+
+from pyocf.types.cache import Cache, CacheMode
+from pyocf.types.core import Core
+from pyocf.types.data import Data
+from pyocf.types.io import IoDir
+from pyocf.types.shared import SeqCutOffPolicy
+from pyocf.types.volume import RamVolume
+from pyocf.types.volume_core import CoreVolume
+from pyocf.helpers import BLOCK, block_data, io_to_exp_obj, write_blocks
+from pyocf.utils import Size as S
+
+
+def prepare_cache(cache_device, core_devices, blocks):
+    cache = Cache.start_on_device(cache_device, cache_mode=CacheMode.WB, use_lookup_index=True)
+    cache.set_seq_cut_off_policy(SeqCutOffPolicy.NEVER)
+
+    for core_id, core_device in enumerate(core_devices):
+        core = Core.using_device(core_device, name=f"core{core_id}")
+        cache.add_core(core)
+
+        write_blocks(cache, core, range(blocks), lambda block: block_data(block, core_id))
+
+    cache.stop()
+
+
+def wait_for_lazy_load(cache, timeout=60):
+    deadline = time.time() + timeout
+    while cache.get_conf()["lazy_load_pending"]:
+        assert time.time() < deadline
+        time.sleep(0.01)
+
+
+def test_lazy_load(pyocf_ctx):
+    """
+    Load cache with lazy load and check that it serves I/O and flushes single
+    core correctly both while volatile indexes are populated in background
+    and after population is finished.
+    """
+    blocks = 1000
+    cache_device = RamVolume(S.from_GiB(1))
+    core_devices = [RamVolume(S.from_MiB(50)) for _ in range(2)]
+
+    prepare_cache(cache_device, core_devices, blocks)
+
+    cache = Cache.load_from_device(cache_device, lazy_load=True, use_lookup_index=True)
+    cores = [cache.get_core_by_name(f"core{core_id}") for core_id in range(2)]
+    queue = cache.get_default_queue()
+
+    for core_id, core in enumerate(cores):
+        vol = CoreVolume(core)
+        for block in range(blocks):
+            data = Data(BLOCK)
+            assert io_to_exp_obj(vol, queue, block * BLOCK, data, IoDir.READ) == 0
+            assert bytes(data.buffer[:BLOCK]) == block_data(block, core_id)
+
+    assert cache.get_stats()["req"]["rd_hits"]["value"] == 2 * blocks
+
+    cores[0].flush()
+    assert cores[0].get_stats()["usage"]["dirty"]["value"] == 0
+    assert cores[1].get_stats()["usage"]["dirty"]["value"] == blocks
+
+    for block in range(blocks):
+        data = core_devices[0].get_bytes()[block * BLOCK : (block + 1) * BLOCK]
+        assert bytes(data) == block_data(block, 0)
+
+    wait_for_lazy_load(cache)
+
+    cores[1].flush()
+    assert cores[1].get_stats()["usage"]["dirty"]["value"] == 0
+
+    for block in range(blocks):
+        data = core_devices[1].get_bytes()[block * BLOCK : (block + 1) * BLOCK]
+        assert bytes(data) == block_data(block, 1)
+
+    cache.stop()
+
+
+def test_lazy_load_stop(pyocf_ctx):
+    """
+    Stop cache right after lazy load and check that it is loaded again with
+    all dirty data.
+    """
+    blocks = 1000
+    cache_device = RamVolume(S.from_GiB(1))
+    core_devices = [RamVolume(S.from_MiB(50))]
+
+    prepare_cache(cache_device, core_devices, blocks)
+
+    cache = Cache.load_from_device(cache_device, lazy_load=True)
+    cache.stop()
+
+    cache = Cache.load_from_device(cache_device, lazy_load=True)
+    wait_for_lazy_load(cache)
+
+    core = cache.get_core_by_name("core0")
+    assert core.get_stats()["usage"]["dirty"]["value"] == blocks
+
+    cache.stop()
@@ -0,0 +1,142 @@
+#
+# Copyright(c) 2024 Huawei Technologies
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+from ctypes import c_char_p, c_size_t, c_uint32, create_string_buffer
+import logging
+import random
+import time
+import zlib
+import pytest
+
+from pyocf.types.cache import Cache, CacheMetadataSegment, CacheMode
+from pyocf.types.core import Core
+from pyocf.types.shared import OcfError
+from pyocf.types.volume import RamVolume
+from pyocf.utils import Size as S
+from pyocf.ocf import OcfLib
+from pyocf.helpers import (
+    get_metadata_segment_size,
+    get_metadata_segment_is_flapped,
+    get_metadata_segment_page_location,
+)
+
+logger = logging.getLogger(__name__)
+
+
+def env_crc32(crc, data, offset=0, length=None):
+    lib = OcfLib.getInstance()
+    length = len(data) - offset if length is None else length
+    return lib.env_crc32(crc, c_char_p(data[offset:]), length)
+
+
+def test_crc32_matches_zlib(pyocf_ctx):
+    """
+    Check that env CRC gives the same result as zlib for all lengths and
+    alignments, so checksums of metadata on cache device stay compatible.
+    """
+    rand = random.Random(1)
+    data = rand.randbytes(1 << 17)
+
+    lengths = list(range(0, 300)) + [rand.randrange(300, 1 << 16) for _ in range(200)]
+    for length in lengths:
+        offset = rand.randrange(0, 64)
+        init = rand.getrandbits(32)
+        chunk = data[offset : offset + length]
+
+        assert env_crc32(init, chunk) == zlib.crc32(chunk, init)
+
+
+def test_crc32_throughput(pyocf_ctx):
+    """
+    Report env CRC throughput for sizes of typical metadata segments, next to
+    zlib as reference.
+    """
+    lib = OcfLib.getInstance()
+    rand = random.Random(1)
+    data = rand.randbytes(int(S.from_MiB(64)))
+    buf = create_string_buffer(data, len(data))
+
+    for size in [S.from_KiB(4), S.from_KiB(256), S.from_MiB(4), S.from_MiB(64)]:
+        size = int(size)
+        repeat = max(1, int(S.from_MiB(256)) // size)
+        view = memoryview(data)[:size]
+
+        start = time.perf_counter()
+        for _ in range(repeat):
+            lib.env_crc32(0, buf, size)
+        env_time = time.perf_counter() - start
+
+        start = time.perf_counter()
+        for _ in range(repeat):
+            zlib.crc32(view)
+        zlib_time = time.perf_counter() - start
+
+        assert lib.env_crc32(0, buf, size) == zlib.crc32(view)
+
+        total = size * repeat / int(S.from_MiB(1))
+        logger.info(
+            f"checksum of {S(size)} segment: env {total / env_time:.0f} MiB/s, "
+            f"zlib {total / zlib_time:.0f} MiB/s"
+        )
+
+
+def load_with_queues(ctx, device, queues):
+    cache = Cache(owner=ctx)
+    cache.start_cache()
+    for i in range(1, queues):
+        cache.add_io_queue(f"io-queue-{i}")
+
+    try:
+        cache.load_cache(device)
+    except OcfError:
+        cache.stop()
+        raise
+
+    return cache
+
+
+def test_metadata_checksum_parallel(pyocf_ctx):
+    """
+    Check that segment checksums computed on several queues match checksums
+    computed on single queue, and that corruption at the end of segment is
+    detected.
+    """
+    queues = 4
+    cache_device = RamVolume(S.from_MiB(400))
+    core_device = RamVolume(S.from_MiB(50))
+
+    cache = Cache(owner=pyocf_ctx, cache_mode=CacheMode.WB)
+    cache.start_cache()
+    for i in range(1, queues):
+        cache.add_io_queue(f"io-queue-{i}")
+    cache.attach_device(cache_device, force=True)
+    cache.add_core(Core.using_device(core_device))
+
+    segment = CacheMetadataSegment.COLLISION
+    page_count = get_metadata_segment_size(cache, segment)
+    copies = 2 if get_metadata_segment_is_flapped(cache, segment) else 1
+    page_count //= copies
+    assert page_count >= 256
+
+    # Page checksummed by the last queue, in all copies of segment
+    location = get_metadata_segment_page_location(cache, segment)
+    corrupted_bytes = [
+        S.from_page(location + copy * page_count + page_count - 2).B for copy in range(copies)
+    ]
+
+    cache.stop()
+
+    load_with_queues(pyocf_ctx, cache_device, 1).stop()
+    load_with_queues(pyocf_ctx, cache_device, queues).stop()
+
+    for byte in corrupted_bytes:
+        cache_device.data[byte] = (cache_device.data[byte][0] ^ 0xAA).to_bytes(1, "big")
+
+    with pytest.raises(OcfError):
+        load_with_queues(pyocf_ctx, cache_device, queues)
+
+
+OcfLib.getInstance().env_crc32.argtypes = [c_uint32, c_char_p, c_size_t]
+OcfLib.getInstance().env_crc32.restype = c_uint32
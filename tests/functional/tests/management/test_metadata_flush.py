@@ -0,0 +1,85 @@
+#
+# Copyright(c) 2024 Huawei Technologies
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+import logging
+import time
+
+from pyocf.types.cache import Cache, CacheMode
+from pyocf.types.data import Data
+from pyocf.types.io import IoDir
+from pyocf.types.volume import RamVolume, TraceDevice
+from pyocf.types.volume_core import CoreVolume
+from pyocf.helpers import BLOCK, block_data, io_to_exp_obj, start_cache_with_core, write_blocks
+from pyocf.utils import Size as S
+
+logger = logging.getLogger(__name__)
+
+
+def timed_stop(cache, writes):
+    writes.clear()
+    start = time.perf_counter()
+    cache.stop()
+    return time.perf_counter() - start, sum(writes)
+
+
+def stop_load_cycle(cache_size):
+    writes = []
+
+    def trace_write(vol, io, io_type):
+        if io_type == TraceDevice.IoType.Data and io.contents._dir == IoDir.WRITE:
+            writes.append(io.contents._bytes)
+        return True
+
+    cache_device = TraceDevice(RamVolume(cache_size), trace_fcn=trace_write)
+    core_device = RamVolume(S.from_MiB(100))
+    cache, core = start_cache_with_core(core_device, cache_device, CacheMode.WT)
+
+    write_blocks(cache, core, range(1000))
+    timed_stop(cache, writes)
+
+    cache = Cache.load_from_device(cache_device)
+    idle = timed_stop(cache, writes)
+
+    cache = Cache.load_from_device(cache_device)
+    write_blocks(cache, cache.get_core_by_name("core"), range(1000, 1010))
+    modified = timed_stop(cache, writes)
+
+    logger.info(
+        f"cache {cache_size}: stop with no changes since load: {idle[1]} B "
+        f"in {idle[0]:.3f}s, with 10 lines changed: {modified[1]} B "
+        f"in {modified[0]:.3f}s"
+    )
+
+    cache = Cache.load_from_device(cache_device)
+    core = cache.get_core_by_name("core")
+    vol = CoreVolume(core)
+    queue = cache.get_default_queue()
+    for block in range(1010):
+        data = Data(BLOCK)
+        assert io_to_exp_obj(vol, queue, block * BLOCK, data, IoDir.READ) == 0
+        assert bytes(data.buffer[:BLOCK]) == block_data(block)
+
+    assert cache.get_stats()["req"]["rd_hits"]["value"] == 1010
+
+    cache.stop()
+
+    return idle[1], modified[1]
+
+
+def test_metadata_flush_modified_only(pyocf_ctx):
+    """
+    Check that on stop of loaded cache only metadata pages modified since load
+    are written to cache device, so amount of metadata written does not depend
+    on cache size, and that cache state is preserved.
+    """
+    pyocf_ctx.register_volume_type(TraceDevice)
+
+    results = [stop_load_cycle(size) for size in [S.from_MiB(64), S.from_GiB(1)]]
+
+    idle_bytes = [idle for idle, _ in results]
+    assert idle_bytes[0] == idle_bytes[1]
+
+    for idle, modified in results:
+        assert idle < modified < idle + int(S.from_MiB(1))
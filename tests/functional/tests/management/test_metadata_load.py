@@ -0,0 +1,73 @@
+#
+# Copyright(c) 2024 Huawei Technologies
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+import threading
+import pytest
+
+from pyocf.types.cache import Cache
+from pyocf.types.data import Data
+from pyocf.types.io import IoDir
+from pyocf.types.shared import OcfError
+from pyocf.types.volume import RamVolume, TraceDevice
+from pyocf.types.volume_core import CoreVolume
+from pyocf.helpers import BLOCK, block_data, io_to_exp_obj, start_cache_with_core, write_blocks
+from pyocf.utils import Size as S
+
+QUEUES = 4
+
+
+@pytest.mark.parametrize("io_depth", [1, 128])
+def test_metadata_load_parallel(pyocf_ctx, io_depth):
+    """
+    Load cache with several I/O queues and check that metadata is read
+    through all of them and that cache state is fully restored regardless
+    of metadata I/O depth.
+    """
+    blocks = 2000
+    reading_threads = set()
+
+    def trace_read(vol, io, io_type):
+        if io_type == TraceDevice.IoType.Data and io.contents._dir == IoDir.READ:
+            reading_threads.add(threading.current_thread().name)
+        return True
+
+    pyocf_ctx.register_volume_type(TraceDevice)
+
+    cache_device = TraceDevice(RamVolume(S.from_MiB(200)), trace_fcn=trace_read)
+    core_device = RamVolume(S.from_MiB(50))
+    cache, core = start_cache_with_core(core_device, cache_device)
+    write_blocks(cache, core, range(blocks))
+
+    cache.stop()
+
+    cache = Cache(owner=pyocf_ctx, metadata_io_depth=io_depth)
+    cache.start_cache()
+    for i in range(1, QUEUES):
+        cache.add_io_queue(f"io-queue-{i}")
+
+    reading_threads.clear()
+    cache.load_cache(cache_device)
+
+    assert len(reading_threads) >= QUEUES
+
+    core = cache.get_core_by_name("core")
+    assert core.get_stats()["usage"]["dirty"]["value"] == blocks
+
+    vol = CoreVolume(core)
+    queue = cache.get_default_queue()
+    for block in range(blocks):
+        data = Data(BLOCK)
+        assert io_to_exp_obj(vol, queue, block * BLOCK, data, IoDir.READ) == 0
+        assert bytes(data.buffer[:BLOCK]) == block_data(block)
+
+    assert cache.get_stats()["req"]["rd_hits"]["value"] == blocks
+
+    cache.stop()
+
+
+@pytest.mark.parametrize("io_depth", [0, 257])
+def test_metadata_io_depth_invalid(pyocf_ctx, io_depth):
+    with pytest.raises(OcfError):
+        Cache.start_on_device(RamVolume(S.from_MiB(50)), metadata_io_depth=io_depth)
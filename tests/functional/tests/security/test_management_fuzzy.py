@@ -333,6 +333,12 @@ def get_alru_param_valid_rage(param_id):
         return ConfValidValues.cleaning_alru_flush_max_buffers_range
     elif param_id == AlruParams.ACTIVITY_THRESHOLD:
         return ConfValidValues.cleaning_alru_activity_threshold_range
+    elif param_id == AlruParams.MAX_DIRTY_RATIO:
+        return ConfValidValues.cleaning_alru_max_dirty_ratio_range
+    elif param_id == AlruParams.ADAPTIVE:
+        return ConfValidValues.cleaning_alru_adaptive_range
+    elif param_id == AlruParams.ELEVATOR:
+        return ConfValidValues.cleaning_alru_elevator_range
 
 
 @pytest.mark.parametrize("cm", CacheMode)
@@ -393,6 +399,8 @@ def get_acp_param_valid_rage(param_id):
         return ConfValidValues.cleaning_acp_wake_up_time_range
     elif param_id == AcpParams.FLUSH_MAX_BUFFERS:
         return ConfValidValues.cleaning_acp_flush_max_buffers_range
+    elif param_id == AcpParams.CHUNK_SIZE:
+        return ConfValidValues.cleaning_acp_chunk_size_range
 
 
 @pytest.mark.parametrize("cm", CacheMode)
@@ -44,6 +44,10 @@
 
 #include "ocf_lru.c/lru_iter_generated_wraps.c"
 
+#define OCF_NUM_LRU_LISTS OCF_LRU_LISTS_DEFAULT
+
+static struct ocf_cache test_cache = { .lru_lists = OCF_NUM_LRU_LISTS };
+
 // #define DEBUG
 
 struct ocf_cache_line_concurrency *__wrap_ocf_cache_line_concurrency(ocf_cache_t cache)
@@ -379,7 +383,7 @@ static void _lru_run_test(unsigned test_case)
 				pos[i]++;
 		}
 
-		lru_iter_cleaning_init(&iter, NULL, NULL, start_pos);
+		lru_iter_cleaning_init(&iter, &test_cache, NULL, start_pos);
 
 		do {
 			/* check what is expected to be returned from iterator */